@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#define CATCH_CONFIG_MAIN
+#include "_benchmarks.hpp"
+using namespace e2d_benchmarks;
+
+#include <3rdparty/rapidjson/prettywriter.h>
+
+namespace
+{
+    //
+    // json_reporter
+    //
+    // Writes benchmark results as a single JSON document:
+    //
+    // { "benchmarks" : [ {
+    //     "test_case" : "...", "name" : "...",
+    //     "samples" : 100, "iterations" : 1,
+    //     "mean_ns" : 0.0, "mean_low_ns" : 0.0, "mean_high_ns" : 0.0,
+    //     "std_dev_ns" : 0.0, "outlier_variance" : 0.0 } ] }
+    //
+    // Usage: e2d_benchmarks --reporter json --out results.json
+    //
+
+    class json_reporter final : public Catch::StreamingReporterBase {
+    public:
+        json_reporter(Catch::ReporterConfig&& config)
+        : StreamingReporterBase(std::move(config)) {}
+
+        static std::string getDescription() {
+            return "Reports benchmark results as a JSON document";
+        }
+
+        void benchmarkEnded(const Catch::BenchmarkStats<>& stats) override {
+            rapidjson::Value result(rapidjson::kObjectType);
+            auto& allocator = document_.GetAllocator();
+
+            const char* test_case = currentTestCaseInfo
+                ? currentTestCaseInfo->name.c_str()
+                : "";
+
+            result.AddMember("test_case", rapidjson::Value(test_case, allocator), allocator);
+            result.AddMember("name", rapidjson::Value(stats.info.name.c_str(), allocator), allocator);
+            result.AddMember("samples", stats.info.samples, allocator);
+            result.AddMember("iterations", stats.info.iterations, allocator);
+            result.AddMember("mean_ns", stats.mean.point.count(), allocator);
+            result.AddMember("mean_low_ns", stats.mean.lower_bound.count(), allocator);
+            result.AddMember("mean_high_ns", stats.mean.upper_bound.count(), allocator);
+            result.AddMember("std_dev_ns", stats.standardDeviation.point.count(), allocator);
+            result.AddMember("outlier_variance", stats.outlierVariance, allocator);
+
+            benchmarks_.PushBack(result, allocator);
+        }
+
+        void benchmarkFailed(Catch::StringRef error) override {
+            failures_.emplace_back(error);
+        }
+
+        void testRunEnded(const Catch::TestRunStats& stats) override {
+            StreamingReporterBase::testRunEnded(stats);
+
+            auto& allocator = document_.GetAllocator();
+            rapidjson::Value failures(rapidjson::kArrayType);
+            for ( const std::string& failure : failures_ ) {
+                failures.PushBack(rapidjson::Value(failure.c_str(), allocator), allocator);
+            }
+
+            document_.SetObject();
+            document_.AddMember("benchmarks", benchmarks_, allocator);
+            document_.AddMember("failures", failures, allocator);
+
+            rapidjson::StringBuffer buffer;
+            rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+            document_.Accept(writer);
+            m_stream << buffer.GetString() << std::endl;
+        }
+    private:
+        rapidjson::Document document_;
+        rapidjson::Value benchmarks_{rapidjson::kArrayType};
+        std::vector<std::string> failures_;
+    };
+}
+
+CATCH_REGISTER_REPORTER("json", json_reporter)
@@ -0,0 +1,49 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include <enduro2d/enduro2d.hpp>
+#include "../../untests/catch/catch_amalgamated.hpp"
+
+namespace e2d_benchmarks
+{
+    using namespace e2d;
+
+    class headless_starter_initializer final : private noncopyable {
+    public:
+        headless_starter_initializer(str_view name) {
+            modules::initialize<starter>(0, nullptr,
+                starter::parameters(
+                    engine::parameters(str(name), "enduro2d")
+                        .without_audio(true)
+                        .without_graphics(true)));
+        }
+
+        ~headless_starter_initializer() noexcept {
+            modules::shutdown<starter>();
+        }
+    };
+
+    inline str resources_path(str_view relative) {
+        str resources;
+        if ( !filesystem::extract_predef_path(
+            resources,
+            filesystem::predef_path::resources) )
+        {
+            throw std::runtime_error("BENCHMARKS: Failed to extract resources path");
+        }
+        return path::combine(resources, relative);
+    }
+
+    inline buffer read_resource(str_view relative) {
+        buffer content;
+        if ( !filesystem::try_read_all(content, resources_path(relative)) ) {
+            throw std::runtime_error("BENCHMARKS: Failed to read resource file");
+        }
+        return content;
+    }
+}
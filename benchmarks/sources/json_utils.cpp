@@ -0,0 +1,86 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_benchmarks.hpp"
+using namespace e2d_benchmarks;
+
+namespace
+{
+    const char* const schema_source = R"json({
+        "type" : "object",
+        "required" : [ "nodes" ],
+        "additionalProperties" : false,
+        "properties" : {
+            "nodes" : {
+                "type" : "array",
+                "items" : {
+                    "type" : "object",
+                    "required" : [ "name" ],
+                    "additionalProperties" : false,
+                    "properties" : {
+                        "name" : { "$ref" : "#/common_definitions/name" },
+                        "translation" : { "$ref" : "#/common_definitions/v2" },
+                        "scale" : { "$ref" : "#/common_definitions/v2" },
+                        "tint" : { "$ref" : "#/common_definitions/color" }
+                    }
+                }
+            }
+        }
+    })json";
+
+    str make_document_source(std::size_t node_count) {
+        str source = "{ \"nodes\" : [";
+        for ( std::size_t i = 0; i < node_count; ++i ) {
+            source += strings::rformat(
+                "%0{ \"name\" : \"node_%1\", \"translation\" : [%1,%1], \"scale\" : { \"x\" : 1, \"y\" : 2 }, \"tint\" : [1,1,1,1] }",
+                i ? "," : "",
+                i);
+        }
+        source += "] }";
+        return source;
+    }
+}
+
+TEST_CASE("json_utils", "[benchmark]") {
+    rapidjson::Document schema_doc;
+    REQUIRE_FALSE(schema_doc.Parse(schema_source).HasParseError());
+    json_utils::add_common_schema_definitions(schema_doc);
+    const rapidjson::SchemaDocument schema(schema_doc);
+
+    const str source = make_document_source(256u);
+    rapidjson::Document doc;
+    REQUIRE_FALSE(doc.Parse(source.c_str()).HasParseError());
+
+    BENCHMARK("compile schema") {
+        rapidjson::Document d;
+        d.Parse(schema_source);
+        json_utils::add_common_schema_definitions(d);
+        const rapidjson::SchemaDocument compiled(d);
+        rapidjson::SchemaValidator validator(compiled);
+        return validator.IsValid();
+    };
+
+    BENCHMARK("parse 256 nodes") {
+        rapidjson::Document d;
+        return d.Parse(source.c_str()).HasParseError();
+    };
+
+    BENCHMARK("validate 256 nodes") {
+        rapidjson::SchemaValidator validator(schema);
+        return doc.Accept(validator);
+    };
+
+    BENCHMARK("parse values of 256 nodes") {
+        v2f sum;
+        for ( const auto& n : doc["nodes"].GetArray() ) {
+            v2f t;
+            if ( json_utils::try_parse_value(n["translation"], t) ) {
+                sum += t;
+            }
+        }
+        return sum;
+    };
+}
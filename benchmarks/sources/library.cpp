@@ -0,0 +1,50 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_benchmarks.hpp"
+using namespace e2d_benchmarks;
+
+TEST_CASE("library", "[benchmark]") {
+    headless_starter_initializer initializer("library_benchmarks");
+    library& l = the<library>();
+
+    BENCHMARK("load and unload text asset") {
+        const bool loaded = !!l.load_asset<text_asset>("text_asset.txt");
+        l.unload_unused_assets();
+        return loaded;
+    };
+
+    BENCHMARK("load and unload image asset") {
+        const bool loaded = !!l.load_asset<image_asset>("image.png");
+        l.unload_unused_assets();
+        return loaded;
+    };
+
+    BENCHMARK("load and unload prefab with dependencies") {
+        const bool loaded = !!l.load_asset<prefab_asset>("prefab_root.json");
+        l.unload_unused_assets();
+        return loaded;
+    };
+
+    BENCHMARK("load 64 cached assets") {
+        const auto asset = l.load_asset<binary_asset>("binary_asset.bin");
+        std::size_t loaded = 0u;
+        for ( std::size_t i = 0; i < 64u; ++i ) {
+            loaded += !!l.load_asset<binary_asset>("binary_asset.bin");
+        }
+        return loaded;
+    };
+
+    BENCHMARK("load and unload 4 distinct assets") {
+        std::size_t loaded = 0u;
+        loaded += !!l.load_asset<text_asset>("text_asset.txt");
+        loaded += !!l.load_asset<binary_asset>("binary_asset.bin");
+        loaded += !!l.load_asset<image_asset>("image.png");
+        loaded += !!l.load_asset<mesh_asset>("mesh.e2d_mesh");
+        l.unload_unused_assets();
+        return loaded;
+    };
+}
@@ -0,0 +1,60 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_benchmarks.hpp"
+using namespace e2d_benchmarks;
+
+namespace
+{
+    struct node_tree {
+        node_iptr root;
+        vector<node_iptr> leaves;
+    };
+
+    node_tree make_node_tree(std::size_t groups, std::size_t leaves_per_group) {
+        node_tree tree;
+        tree.root = node::create();
+        tree.leaves.reserve(groups * leaves_per_group);
+        for ( std::size_t i = 0; i < groups; ++i ) {
+            node_iptr group = node::create(tree.root);
+            for ( std::size_t j = 0; j < leaves_per_group; ++j ) {
+                tree.leaves.push_back(node::create(group));
+            }
+        }
+        tree.root->update_world_matrix_recursive();
+        return tree;
+    }
+}
+
+TEST_CASE("node", "[benchmark]") {
+    node_tree tree = make_node_tree(50u, 100u);
+
+    BENCHMARK("create 5000 nodes") {
+        return make_node_tree(50u, 100u);
+    };
+
+    BENCHMARK("move 5000 leaves and update") {
+        for ( const node_iptr& leaf : tree.leaves ) {
+            leaf->translation(leaf->translation() + v2f(1.f, 1.f));
+        }
+        tree.root->update_world_matrix_recursive();
+        return tree.leaves.back()->world_matrix();
+    };
+
+    BENCHMARK("move root and update") {
+        tree.root->translation(tree.root->translation() + v2f(1.f, 1.f));
+        tree.root->update_world_matrix_recursive();
+        return tree.leaves.back()->world_matrix();
+    };
+
+    BENCHMARK("read 5000 clean world matrices") {
+        f32 sum = 0.f;
+        for ( const node_iptr& leaf : tree.leaves ) {
+            sum += leaf->world_matrix()[3].x;
+        }
+        return sum;
+    };
+}
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_benchmarks.hpp"
+using namespace e2d_benchmarks;
+
+namespace
+{
+    str make_font_source(std::size_t char_count) {
+        str source =
+            "info face=\"Arial\" size=50 bold=0 italic=0 charset=\"\" unicode=0 stretchH=100 smooth=1 aa=1 padding=0,0,0,0 spacing=0,0\n"
+            "common lineHeight=58 base=49 scaleW=512 scaleH=512 pages=1 packed=0\n"
+            "page id=0 file=\"arial.png\"\n";
+        source += strings::rformat("chars count=%0\n", char_count);
+        for ( std::size_t i = 0; i < char_count; ++i ) {
+            source += strings::rformat(
+                "char id=%0 x=%1 y=%2 width=10 height=40 xoffset=5 yoffset=10 xadvance=14 page=0 chnl=0\n",
+                32u + i, (i * 10u) % 512u, (i / 51u) * 40u);
+        }
+        source += strings::rformat("kernings count=%0\n", char_count);
+        for ( std::size_t i = 0; i < char_count; ++i ) {
+            source += strings::rformat(
+                "kerning first=%0 second=%1 amount=-1\n",
+                32u + i, 32u + (i * 7u) % char_count);
+        }
+        return source;
+    }
+}
+
+TEST_CASE("readers", "[benchmark]") {
+    SECTION("image") {
+        const buffer png = read_resource("bin/images/stb/ship.png");
+        const buffer jpg = read_resource("bin/images/stb/ship.jpg");
+        const buffer tga = read_resource("bin/images/stb/ship.tga");
+        const buffer dds = read_resource("bin/images/dds/ship_dxt5.dds");
+
+        BENCHMARK("load png") {
+            image img;
+            return images::try_load_image(img, png);
+        };
+
+        BENCHMARK("load jpg") {
+            image img;
+            return images::try_load_image(img, jpg);
+        };
+
+        BENCHMARK("load tga") {
+            image img;
+            return images::try_load_image(img, tga);
+        };
+
+        BENCHMARK("load dds") {
+            image img;
+            return images::try_load_image(img, dds);
+        };
+    }
+    SECTION("font") {
+        const str source = make_font_source(256u);
+        const buffer_view source_view(source.data(), source.size());
+
+        BENCHMARK("load 256 glyphs") {
+            font f;
+            return fonts::try_load_font(f, source_view);
+        };
+    }
+    SECTION("mesh") {
+        const buffer gnome = read_resource("bin/gnome/gnome.obj.gnome.e2d_mesh");
+
+        BENCHMARK("load gnome mesh") {
+            mesh m;
+            return meshes::try_load_mesh(m, gnome);
+        };
+    }
+}
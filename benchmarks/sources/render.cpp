@@ -0,0 +1,119 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_benchmarks.hpp"
+#include "../../sources/enduro2d/high/systems/render_system_impl/render_system_batcher.hpp"
+using namespace e2d_benchmarks;
+
+namespace
+{
+    render::property_block make_property_block(std::size_t count, f32 seed) {
+        render::property_block pb;
+        for ( std::size_t i = 0; i < count; ++i ) {
+            pb.property(
+                make_hash(strings::rformat("u_property_%0", i)),
+                seed + static_cast<f32>(i));
+        }
+        pb.sampler("u_texture", render::sampler_state());
+        return pb;
+    }
+
+    using batcher_type = render_system_impl::batcher<
+        render_system_impl::index_u16,
+        render_system_impl::vertex_v3f_t2f_c32b>;
+}
+
+TEST_CASE("render", "[benchmark]") {
+    SECTION("property_block") {
+        const render::property_block pb1 = make_property_block(16u, 0.f);
+        const render::property_block pb2 = make_property_block(16u, 0.f);
+        const render::property_block pb3 = make_property_block(16u, 1.f);
+
+        BENCHMARK("merge 16 properties") {
+            render::property_block pb;
+            return pb.merge(pb1).merge(pb3).size();
+        };
+
+        BENCHMARK("compare equal blocks") {
+            return pb1.equals(pb2);
+        };
+
+        BENCHMARK("compare different blocks") {
+            return pb1.equals(pb3);
+        };
+
+        BENCHMARK("compare cached hashes") {
+            return pb1.hash() == pb2.hash();
+        };
+    }
+    SECTION("command_queue") {
+        vector<render::material> materials(16u);
+        render::geometry geometry;
+
+        BENCHMARK("sort and merge 4096 draws") {
+            render::command_queue queue;
+            for ( std::size_t i = 0; i < 4096u; ++i ) {
+                const std::size_t m = (i * 7u) % materials.size();
+                queue.add_command(
+                    render::command_queue::make_sort_key(
+                        0u,
+                        static_cast<u32>(i % 4u),
+                        0u,
+                        static_cast<u32>(m),
+                        0u),
+                    render::draw_command(materials[m], geometry)
+                        .index_range(i * 6u, 6u));
+            }
+            return queue.sort().command_count();
+        };
+    }
+}
+
+// the batcher needs a render module, the benchmarks have to stay headless,
+// so it's only measured when the render and the window are the 'none' ones
+#if defined(E2D_RENDER_MODE) && E2D_RENDER_MODE == E2D_RENDER_MODE_NONE && \
+    defined(E2D_WINDOW_MODE) && E2D_WINDOW_MODE == E2D_WINDOW_MODE_NONE
+TEST_CASE("batcher", "[benchmark]") {
+    modules::initialize<starter>(0, nullptr,
+        starter::parameters(
+            engine::parameters("batcher_benchmarks", "enduro2d")
+                .without_audio(true)));
+    DEFER_HPP([](){
+        modules::shutdown<starter>();
+    });
+
+    // only 'batch' is measured, it fills the batcher's vectors
+    // and never reaches the render until the batcher is flushed
+    batcher_type batcher(the<debug>(), the<render>());
+
+    const material_asset::ptr materials[] = {
+        material_asset::create(render::material()),
+        material_asset::create(render::material())};
+    const render::property_block properties = make_property_block(4u, 0.f);
+
+    const u16 indices[] = {0u, 1u, 2u, 2u, 1u, 3u};
+    const batcher_type::vertex_type vertices[] = {
+        {v3f(0.f, 0.f, 0.f), v2f(0.f, 0.f), color32::white()},
+        {v3f(1.f, 0.f, 0.f), v2f(1.f, 0.f), color32::white()},
+        {v3f(0.f, 1.f, 0.f), v2f(0.f, 1.f), color32::white()},
+        {v3f(1.f, 1.f, 0.f), v2f(1.f, 1.f), color32::white()}};
+
+    BENCHMARK("batch 4096 quads") {
+        for ( std::size_t i = 0; i < 4096u; ++i ) {
+            const f32 x = static_cast<f32>(i % 64u) * 2.f;
+            const f32 y = static_cast<f32>(i / 64u) * 2.f;
+            batcher.batch(
+                materials[(i / 16u) % 2u],
+                properties,
+                indices, std::size(indices),
+                vertices, std::size(vertices),
+                b2f(x, y, 1.f, 1.f));
+        }
+        batcher.clear(false);
+        return batcher.has_room_for(4096u * 4u);
+    };
+}
+#endif
@@ -0,0 +1,28 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_benchmarks.hpp"
+using namespace e2d_benchmarks;
+
+TEST_CASE("strings", "[benchmark]") {
+    BENCHMARK("rformat integers") {
+        return strings::rformat("%0 %1 %2", 42, 100500u, -7);
+    };
+
+    BENCHMARK("rformat floats and vectors") {
+        return strings::rformat("%0 %1 %2", 3.14f, v2f(1.f, 2.f), v3f(1.f, 2.f, 3.f));
+    };
+
+    BENCHMARK("rformat strings") {
+        return strings::rformat("RENDER: %0\n--> Info: %1", "short", str("a longer dynamic string"));
+    };
+
+    BENCHMARK("rformat_nothrow into reused string") {
+        str dst;
+        dst.reserve(64u);
+        return strings::rformat_nothrow(dst, "%0:%1:%2", 1, 2, 3);
+    };
+}
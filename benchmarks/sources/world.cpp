@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_benchmarks.hpp"
+using namespace e2d_benchmarks;
+
+namespace
+{
+    prefab make_prefab(std::size_t depth, std::size_t children) {
+        prefab p;
+        p.prototype().component<named>(named("node"));
+        if ( depth > 0u ) {
+            vector<prefab> cs(children, make_prefab(depth - 1u, children));
+            p.set_children(std::move(cs));
+        }
+        return p;
+    }
+
+    void destroy_instances(world& w, const vector<gobject>& insts) {
+        for ( gobject inst : insts ) {
+            inst.destroy();
+        }
+        w.finalize_instances();
+    }
+}
+
+TEST_CASE("world", "[benchmark]") {
+    headless_starter_initializer initializer("world_benchmarks");
+    world& w = the<world>();
+
+    // 1 + 6 + 36 + 216 = 259 entities
+    const prefab ui_prefab = make_prefab(3u, 6u);
+    const flat_prefab flat_ui_prefab(ui_prefab);
+
+    BENCHMARK("flatten 259 entity prefab") {
+        return flat_prefab(ui_prefab).size();
+    };
+
+    BENCHMARK("instantiate 259 entity prefab") {
+        gobject inst = w.instantiate(ui_prefab);
+        destroy_instances(w, {inst});
+        return inst;
+    };
+
+    BENCHMARK("instantiate flat 259 entity prefab") {
+        vector<gobject> insts = w.instantiate_batch(flat_ui_prefab, 1u);
+        destroy_instances(w, insts);
+        return insts.size();
+    };
+
+    const flat_prefab bullet_prefab{prefab()};
+
+    BENCHMARK("instantiate batch of 1000 bullets") {
+        vector<gobject> insts = w.instantiate_batch(bullet_prefab, 1000u);
+        destroy_instances(w, insts);
+        return insts.size();
+    };
+}
@@ -17,6 +17,8 @@
 #include <cassert>
 
 #include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
 #include <atomic>
 #include <thread>
 
@@ -40,6 +40,18 @@
 #define E2D_CLEAR_ALLOCA(size)\
     std::memset(E2D_ALLOCA((size)), 0, (size))
 
+//
+// E2D_HAS_IS_CONSTANT_EVALUATED
+//
+
+#if defined(__has_builtin)
+#  if __has_builtin(__builtin_is_constant_evaluated)
+#    define E2D_HAS_IS_CONSTANT_EVALUATED 1
+#  endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1925
+#  define E2D_HAS_IS_CONSTANT_EVALUATED 1
+#endif
+
 //
 // E2D_PP_CAT
 //
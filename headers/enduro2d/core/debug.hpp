@@ -22,6 +22,10 @@ namespace e2d
         public:
             virtual ~sink() noexcept = default;
             virtual bool on_message(level lvl, str_view text) noexcept = 0;
+
+            // thread safe sinks receive messages from many threads at once,
+            // the others receive them one at a time
+            virtual bool thread_safe() const noexcept { return false; }
         };
         using sink_uptr = std::unique_ptr<sink>;
     public:
@@ -55,8 +59,21 @@ namespace e2d
         template < typename... Args >
         debug& fatal(str_view fmt, Args&&... args) noexcept;
     private:
+        struct sink_entry final {
+            level min_level = level::trace;
+            sink_uptr sink;
+            bool thread_safe = false;
+            bool removed = false;
+            std::shared_mutex mutex;
+        };
+        using sink_list = vector<std::shared_ptr<sink_entry>>;
+    private:
+        static void send_message_(sink_entry& entry, level lvl, str_view text) noexcept;
+    private:
+        // the list is copied on write, so messages are formatted
+        // and sent to sinks without holding the lock
         mutable std::mutex mutex_;
-        vector<std::pair<level, sink_uptr>> sinks_;
+        std::shared_ptr<const sink_list> sinks_;
         level min_level_ = level::trace;
     };
 
@@ -76,6 +93,30 @@ namespace e2d
     public:
         bool on_message(debug::level lvl, str_view text) noexcept final;
     };
+
+    //
+    // debug_async_sink
+    //
+    // Messages are pushed to a lock-free queue and written to the stream
+    // by a background thread. Messages of the sync level and above block
+    // until everything before them is written and synced to the device.
+    //
+
+    class debug_async_sink final : public debug::sink {
+    public:
+        debug_async_sink(output_stream_uptr stream);
+        debug_async_sink(output_stream_uptr stream, debug::level sync_level);
+        ~debug_async_sink() noexcept final;
+
+        bool on_message(debug::level lvl, str_view text) noexcept final;
+        bool thread_safe() const noexcept final;
+
+        // blocks until all pushed messages are written to the stream
+        bool flush(bool sync = false) noexcept;
+    private:
+        class internal_state;
+        std::unique_ptr<internal_state> state_;
+    };
 }
 
 namespace e2d
@@ -96,22 +137,25 @@ namespace e2d
 
     template < typename... Args >
     debug& debug::log(level lvl, str_view fmt, Args&&... args) noexcept {
-        std::lock_guard<std::mutex> guard(mutex_);
-        if ( lvl >= min_level_ && !sinks_.empty() ) {
-            str formatted_text;
-            try {
-                formatted_text = strings::rformat(
-                    fmt, std::forward<Args>(args)...);
-            } catch (...) {
-                E2D_ASSERT_MSG(false, "DEBUG: ignored log formatting exception");
+        std::shared_ptr<const sink_list> sinks;
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if ( lvl < min_level_ || !sinks_ || sinks_->empty() ) {
                 return *this;
             }
-            for ( const auto& [slvl, sink] : sinks_ ) {
-                if ( lvl >= slvl && sink ) {
-                    bool success = sink->on_message(lvl, formatted_text);
-                    E2D_UNUSED(success);
-                    E2D_ASSERT_MSG(success, "DEBUG: ignored failed log sink call");
-                }
+            sinks = sinks_;
+        }
+        str formatted_text;
+        try {
+            formatted_text = strings::rformat(
+                fmt, std::forward<Args>(args)...);
+        } catch (...) {
+            E2D_ASSERT_MSG(false, "DEBUG: ignored log formatting exception");
+            return *this;
+        }
+        for ( const auto& entry : *sinks ) {
+            if ( lvl >= entry->min_level ) {
+                send_message_(*entry, lvl, formatted_text);
             }
         }
         return *this;
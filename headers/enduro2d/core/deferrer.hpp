@@ -10,6 +10,43 @@
 
 namespace e2d
 {
+    //
+    // deferrer_priority
+    //
+
+    enum class deferrer_priority : u8 {
+        low,
+        normal,
+        high
+    };
+
+    //
+    // deferrer_statistics
+    //
+
+    struct deferrer_statistics {
+        // main thread tasks waiting at the moment
+        std::size_t queued_tasks{0u};
+
+        // the last frame tick: executed tasks, tasks left
+        // for the next frames and time spent on them
+        std::size_t executed_tasks{0u};
+        std::size_t deferred_tasks{0u};
+        microseconds<u64> spent_time;
+
+        u64 total_executed_tasks{0u};
+        microseconds<u64> total_spent_time;
+    };
+
+    //
+    // deferrer
+    //
+    // Main thread tasks are processed by frame ticks in priority order
+    // until the budget is spent, the rest is carried over to the next
+    // frames. Tasks of the same priority are processed in FIFO order,
+    // tasks queued during a frame tick are processed by the next one.
+    //
+
     class deferrer final : public module<deferrer> {
     public:
         deferrer();
@@ -26,6 +63,11 @@ namespace e2d
                  , typename R = stdex::scheduler::schedule_invoke_result_t<F, Args...> >
         stdex::promise<R> do_in_main_thread(F&& f, Args&&... args);
 
+        template < typename F
+                 , typename... Args
+                 , typename R = stdex::scheduler::schedule_invoke_result_t<F, Args...> >
+        stdex::promise<R> do_in_main_thread(deferrer_priority priority, F&& f, Args&&... args);
+
         template < typename F
                  , typename... Args
                  , typename R = stdex::jobber::async_invoke_result_t<F, Args...> >
@@ -34,18 +76,105 @@ namespace e2d
         template < typename T >
         void active_safe_wait_promise(const stdex::promise<T>& promise) noexcept;
 
+        // at least one task is processed per frame even with a zero budget
+        deferrer& main_thread_budget(microseconds<u64> budget) noexcept;
+        [[nodiscard]] microseconds<u64> main_thread_budget() const noexcept;
+
+        [[nodiscard]] deferrer_statistics statistics() const noexcept;
+
+        // returns false if there are no queued main thread tasks
+        bool process_one_main_thread_task() noexcept;
+
         void frame_tick() noexcept;
+    private:
+        class main_thread_task {
+        public:
+            virtual ~main_thread_task() noexcept = default;
+            virtual void run() noexcept = 0;
+        };
+        using main_thread_task_uptr = std::unique_ptr<main_thread_task>;
+
+        template < typename F >
+        class main_thread_task_impl final : public main_thread_task {
+        public:
+            main_thread_task_impl(F&& f);
+            void run() noexcept final;
+        private:
+            F f_;
+        };
+
+        struct main_thread_task_entry {
+            u64 sequence{0u};
+            main_thread_task_uptr task;
+        };
+
+        struct main_thread_task_queue {
+            vector<main_thread_task_entry> tasks;
+            std::size_t head{0u};
+        };
+
+        static constexpr std::size_t priority_count = 3u;
+    private:
+        void push_main_thread_task_(
+            deferrer_priority priority,
+            main_thread_task_uptr task);
+        // pops the most prioritized task queued before the 'sequence_end'
+        main_thread_task_uptr pop_main_thread_task_(u64 sequence_end) noexcept;
     private:
         stdex::jobber worker_;
         stdex::scheduler scheduler_;
+    private:
+        mutable std::mutex tasks_mutex_;
+        std::array<main_thread_task_queue, priority_count> tasks_;
+        std::size_t queued_tasks_{0u};
+        u64 next_task_sequence_{0u};
+        microseconds<u64> main_thread_budget_{make_microseconds<u64>(4000u)};
+        deferrer_statistics statistics_;
     };
 }
 
 namespace e2d
 {
+    template < typename F >
+    deferrer::main_thread_task_impl<F>::main_thread_task_impl(F&& f)
+    : f_(std::move(f)) {}
+
+    template < typename F >
+    void deferrer::main_thread_task_impl<F>::run() noexcept {
+        f_();
+    }
+
     template < typename F , typename... Args , typename R >
     stdex::promise<R> deferrer::do_in_main_thread(F&& f, Args&&... args) {
-        return scheduler_.schedule(std::forward<F>(f), std::forward<Args>(args)...);
+        return do_in_main_thread(
+            deferrer_priority::normal,
+            std::forward<F>(f),
+            std::forward<Args>(args)...);
+    }
+
+    template < typename F , typename... Args , typename R >
+    stdex::promise<R> deferrer::do_in_main_thread(deferrer_priority priority, F&& f, Args&&... args) {
+        stdex::promise<R> result;
+        auto task = [
+            result,
+            f = std::forward<F>(f),
+            args = std::make_tuple(std::forward<Args>(args)...)
+        ]() mutable noexcept {
+            try {
+                if constexpr ( std::is_void_v<R> ) {
+                    std::apply(std::move(f), std::move(args));
+                    result.resolve();
+                } else {
+                    result.resolve(std::apply(std::move(f), std::move(args)));
+                }
+            } catch (...) {
+                result.reject(std::current_exception());
+            }
+        };
+        push_main_thread_task_(
+            priority,
+            std::make_unique<main_thread_task_impl<decltype(task)>>(std::move(task)));
+        return result;
     }
 
     template < typename F , typename... Args , typename R >
@@ -57,7 +186,9 @@ namespace e2d
     void deferrer::active_safe_wait_promise(const stdex::promise<T>& promise) noexcept {
         const auto zero_us = time::to_chrono(make_microseconds(0));
         while ( promise.wait_for(zero_us) == stdex::promise_wait_status::timeout ) {
-            if ( !is_in_main_thread() || 0 == scheduler_.process_one_task().second ) {
+            const bool processed = is_in_main_thread()
+                && (process_one_main_thread_task() || 0 != scheduler_.process_one_task().second);
+            if ( !processed ) {
                 if ( 0 == worker_.active_wait_one().second ) {
                     std::this_thread::yield();
                 }
@@ -22,6 +22,8 @@ namespace e2d
         class debug_parameters;
         class window_parameters;
         class timer_parameters;
+        class vfs_parameters;
+        class deferrer_parameters;
         class parameters;
     public:
         engine(int argc, char *argv[], const parameters& params);
@@ -116,6 +118,34 @@ namespace e2d
         u32 maximal_framerate_{1000u};
     };
 
+    //
+    // engine::vfs_parameters
+    //
+
+    class engine::vfs_parameters {
+    public:
+        // zero means the count is chosen by hardware concurrency
+        vfs_parameters& worker_threads(u32 value) noexcept;
+
+        u32 worker_threads() const noexcept;
+    private:
+        u32 worker_threads_{0u};
+    };
+
+    //
+    // engine::deferrer_parameters
+    //
+
+    class engine::deferrer_parameters {
+    public:
+        // time per frame for main thread tasks, the rest is carried over
+        deferrer_parameters& main_thread_budget(microseconds<u64> value) noexcept;
+
+        microseconds<u64> main_thread_budget() const noexcept;
+    private:
+        microseconds<u64> main_thread_budget_{make_microseconds<u64>(4000u)};
+    };
+
     //
     // engine::parameters
     //
@@ -132,6 +162,8 @@ namespace e2d
         parameters& debug_params(debug_parameters value) noexcept;
         parameters& window_params(window_parameters value) noexcept;
         parameters& timer_params(timer_parameters value) noexcept;
+        parameters& vfs_params(vfs_parameters value) noexcept;
+        parameters& deferrer_params(deferrer_parameters value) noexcept;
 
         str& game_name() noexcept;
         str& company_name() noexcept;
@@ -140,6 +172,8 @@ namespace e2d
         debug_parameters& debug_params() noexcept;
         window_parameters& window_params() noexcept;
         timer_parameters& timer_params() noexcept;
+        vfs_parameters& vfs_params() noexcept;
+        deferrer_parameters& deferrer_params() noexcept;
 
         const str& game_name() const noexcept;
         const str& company_name() const noexcept;
@@ -148,6 +182,8 @@ namespace e2d
         const debug_parameters& debug_params() const noexcept;
         const window_parameters& window_params() const noexcept;
         const timer_parameters& timer_params() const noexcept;
+        const vfs_parameters& vfs_params() const noexcept;
+        const deferrer_parameters& deferrer_params() const noexcept;
     private:
         str game_name_{"noname"};
         str company_name_{"noname"};
@@ -156,6 +192,8 @@ namespace e2d
         debug_parameters debug_params_;
         window_parameters window_params_;
         timer_parameters timer_params_;
+        vfs_parameters vfs_params_;
+        deferrer_parameters deferrer_params_;
     };
 }
 
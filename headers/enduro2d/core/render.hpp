@@ -255,6 +255,7 @@ namespace e2d
     public:
         const v2u& size() const noexcept;
         const pixel_declaration& decl() const noexcept;
+        u32 mipmap_count() const noexcept;
     private:
         internal_state_uptr state_;
     };
@@ -431,7 +432,11 @@ namespace e2d
 
         ENUM_HPP_CLASS_DECL(sampler_min_filter, u8,
             (nearest)
-            (linear))
+            (linear)
+            (nearest_mipmap_nearest)
+            (linear_mipmap_nearest)
+            (nearest_mipmap_linear)
+            (linear_mipmap_linear))
 
         ENUM_HPP_CLASS_DECL(sampler_mag_filter, u8,
             (nearest)
@@ -653,8 +658,11 @@ namespace e2d
             property_block& merge(const property_block& pb);
             bool equals(const property_block& other) const noexcept;
 
+            // hashes raw values, blocks that are equal within epsilon
+            // may hash differently, so it's only good for quick rejects
+            std::size_t hash() const noexcept;
+
             property_block& sampler(str_hash name, const sampler_state& s);
-            sampler_state* sampler(str_hash name) noexcept;
             const sampler_state* sampler(str_hash name) const noexcept;
 
             template < typename T >
@@ -663,7 +671,6 @@ namespace e2d
             const T* property(str_hash name) const noexcept;
 
             property_block& property(str_hash name, const property_value& v);
-            property_value* property(str_hash name) noexcept;
             const property_value* property(str_hash name) const noexcept;
 
             template < typename F >
@@ -677,6 +684,8 @@ namespace e2d
         private:
             property_map<sampler_state> samplers_;
             property_map<property_value> properties_;
+            mutable std::size_t hash_ = 0;
+            mutable bool hash_valid_ = false;
         };
 
         class pass_state final {
@@ -870,6 +879,63 @@ namespace e2d
             std::size_t command_count_ = 0;
         };
 
+        class command_queue final {
+        public:
+            command_queue() = default;
+
+            static u64 make_sort_key(
+                u32 target,
+                u32 layer,
+                u32 depth,
+                u32 material,
+                u32 texture) noexcept;
+
+            command_queue& add_command(u64 sort_key, command_value&& value);
+            command_queue& add_command(u64 sort_key, const command_value& value);
+
+            command_queue& sort();
+            command_queue& clear() noexcept;
+
+            const command_value& command(std::size_t index) const noexcept;
+            u64 sort_key(std::size_t index) const noexcept;
+            std::size_t command_count() const noexcept;
+        private:
+            struct entry {
+                u64 sort_key = 0;
+                command_value value;
+            };
+            vector<entry> commands_;
+        };
+
+        class ring_allocator final {
+        public:
+            struct allocation {
+                std::size_t offset = 0;
+                bool orphaned = false;
+            };
+        public:
+            ring_allocator() = default;
+            ring_allocator(std::size_t capacity, std::size_t frame_count) noexcept;
+
+            // returns an empty optional when the size doesn't fit the capacity at all,
+            // an orphaned allocation means that the whole storage must be discarded first
+            std::optional<allocation> allocate(std::size_t size, std::size_t alignment) noexcept;
+
+            ring_allocator& next_frame();
+            ring_allocator& reset(std::size_t capacity) noexcept;
+
+            std::size_t capacity() const noexcept;
+            std::size_t frame_count() const noexcept;
+            std::size_t used_size() const noexcept;
+        private:
+            std::size_t capacity_ = 0;
+            std::size_t frame_count_ = 1;
+            std::size_t head_ = 0;
+            std::size_t used_ = 0;
+            std::size_t frame_used_ = 0;
+            vector<std::size_t> frames_used_;
+        };
+
         ENUM_HPP_CLASS_DECL(api_profile, u8,
             (unknown)
             (gles_2_0)
@@ -907,6 +973,182 @@ namespace e2d
             bool pvrtc_compression_supported = false;
             bool pvrtc2_compression_supported = false;
         };
+
+        class state_cache final : private noncopyable {
+        public:
+            class backend {
+            public:
+                virtual ~backend() noexcept = default;
+
+                virtual void use_program(u32 program) noexcept = 0;
+                virtual void set_uniform(i32 location, const property_value& value) noexcept = 0;
+
+                virtual void active_texture(u32 unit) noexcept = 0;
+                virtual void bind_texture(u32 target, u32 texture) noexcept = 0;
+
+                virtual void set_texture_s_wrap(u32 target, sampler_wrap wrap) noexcept = 0;
+                virtual void set_texture_t_wrap(u32 target, sampler_wrap wrap) noexcept = 0;
+                virtual void set_texture_min_filter(u32 target, sampler_min_filter filter) noexcept = 0;
+                virtual void set_texture_mag_filter(u32 target, sampler_mag_filter filter) noexcept = 0;
+
+                virtual void enable_attribute(u32 index) noexcept = 0;
+                virtual void disable_attribute(u32 index) noexcept = 0;
+            };
+
+            struct statistics {
+                std::size_t avoided_program_binds = 0;
+                std::size_t avoided_uniform_uploads = 0;
+                std::size_t avoided_texture_units = 0;
+                std::size_t avoided_texture_binds = 0;
+                std::size_t avoided_sampler_params = 0;
+                std::size_t avoided_attribute_toggles = 0;
+            };
+
+            // owned by a program object and indexed by its uniform slots,
+            // the cache doesn't know when ids are reused
+            using uniform_values = vector<std::optional<property_value>>;
+
+            // owned by a texture object, wraps and filters are per-texture state
+            struct sampler_values {
+                bool valid = false;
+                sampler_wrap s_wrap = sampler_wrap::repeat;
+                sampler_wrap t_wrap = sampler_wrap::repeat;
+                sampler_min_filter min_filter = sampler_min_filter::linear;
+                sampler_mag_filter mag_filter = sampler_mag_filter::linear;
+            };
+        public:
+            explicit state_cache(backend& backend) noexcept;
+            ~state_cache() noexcept = default;
+
+            state_cache& invalidate() noexcept;
+
+            state_cache& use_program(u32 program) noexcept;
+            state_cache& set_uniform(
+                uniform_values& values,
+                std::size_t slot,
+                i32 location,
+                const property_value& value);
+
+            state_cache& bind_texture(u32 unit, u32 target, u32 texture);
+            state_cache& set_sampler(
+                sampler_values& values,
+                u32 unit,
+                u32 target,
+                const sampler_state& sampler) noexcept;
+
+            state_cache& begin_attributes() noexcept;
+            state_cache& enable_attribute(u32 index);
+            state_cache& end_attributes() noexcept;
+
+            state_cache& reset_statistics() noexcept;
+            const statistics& stats() const noexcept;
+        private:
+            void active_texture_(u32 unit) noexcept;
+        private:
+            backend& backend_;
+            statistics stats_;
+            std::optional<u32> program_;
+            std::optional<u32> active_unit_;
+            flat_map<std::pair<u32, u32>, u32> textures_;
+            vector<bool> enabled_attributes_;
+            vector<bool> desired_attributes_;
+        };
+
+        class texture_uploader final : private noncopyable {
+        public:
+            class backend {
+            public:
+                virtual ~backend() noexcept = default;
+
+                virtual texture_ptr create_texture(
+                    const image& image) = 0;
+
+                virtual texture_ptr create_texture(
+                    const v2u& size,
+                    const pixel_declaration& decl,
+                    u32 mipmap_count) = 0;
+
+                virtual void update_texture(
+                    const texture_ptr& tex,
+                    buffer_view pixels,
+                    const b2u& region,
+                    u32 mipmap_level) = 0;
+
+                // may be less than requested, e.g. for npot textures without npot support
+                virtual u32 texture_mipmap_count(
+                    const texture_ptr& tex) const noexcept = 0;
+            };
+
+            class upload final : private noncopyable {
+            public:
+                upload(
+                    texture_ptr texture,
+                    std::shared_ptr<const image> source,
+                    const pixel_declaration& decl);
+
+                const texture_ptr& texture() const noexcept;
+                const stdex::promise<texture_ptr>& result() const noexcept;
+
+                bool ready() const noexcept;
+                u32 uploaded_levels() const noexcept;
+                u32 uploaded_rows() const noexcept;
+            private:
+                friend class texture_uploader;
+                texture_ptr texture_;
+                std::shared_ptr<const image> source_;
+                pixel_declaration decl_;
+                u32 level_count_ = 0;
+                u32 uploaded_levels_ = 0;
+                u32 uploaded_rows_ = 0;
+                stdex::promise<texture_ptr> result_;
+            };
+            using upload_ptr = std::shared_ptr<upload>;
+
+            struct statistics {
+                std::size_t uploaded_bands = 0;
+                std::size_t uploaded_bytes = 0;
+                u64 total_uploaded_bytes = 0;
+            };
+        public:
+            explicit texture_uploader(backend& backend) noexcept;
+            ~texture_uploader() noexcept;
+
+            // images that fit the budget are uploaded at once, the rest are
+            // allocated now and filled by row bands level by level
+            // during the next frame ticks, the source is shared, not copied
+            upload_ptr upload_texture(image image, const pixel_declaration& decl);
+            upload_ptr upload_texture(std::shared_ptr<const image> image, const pixel_declaration& decl);
+
+            // uploads bands until the budget is spent, at least one band per tick
+            texture_uploader& frame_tick();
+            texture_uploader& flush();
+
+            texture_uploader& byte_budget(std::size_t budget) noexcept;
+            std::size_t byte_budget() const noexcept;
+
+            bool empty() const noexcept;
+            std::size_t pending_count() const noexcept;
+
+            texture_uploader& reset_statistics() noexcept;
+            const statistics& stats() const noexcept;
+
+            // the height of bands that fit the budget, a multiple of the block height
+            static u32 band_height(
+                const pixel_declaration& decl,
+                u32 width,
+                std::size_t budget) noexcept;
+
+            // ETC1 and PVRTC textures can't be partially updated at all
+            static bool is_band_uploadable(
+                const pixel_declaration& decl) noexcept;
+        private:
+            std::size_t upload_band_(upload& upload);
+        private:
+            backend& backend_;
+            std::size_t byte_budget_ = 1024u * 1024u;
+            vector<upload_ptr> pending_;
+            statistics stats_;
+        };
     public:
         render(debug& d, window& w);
         ~render() noexcept final;
@@ -924,18 +1166,29 @@ namespace e2d
 
         texture_ptr create_texture(
             const v2u& size,
-            const pixel_declaration& decl);
+            const pixel_declaration& decl,
+            u32 mipmap_count = 1u);
 
         index_buffer_ptr create_index_buffer(
             buffer_view indices,
             const index_declaration& decl,
             index_buffer::usage usage);
 
+        index_buffer_ptr create_index_buffer(
+            std::size_t size,
+            const index_declaration& decl,
+            index_buffer::usage usage);
+
         vertex_buffer_ptr create_vertex_buffer(
             buffer_view vertices,
             const vertex_declaration& decl,
             vertex_buffer::usage usage);
 
+        vertex_buffer_ptr create_vertex_buffer(
+            std::size_t size,
+            const vertex_declaration& decl,
+            vertex_buffer::usage usage);
+
         render_target_ptr create_render_target(
             const v2u& size,
             const pixel_declaration& color_decl,
@@ -945,6 +1198,7 @@ namespace e2d
         template < std::size_t N >
         render& execute(const command_block<N>& commands);
         render& execute(const command_value& command);
+        render& execute(const command_queue& commands);
 
         render& execute(const draw_command& command);
         render& execute(const clear_command& command);
@@ -961,6 +1215,12 @@ namespace e2d
             buffer_view vertices,
             std::size_t offset);
 
+        render& orphan_buffer(
+            const index_buffer_ptr& ibuffer);
+
+        render& orphan_buffer(
+            const vertex_buffer_ptr& vbuffer);
+
         render& update_texture(
             const texture_ptr& tex,
             const image& img,
@@ -969,15 +1229,34 @@ namespace e2d
         render& update_texture(
             const texture_ptr& tex,
             buffer_view pixels,
-            const b2u& region);
+            const b2u& region,
+            u32 mipmap_level = 0u);
 
         const device_caps& device_capabilities() const noexcept;
         bool is_pixel_supported(const pixel_declaration& decl) const noexcept;
         bool is_index_supported(const index_declaration& decl) const noexcept;
         bool is_vertex_supported(const vertex_declaration& decl) const noexcept;
+
+        const state_cache::statistics& state_statistics() const noexcept;
+
+        // large textures are uploaded across frames under the uploader budget,
+        // the upload result is resolved when the texture is complete
+        texture_uploader::upload_ptr upload_texture(
+            image image);
+        texture_uploader::upload_ptr upload_texture(
+            std::shared_ptr<const image> image);
+
+        texture_uploader& texture_uploads() noexcept;
+        const texture_uploader& texture_uploads() const noexcept;
+    private:
+        void schedule_texture_uploads_();
     private:
         class internal_state;
         std::unique_ptr<internal_state> state_;
+        class texture_upload_backend;
+        std::unique_ptr<texture_upload_backend> texture_upload_backend_;
+        std::unique_ptr<texture_uploader> texture_uploader_;
+        bool texture_uploads_scheduled_ = false;
     };
 
     ENUM_HPP_REGISTER_TRAITS(render::topology)
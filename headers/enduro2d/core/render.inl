@@ -143,6 +143,7 @@ namespace e2d
     template < typename T >
     render::property_block& render::property_block::property(str_hash name, T&& v) {
         properties_.assign(name, std::forward<T>(v));
+        hash_valid_ = false;
         return *this;
     }
 
@@ -33,10 +33,14 @@ namespace e2d
             virtual input_stream_uptr read(str_view path) const = 0;
             virtual output_stream_uptr write(str_view path, bool append) const = 0;
             virtual bool trace(str_view path, filesystem::trace_func func) const = 0;
+
+            // default implementation reads the whole file into memory
+            virtual mapped_file_uptr map(str_view path) const;
         };
         using file_source_uptr = std::unique_ptr<file_source>;
     public:
         vfs();
+        explicit vfs(u32 worker_threads);
         ~vfs() noexcept final;
 
         stdex::jobber& worker() noexcept;
@@ -55,6 +59,11 @@ namespace e2d
         input_stream_uptr read(const url& url) const;
         output_stream_uptr write(const url& url, bool append) const;
 
+        // the content stays valid while the result is alive, so parsers
+        // can read it in place without copying the file into a buffer
+        mapped_file_uptr map(const url& url) const;
+        stdex::promise<mapped_file_sptr> map_async(const url& url) const;
+
         std::optional<buffer> load(const url& url) const;
         stdex::promise<buffer> load_async(const url& url) const;
 
@@ -73,13 +82,37 @@ namespace e2d
 
     class archive_file_source final : public vfs::file_source {
     public:
-        archive_file_source(input_stream_uptr stream);
+        // decompressed entries are kept in memory up to cache_budget bytes,
+        // the least recently used ones are dropped first
+        archive_file_source(input_stream_uptr stream, std::size_t cache_budget = 0u);
         ~archive_file_source() noexcept final;
         bool valid() const noexcept final;
         bool exists(str_view path) const final;
         input_stream_uptr read(str_view path) const final;
         output_stream_uptr write(str_view path, bool append) const final;
         bool trace(str_view path, filesystem::trace_func func) const final;
+        mapped_file_uptr map(str_view path) const final;
+
+        std::size_t cache_budget() const noexcept;
+        std::size_t cache_size() const noexcept;
+    private:
+        class state;
+        std::unique_ptr<state> state_;
+    };
+
+    class pack_file_source final : public vfs::file_source {
+    public:
+        // stored entries of a mapped pack are mapped without copying,
+        // chunks of compressed entries are inflated by worker_threads
+        pack_file_source(mapped_file_uptr file, u32 worker_threads = 0u);
+        pack_file_source(input_stream_uptr stream, u32 worker_threads = 0u);
+        ~pack_file_source() noexcept final;
+        bool valid() const noexcept final;
+        bool exists(str_view path) const final;
+        input_stream_uptr read(str_view path) const final;
+        output_stream_uptr write(str_view path, bool append) const final;
+        bool trace(str_view path, filesystem::trace_func func) const final;
+        mapped_file_uptr map(str_view path) const final;
     private:
         class state;
         std::unique_ptr<state> state_;
@@ -94,6 +127,7 @@ namespace e2d
         input_stream_uptr read(str_view path) const final;
         output_stream_uptr write(str_view path, bool append) const final;
         bool trace(str_view path, filesystem::trace_func func) const final;
+        mapped_file_uptr map(str_view path) const final;
     };
 }
 
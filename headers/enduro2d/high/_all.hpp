@@ -14,6 +14,7 @@
 #include "assets/font_asset.hpp"
 #include "assets/image_asset.hpp"
 #include "assets/json_asset.hpp"
+#include "assets/manifest_asset.hpp"
 #include "assets/material_asset.hpp"
 #include "assets/mesh_asset.hpp"
 #include "assets/model_asset.hpp"
@@ -45,6 +46,7 @@
 
 #include "resources/atlas.hpp"
 #include "resources/flipbook.hpp"
+#include "resources/manifest.hpp"
 #include "resources/model.hpp"
 #include "resources/prefab.hpp"
 #include "resources/sprite.hpp"
@@ -26,6 +26,7 @@ namespace e2d
     class font_asset;
     class image_asset;
     class json_asset;
+    class manifest_asset;
     class material_asset;
     class mesh_asset;
     class model_asset;
@@ -62,6 +63,7 @@ namespace e2d
 
     class atlas;
     class flipbook;
+    class manifest;
     class model;
     class prefab;
     class sprite;
@@ -37,8 +37,28 @@ namespace e2d
         asset() = default;
         virtual ~asset() noexcept = default;
         virtual asset_ptr find_nested_asset(str_view nested_address) const noexcept = 0;
+
+        // approximate number of bytes held by the asset and its nested assets
+        virtual std::size_t memory_usage() const noexcept = 0;
     };
 
+    //
+    // content_memory_usage
+    //
+
+    namespace impl
+    {
+        template < typename Content >
+        std::size_t content_memory_usage(const Content& content) noexcept;
+
+        std::size_t content_memory_usage(const str& content) noexcept;
+        std::size_t content_memory_usage(const buffer& content) noexcept;
+        std::size_t content_memory_usage(const image& content) noexcept;
+        std::size_t content_memory_usage(const mesh& content) noexcept;
+        std::size_t content_memory_usage(const shape& content) noexcept;
+        std::size_t content_memory_usage(const texture_ptr& content) noexcept;
+    }
+
     //
     // content_asset
     //
@@ -65,11 +85,25 @@ namespace e2d
         template < typename NestedAsset >
         typename NestedAsset::ptr find_nested_asset(str_view nested_address) const noexcept;
         asset_ptr find_nested_asset(str_view nested_address) const noexcept override;
+
+        std::size_t memory_usage() const noexcept override;
     private:
         Content content_;
         nested_content nested_content_;
     };
 
+    //
+    // asset_cache_statistics
+    //
+
+    struct asset_cache_statistics {
+        std::size_t asset_count{0u};
+        std::size_t memory_usage{0u};
+        std::size_t hits{0u};
+        std::size_t misses{0u};
+        std::size_t evictions{0u};
+    };
+
     //
     // asset_cache
     //
@@ -82,12 +116,25 @@ namespace e2d
         class asset_cache
             : private noncopyable
             , public ref_counter<asset_cache> {
+        public:
+            struct unused_asset {
+                str_hash address;
+                u64 last_use{0u};
+                std::size_t memory_usage{0u};
+                asset_cache* cache{nullptr};
+            };
         public:
             asset_cache() = default;
             virtual ~asset_cache() noexcept = default;
 
+            virtual const char* type_name() const noexcept = 0;
             virtual std::size_t asset_count() const noexcept = 0;
+            virtual std::size_t memory_usage() const noexcept = 0;
+            virtual asset_cache_statistics statistics() const noexcept = 0;
+
             virtual std::size_t unload_unused_assets() noexcept = 0;
+            virtual void collect_unused_assets(vector<unused_asset>& dst) = 0;
+            virtual bool evict_unused_asset(str_hash address) noexcept = 0;
         };
 
         template < typename Asset >
@@ -98,19 +145,37 @@ namespace e2d
             typed_asset_cache() = default;
             ~typed_asset_cache() noexcept final = default;
 
-            asset_ptr find(str_hash address) const noexcept;
-            void store(str_hash address, const asset_ptr& asset);
+            asset_ptr find(str_hash address, u64 use_tick) noexcept;
+            asset_ptr peek(str_hash address) const noexcept;
+            void store(str_hash address, const asset_ptr& asset, u64 use_tick);
 
+            const char* type_name() const noexcept override;
             std::size_t asset_count() const noexcept override;
+            std::size_t memory_usage() const noexcept override;
+            asset_cache_statistics statistics() const noexcept override;
+
             std::size_t unload_unused_assets() noexcept override;
+            void collect_unused_assets(vector<unused_asset>& dst) override;
+            bool evict_unused_asset(str_hash address) noexcept override;
+        private:
+            struct entry {
+                asset_ptr asset;
+                std::size_t memory_usage{0u};
+                u64 last_use{0u};
+            };
         private:
-            hash_map<str_hash, asset_ptr> assets_;
+            hash_map<str_hash, entry> assets_;
+            asset_cache_statistics stats_;
         };
     }
 
     //
     // asset_store
     //
+    // Assets referenced only by the store are kept while the memory usage
+    // fits in the budget, the least recently used ones are evicted first.
+    // Only 'find' counts as a use, 'peek' leaves the store untouched.
+    //
 
     class asset_store final {
     public:
@@ -121,15 +186,29 @@ namespace e2d
         void store(str_hash address, const typename Asset::ptr& asset);
 
         template < typename Asset >
-        typename Asset::ptr find(str_hash address) const noexcept;
+        typename Asset::ptr find(str_hash address) noexcept;
+
+        template < typename Asset >
+        typename Asset::ptr peek(str_hash address) const noexcept;
 
         template < typename Asset >
         std::size_t asset_count() const noexcept;
         std::size_t asset_count() const noexcept;
 
+        template < typename Asset >
+        asset_cache_statistics statistics() const noexcept;
+        flat_map<str, asset_cache_statistics> statistics() const;
+        std::size_t memory_usage() const noexcept;
+
+        asset_store& memory_budget(std::size_t value) noexcept;
+        std::size_t memory_budget() const noexcept;
+
         std::size_t unload_unused_assets() noexcept;
+        std::size_t evict_unused_assets() noexcept;
     private:
         hash_map<utils::type_family_id, impl::asset_cache_iptr> caches_;
+        std::size_t memory_budget_{std::numeric_limits<std::size_t>::max()};
+        u64 use_counter_{0u};
     };
 }
 
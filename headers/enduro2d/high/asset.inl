@@ -10,6 +10,19 @@
 
 namespace e2d
 {
+    //
+    // content_memory_usage
+    //
+
+    namespace impl
+    {
+        template < typename Content >
+        std::size_t content_memory_usage(const Content& content) noexcept {
+            E2D_UNUSED(content);
+            return 0u;
+        }
+    }
+
     //
     // content_asset
     //
@@ -70,6 +83,18 @@ namespace e2d
             : iter->second->find_nested_asset(nested_asset);
     }
 
+    template < typename Asset, typename Content >
+    std::size_t content_asset<Asset, Content>::memory_usage() const noexcept {
+        return std::accumulate(
+            nested_content_.begin(), nested_content_.end(),
+            sizeof(Asset) + impl::content_memory_usage(content_),
+            [](std::size_t acc, const auto& p){
+                return p.second
+                    ? acc + p.second->memory_usage()
+                    : acc;
+            });
+    }
+
     //
     // typed_asset_cache
     //
@@ -77,16 +102,43 @@ namespace e2d
     namespace impl
     {
         template < typename T >
-        typename typed_asset_cache<T>::asset_ptr typed_asset_cache<T>::find(str_hash address) const noexcept {
+        typename typed_asset_cache<T>::asset_ptr typed_asset_cache<T>::find(
+            str_hash address,
+            u64 use_tick) noexcept
+        {
+            const auto iter = assets_.find(address);
+            if ( iter == assets_.end() ) {
+                ++stats_.misses;
+                return nullptr;
+            }
+            ++stats_.hits;
+            iter->second.last_use = use_tick;
+            return iter->second.asset;
+        }
+
+        template < typename T >
+        typename typed_asset_cache<T>::asset_ptr typed_asset_cache<T>::peek(
+            str_hash address) const noexcept
+        {
             const auto iter = assets_.find(address);
             return iter != assets_.end()
-                ? iter->second
+                ? iter->second.asset
                 : nullptr;
         }
 
         template < typename T >
-        void typed_asset_cache<T>::store(str_hash address, const asset_ptr& asset) {
-            assets_[address] = asset;
+        void typed_asset_cache<T>::store(str_hash address, const asset_ptr& asset, u64 use_tick) {
+            entry& e = assets_[address];
+            stats_.memory_usage -= e.memory_usage;
+            e.asset = asset;
+            e.memory_usage = asset ? asset->memory_usage() : 0u;
+            e.last_use = use_tick;
+            stats_.memory_usage += e.memory_usage;
+        }
+
+        template < typename T >
+        const char* typed_asset_cache<T>::type_name() const noexcept {
+            return T::type_name();
         }
 
         template < typename T >
@@ -94,11 +146,24 @@ namespace e2d
             return assets_.size();
         }
 
+        template < typename T >
+        std::size_t typed_asset_cache<T>::memory_usage() const noexcept {
+            return stats_.memory_usage;
+        }
+
+        template < typename T >
+        asset_cache_statistics typed_asset_cache<T>::statistics() const noexcept {
+            asset_cache_statistics result = stats_;
+            result.asset_count = assets_.size();
+            return result;
+        }
+
         template < typename T >
         std::size_t typed_asset_cache<T>::unload_unused_assets() noexcept {
             std::size_t result = 0u;
             for ( auto iter = assets_.begin(); iter != assets_.end(); ) {
-                if ( !iter->second || 1 == iter->second->use_count() ) {
+                if ( !iter->second.asset || 1 == iter->second.asset->use_count() ) {
+                    stats_.memory_usage -= iter->second.memory_usage;
                     iter = assets_.erase(iter);
                     ++result;
                 } else {
@@ -107,6 +172,30 @@ namespace e2d
             }
             return result;
         }
+
+        template < typename T >
+        void typed_asset_cache<T>::collect_unused_assets(vector<unused_asset>& dst) {
+            for ( const auto& [address, e] : assets_ ) {
+                if ( !e.asset || 1 == e.asset->use_count() ) {
+                    dst.push_back({address, e.last_use, e.memory_usage, this});
+                }
+            }
+        }
+
+        template < typename T >
+        bool typed_asset_cache<T>::evict_unused_asset(str_hash address) noexcept {
+            const auto iter = assets_.find(address);
+            if ( iter == assets_.end() ) {
+                return false;
+            }
+            if ( iter->second.asset && 1 != iter->second.asset->use_count() ) {
+                return false;
+            }
+            stats_.memory_usage -= iter->second.memory_usage;
+            ++stats_.evictions;
+            assets_.erase(iter);
+            return true;
+        }
     }
 
     //
@@ -125,17 +214,29 @@ namespace e2d
                 family,
                 make_intrusive<impl::typed_asset_cache<Asset>>()).first->second.get());
         }
-        cache->store(address, asset);
+        cache->store(address, asset, ++use_counter_);
+        evict_unused_assets();
     }
 
     template < typename Asset >
-    typename Asset::ptr asset_store::find(str_hash address) const noexcept {
+    typename Asset::ptr asset_store::find(str_hash address) noexcept {
+        const auto iter = caches_.find(utils::type_family<Asset>::id());
+        impl::typed_asset_cache<Asset>* cache = iter != caches_.end() && iter->second
+            ? static_cast<impl::typed_asset_cache<Asset>*>(iter->second.get())
+            : nullptr;
+        return cache
+            ? cache->find(address, ++use_counter_)
+            : nullptr;
+    }
+
+    template < typename Asset >
+    typename Asset::ptr asset_store::peek(str_hash address) const noexcept {
         const auto iter = caches_.find(utils::type_family<Asset>::id());
         const impl::typed_asset_cache<Asset>* cache = iter != caches_.end() && iter->second
             ? static_cast<const impl::typed_asset_cache<Asset>*>(iter->second.get())
             : nullptr;
         return cache
-            ? cache->find(address)
+            ? cache->peek(address)
             : nullptr;
     }
 
@@ -157,6 +258,44 @@ namespace e2d
             });
     }
 
+    template < typename Asset >
+    asset_cache_statistics asset_store::statistics() const noexcept {
+        const auto iter = caches_.find(utils::type_family<Asset>::id());
+        return iter != caches_.end() && iter->second
+            ? iter->second->statistics()
+            : asset_cache_statistics();
+    }
+
+    inline flat_map<str, asset_cache_statistics> asset_store::statistics() const {
+        flat_map<str, asset_cache_statistics> result;
+        for ( const auto& p : caches_ ) {
+            if ( p.second ) {
+                result.emplace(p.second->type_name(), p.second->statistics());
+            }
+        }
+        return result;
+    }
+
+    inline std::size_t asset_store::memory_usage() const noexcept {
+        return std::accumulate(
+            caches_.begin(), caches_.end(), std::size_t(0),
+            [](std::size_t acc, const auto& p){
+                return p.second
+                    ? acc + p.second->memory_usage()
+                    : acc;
+            });
+    }
+
+    inline asset_store& asset_store::memory_budget(std::size_t value) noexcept {
+        memory_budget_ = value;
+        evict_unused_assets();
+        return *this;
+    }
+
+    inline std::size_t asset_store::memory_budget() const noexcept {
+        return memory_budget_;
+    }
+
     inline std::size_t asset_store::unload_unused_assets() noexcept {
         return std::accumulate(
             caches_.begin(), caches_.end(), std::size_t(0),
@@ -166,4 +305,36 @@ namespace e2d
                     : acc;
             });
     }
+
+    inline std::size_t asset_store::evict_unused_assets() noexcept {
+        std::size_t usage = memory_usage();
+        if ( usage <= memory_budget_ ) {
+            return 0u;
+        }
+        try {
+            vector<impl::asset_cache::unused_asset> unused;
+            for ( const auto& p : caches_ ) {
+                if ( p.second ) {
+                    p.second->collect_unused_assets(unused);
+                }
+            }
+            std::sort(unused.begin(), unused.end(),
+                [](const auto& l, const auto& r) noexcept {
+                    return l.last_use < r.last_use;
+                });
+            std::size_t result = 0u;
+            for ( const auto& u : unused ) {
+                if ( usage <= memory_budget_ ) {
+                    break;
+                }
+                if ( u.cache->evict_unused_asset(u.address) ) {
+                    usage -= u.memory_usage;
+                    ++result;
+                }
+            }
+            return result;
+        } catch (...) {
+            return 0u;
+        }
+    }
 }
@@ -0,0 +1,21 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "../_high.hpp"
+
+#include "../library.hpp"
+#include "../resources/manifest.hpp"
+
+namespace e2d
+{
+    class manifest_asset final : public content_asset<manifest_asset, manifest> {
+    public:
+        static const char* type_name() noexcept { return "manifest_asset"; }
+        static load_async_result load_async(const library& library, str_view address);
+    };
+}
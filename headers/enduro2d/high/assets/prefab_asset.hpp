@@ -17,5 +17,13 @@ namespace e2d
     public:
         static const char* type_name() noexcept { return "prefab_asset"; }
         static load_async_result load_async(const library& library, str_view address);
+
+        // the content is compiled into a flat prefab when filled,
+        // so it can be passed to world::instantiate_batch as is
+        void fill(prefab content);
+        void fill(prefab content, nested_content nested_content);
+        const flat_prefab& flat_content() const noexcept;
+    private:
+        flat_prefab flat_content_;
     };
 }
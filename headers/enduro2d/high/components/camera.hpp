@@ -14,6 +14,7 @@ namespace e2d
     public:
         class input final {};
         class gizmos final {};
+        class statistics;
     public:
         ENUM_HPP_CLASS_DECL(modes, u8,
             (manual)
@@ -56,6 +57,20 @@ namespace e2d
     };
 
     ENUM_HPP_REGISTER_TRAITS(camera::modes)
+
+    class camera::statistics final {
+    public:
+        statistics() = default;
+
+        statistics& drawn_nodes(std::size_t value) noexcept;
+        statistics& culled_nodes(std::size_t value) noexcept;
+
+        [[nodiscard]] std::size_t drawn_nodes() const noexcept;
+        [[nodiscard]] std::size_t culled_nodes() const noexcept;
+    private:
+        std::size_t drawn_nodes_ = 0u;
+        std::size_t culled_nodes_ = 0u;
+    };
 }
 
 namespace e2d
@@ -101,6 +116,20 @@ namespace e2d
             asset_dependencies& dependencies,
             const collect_context& ctx) const;
     };
+
+    template <>
+    class factory_loader<camera::statistics> final : factory_loader<> {
+    public:
+        static const char* schema_source;
+
+        bool operator()(
+            camera::statistics& component,
+            const fill_context& ctx) const;
+
+        bool operator()(
+            asset_dependencies& dependencies,
+            const collect_context& ctx) const;
+    };
 }
 
 namespace e2d
@@ -196,4 +225,22 @@ namespace e2d
     inline const color& camera::background() const noexcept {
         return background_;
     }
+
+    inline camera::statistics& camera::statistics::drawn_nodes(std::size_t value) noexcept {
+        drawn_nodes_ = value;
+        return *this;
+    }
+
+    inline camera::statistics& camera::statistics::culled_nodes(std::size_t value) noexcept {
+        culled_nodes_ = value;
+        return *this;
+    }
+
+    inline std::size_t camera::statistics::drawn_nodes() const noexcept {
+        return drawn_nodes_;
+    }
+
+    inline std::size_t camera::statistics::culled_nodes() const noexcept {
+        return culled_nodes_;
+    }
 }
@@ -11,6 +11,8 @@
 #include "asset.hpp"
 #include "starter.hpp"
 
+#include "resources/manifest.hpp"
+
 namespace e2d
 {
     //
@@ -23,12 +25,108 @@ namespace e2d
         }
     };
 
+    //
+    // asset_cache_policy
+    //
+    // Transient assets aren't kept in the asset store, they are released
+    // as soon as the assets built from them drop their references.
+    //
+
+    enum class asset_cache_policy : u8 {
+        persistent,
+        transient
+    };
+
+    //
+    // asset_loading_priority
+    //
+    // Visible loads start at once, prefetch and background ones
+    // wait in the loading queue for a free loading slot.
+    //
+
+    enum class asset_loading_priority : u8 {
+        background,
+        prefetch,
+        visible
+    };
+
+    //
+    // asset_loading_token
+    //
+
+    class asset_loading_token final
+        : private noncopyable
+        , public ref_counter<asset_loading_token> {
+    public:
+        asset_loading_token() = default;
+        ~asset_loading_token() noexcept = default;
+
+        void cancel() noexcept;
+        bool cancelled() const noexcept;
+    private:
+        std::atomic<bool> cancelled_{false};
+    };
+
+    using asset_loading_token_iptr = intrusive_ptr<asset_loading_token>;
+
+    //
+    // asset_loading_request
+    //
+
+    class asset_loading_request final {
+    public:
+        asset_loading_request() = default;
+        asset_loading_request(asset_cache_policy policy) noexcept;
+        asset_loading_request(asset_loading_priority priority) noexcept;
+
+        asset_loading_request& policy(asset_cache_policy value) noexcept;
+        asset_loading_request& priority(asset_loading_priority value) noexcept;
+        asset_loading_request& token(asset_loading_token_iptr value) noexcept;
+
+        asset_cache_policy policy() const noexcept;
+        asset_loading_priority priority() const noexcept;
+        const asset_loading_token_iptr& token() const noexcept;
+    private:
+        asset_cache_policy policy_{asset_cache_policy::persistent};
+        asset_loading_priority priority_{asset_loading_priority::visible};
+        asset_loading_token_iptr token_;
+    };
+
+    //
+    // asset_loading_progress
+    //
+
+    class asset_loading_progress final
+        : private noncopyable
+        , public ref_counter<asset_loading_progress> {
+    public:
+        asset_loading_progress() = default;
+        ~asset_loading_progress() noexcept = default;
+
+        void add_total(std::size_t count) noexcept;
+        void add_finished(std::size_t count) noexcept;
+
+        std::size_t total() const noexcept;
+        std::size_t finished() const noexcept;
+
+        // from zero to one, one when there is nothing to load
+        f32 ratio() const noexcept;
+    private:
+        std::atomic<std::size_t> total_{0u};
+        std::atomic<std::size_t> finished_{0u};
+    };
+
+    using asset_loading_progress_iptr = intrusive_ptr<asset_loading_progress>;
+
     //
     // loading_asset
     //
 
     namespace impl
     {
+        class asset_dependency;
+        using asset_dependency_iptr = intrusive_ptr<asset_dependency>;
+
         class loading_asset;
         using loading_asset_iptr = intrusive_ptr<loading_asset>;
 
@@ -36,30 +134,60 @@ namespace e2d
             : private noncopyable
             , public ref_counter<loading_asset> {
         public:
-            loading_asset() = default;
+            loading_asset(u64 key, str_hash address, u64 sequence) noexcept;
             virtual ~loading_asset() noexcept = default;
 
+            virtual void start() = 0;
             virtual void cancel() noexcept = 0;
-            virtual str_hash address() const noexcept = 0;
             virtual void wait(deferrer& deferrer) const noexcept = 0;
+
+            void add_request(const asset_loading_request& request);
+            bool cancelled() const noexcept;
+
+            void take_loading_slot() noexcept;
+            bool has_loading_slot() const noexcept;
+
+            u64 key() const noexcept;
+            str_hash address() const noexcept;
+            u64 sequence() const noexcept;
+            bool persistent() const noexcept;
+            asset_loading_priority priority() const noexcept;
+        private:
+            u64 key_{0u};
+            str_hash address_;
+            u64 sequence_{0u};
+            bool persistent_{false};
+            bool uncancellable_{false};
+            bool loading_slot_{false};
+            asset_loading_priority priority_{asset_loading_priority::background};
+            vector<asset_loading_token_iptr> tokens_;
         };
 
         template < typename Asset >
-        class typed_loading_asset : public loading_asset {
+        class typed_loading_asset final : public loading_asset {
         public:
             using ptr = intrusive_ptr<typed_loading_asset>;
             using promise_type = typename Asset::load_async_result;
         public:
-            typed_loading_asset(str_hash address, promise_type promise);
-            ~typed_loading_asset() noexcept override = default;
-
-            void cancel() noexcept override;
-            str_hash address() const noexcept override;
-            void wait(deferrer& deferrer) const noexcept override;
-
+            typed_loading_asset(
+                const library& library,
+                str main_address,
+                str_hash address,
+                u64 sequence);
+            ~typed_loading_asset() noexcept final = default;
+
+            void start() final;
+            void cancel() noexcept final;
+            void wait(deferrer& deferrer) const noexcept final;
+
+            const str& main_address() const noexcept;
             const promise_type& promise() const noexcept;
+
+            void resolve(const typename Asset::load_result& asset);
+            void reject(std::exception_ptr e);
         private:
-            str_hash address_;
+            const library& library_;
+            str main_address_;
             promise_type promise_;
         };
     }
@@ -67,6 +195,10 @@ namespace e2d
     //
     // library
     //
+    // Loads are looked up by asset type and address, so concurrent requests
+    // of the same asset share one load. The number of prefetch and background
+    // loads in flight is limited by library_parameters::max_queued_loads.
+    //
 
     class library final : public module<library> {
     public:
@@ -78,30 +210,81 @@ namespace e2d
 
         std::size_t unload_unused_assets() noexcept;
         std::size_t loading_asset_count() const noexcept;
+        std::size_t queued_asset_count() const noexcept;
+
+        // starts queued loads and drops the cancelled ones,
+        // called by the starter once per frame
+        void process_loading_queue() noexcept;
+
+        library& memory_budget(std::size_t value) noexcept;
+        std::size_t memory_budget() const noexcept;
+
+        // cached assets statistics by asset type name
+        flat_map<str, asset_cache_statistics> statistics() const;
+
+        // asset types that can be loaded by type name from manifests
+        template < typename Asset >
+        library& register_asset_type();
+
+        // requests all transitive dependencies of the address at once,
+        // dependencies of unregistered asset types are skipped
+        stdex::promise<asset_group> preload_async(
+            const manifest& manifest,
+            str_view address,
+            const asset_loading_request& request = asset_loading_request(),
+            const asset_loading_progress_iptr& progress = nullptr) const;
+
+        // records the persistent assets loaded in between,
+        // dependencies come before the assets they are loaded by
+        void start_recording_loads();
+        vector<manifest::dependency> stop_recording_loads();
 
         template < typename Asset >
-        typename Asset::load_result load_main_asset(str_view address) const;
+        typename Asset::load_result load_main_asset(
+            str_view address,
+            const asset_loading_request& request = asset_loading_request()) const;
 
         template < typename Asset >
-        typename Asset::load_async_result load_main_asset_async(str_view address) const;
+        typename Asset::load_async_result load_main_asset_async(
+            str_view address,
+            const asset_loading_request& request = asset_loading_request()) const;
 
         template < typename Asset, typename Nested = Asset >
-        typename Nested::load_result load_asset(str_view address) const;
+        typename Nested::load_result load_asset(
+            str_view address,
+            const asset_loading_request& request = asset_loading_request()) const;
 
         template < typename Asset, typename Nested = Asset >
-        typename Nested::load_async_result load_asset_async(str_view address) const;
+        typename Nested::load_async_result load_asset_async(
+            str_view address,
+            const asset_loading_request& request = asset_loading_request()) const;
     private:
         template < typename Asset >
-        vector<impl::loading_asset_iptr>::iterator
-        find_loading_asset_iter_(str_hash address) const noexcept;
+        friend class impl::typed_loading_asset;
 
         template < typename Asset >
         typename impl::typed_loading_asset<Asset>::ptr
         find_loading_asset_(str_hash address) const noexcept;
 
         template < typename Asset >
-        void remove_loading_asset_(str_hash address) const noexcept;
+        void complete_loading_asset_(
+            str_hash address,
+            const typename Asset::load_result& asset) const;
+
+        template < typename Asset >
+        void fail_loading_asset_(
+            str_hash address,
+            std::exception_ptr e) const;
 
+        template < typename Asset >
+        typename impl::typed_loading_asset<Asset>::ptr
+        remove_loading_asset_(str_hash address) const noexcept;
+
+        template < typename Asset >
+        static u64 loading_asset_key_(str_hash address) noexcept;
+
+        void start_loading_asset_(const impl::loading_asset_iptr& asset) const;
+        void process_loading_queue_() const noexcept;
         void wait_all_loading_assets_() noexcept;
     private:
         starter::library_parameters params_;
@@ -109,7 +292,15 @@ namespace e2d
     private:
         mutable asset_store store_;
         mutable std::recursive_mutex mutex_;
-        mutable vector<impl::loading_asset_iptr> loading_assets_;
+        mutable u64 loading_sequence_{0u};
+        mutable std::size_t started_queued_loads_{0u};
+        mutable vector<impl::loading_asset_iptr> loading_queue_;
+        mutable hash_map<u64, impl::loading_asset_iptr> loading_assets_;
+    private:
+        using asset_dependency_factory = impl::asset_dependency_iptr(*)(str_view);
+        hash_map<str_hash, asset_dependency_factory> asset_types_;
+        mutable bool recording_loads_{false};
+        mutable vector<manifest::dependency> recorded_loads_;
     };
 
     //
@@ -141,9 +332,6 @@ namespace e2d
 
     namespace impl
     {
-        class asset_dependency;
-        using asset_dependency_iptr = intrusive_ptr<asset_dependency>;
-
         class asset_dependency
             : private noncopyable
             , public ref_counter<asset_dependency> {
@@ -152,7 +340,9 @@ namespace e2d
             virtual ~asset_dependency() noexcept = default;
 
             virtual const str& main_address() const noexcept = 0;
-            virtual stdex::promise<asset_ptr> load_async(const library& library) = 0;
+            virtual stdex::promise<asset_ptr> load_async(
+                const library& library,
+                const asset_loading_request& request) = 0;
         };
 
         template < typename Asset >
@@ -165,7 +355,9 @@ namespace e2d
             ~typed_asset_dependency() noexcept override;
 
             const str& main_address() const noexcept override;
-            stdex::promise<asset_ptr> load_async(const library& library) override;
+            stdex::promise<asset_ptr> load_async(
+                const library& library,
+                const asset_loading_request& request) override;
         private:
             str main_address_;
         };
@@ -182,7 +374,14 @@ namespace e2d
 
         template < typename Asset, typename Nested = Asset >
         asset_dependencies& add_dependency(str_view address);
-        stdex::promise<asset_group> load_async(const library& library) const;
+        asset_dependencies& add_dependency(impl::asset_dependency_iptr dependency);
+
+        std::size_t dependency_count() const noexcept;
+
+        stdex::promise<asset_group> load_async(
+            const library& library,
+            const asset_loading_request& request = asset_loading_request(),
+            const asset_loading_progress_iptr& progress = nullptr) const;
     private:
         flat_multimap<str, impl::asset_dependency_iptr> dependencies_;
     };
@@ -10,6 +10,142 @@
 
 namespace e2d
 {
+    //
+    // asset_loading_token
+    //
+
+    inline void asset_loading_token::cancel() noexcept {
+        cancelled_.store(true);
+    }
+
+    inline bool asset_loading_token::cancelled() const noexcept {
+        return cancelled_.load();
+    }
+
+    //
+    // asset_loading_request
+    //
+
+    inline asset_loading_request::asset_loading_request(asset_cache_policy policy) noexcept
+    : policy_(policy) {}
+
+    inline asset_loading_request::asset_loading_request(asset_loading_priority priority) noexcept
+    : priority_(priority) {}
+
+    inline asset_loading_request& asset_loading_request::policy(asset_cache_policy value) noexcept {
+        policy_ = value;
+        return *this;
+    }
+
+    inline asset_loading_request& asset_loading_request::priority(asset_loading_priority value) noexcept {
+        priority_ = value;
+        return *this;
+    }
+
+    inline asset_loading_request& asset_loading_request::token(asset_loading_token_iptr value) noexcept {
+        token_ = std::move(value);
+        return *this;
+    }
+
+    inline asset_cache_policy asset_loading_request::policy() const noexcept {
+        return policy_;
+    }
+
+    inline asset_loading_priority asset_loading_request::priority() const noexcept {
+        return priority_;
+    }
+
+    inline const asset_loading_token_iptr& asset_loading_request::token() const noexcept {
+        return token_;
+    }
+
+    //
+    // asset_loading_progress
+    //
+
+    inline void asset_loading_progress::add_total(std::size_t count) noexcept {
+        total_.fetch_add(count);
+    }
+
+    inline void asset_loading_progress::add_finished(std::size_t count) noexcept {
+        finished_.fetch_add(count);
+    }
+
+    inline std::size_t asset_loading_progress::total() const noexcept {
+        return total_.load();
+    }
+
+    inline std::size_t asset_loading_progress::finished() const noexcept {
+        return finished_.load();
+    }
+
+    inline f32 asset_loading_progress::ratio() const noexcept {
+        const std::size_t t = total();
+        return t > 0u
+            ? math::clamp(static_cast<f32>(finished()) / static_cast<f32>(t), 0.f, 1.f)
+            : 1.f;
+    }
+
+    //
+    // loading_asset
+    //
+
+    namespace impl
+    {
+        inline loading_asset::loading_asset(u64 key, str_hash address, u64 sequence) noexcept
+        : key_(key)
+        , address_(address)
+        , sequence_(sequence) {}
+
+        inline void loading_asset::add_request(const asset_loading_request& request) {
+            if ( request.policy() == asset_cache_policy::persistent ) {
+                persistent_ = true;
+            }
+            priority_ = std::max(priority_, request.priority());
+            if ( request.token() ) {
+                tokens_.push_back(request.token());
+            } else {
+                uncancellable_ = true;
+            }
+        }
+
+        inline bool loading_asset::cancelled() const noexcept {
+            return !uncancellable_
+                && std::all_of(tokens_.begin(), tokens_.end(),
+                    [](const asset_loading_token_iptr& token) noexcept {
+                        return token->cancelled();
+                    });
+        }
+
+        inline void loading_asset::take_loading_slot() noexcept {
+            loading_slot_ = true;
+        }
+
+        inline bool loading_asset::has_loading_slot() const noexcept {
+            return loading_slot_;
+        }
+
+        inline u64 loading_asset::key() const noexcept {
+            return key_;
+        }
+
+        inline str_hash loading_asset::address() const noexcept {
+            return address_;
+        }
+
+        inline u64 loading_asset::sequence() const noexcept {
+            return sequence_;
+        }
+
+        inline bool loading_asset::persistent() const noexcept {
+            return persistent_;
+        }
+
+        inline asset_loading_priority loading_asset::priority() const noexcept {
+            return priority_;
+        }
+    }
+
     //
     // typed_loading_asset
     //
@@ -17,9 +153,49 @@ namespace e2d
     namespace impl
     {
         template < typename Asset >
-        typed_loading_asset<Asset>::typed_loading_asset(str_hash address, promise_type promise)
-        : address_(address)
-        , promise_(std::move(promise)) {}
+        typed_loading_asset<Asset>::typed_loading_asset(
+            const library& library,
+            str main_address,
+            str_hash address,
+            u64 sequence)
+        : loading_asset(library::loading_asset_key_<Asset>(address), address, sequence)
+        , library_(library)
+        , main_address_(std::move(main_address)) {}
+
+        template < typename Asset >
+        void typed_loading_asset<Asset>::start() {
+            Asset::load_async(library_, main_address_)
+            .then([
+                &library = library_,
+                main_address_hash = address()
+            ](const typename Asset::load_result& new_asset){
+                library.template complete_loading_asset_<Asset>(main_address_hash, new_asset);
+            }).except([
+                &library = library_,
+                main_address = main_address_,
+                main_address_hash = address()
+            ](std::exception_ptr e){
+                try {
+                    std::rethrow_exception(e);
+                } catch ( const std::exception& ee ) {
+                    the<debug>().error("LIBRARY: Failed to load asset:\n"
+                        "--> Asset: %0\n"
+                        "--> Address: %1\n"
+                        "--> Exception: %2",
+                        Asset::type_name(),
+                        main_address,
+                        ee.what());
+                } catch (...) {
+                    the<debug>().error("LIBRARY: Failed to load asset:\n"
+                        "--> Asset: %0\n"
+                        "--> Address: %1\n"
+                        "--> Exception: unexpected",
+                        Asset::type_name(),
+                        main_address);
+                }
+                library.template fail_loading_asset_<Asset>(main_address_hash, e);
+            });
+        }
 
         template < typename Asset >
         void typed_loading_asset<Asset>::cancel() noexcept {
@@ -27,8 +203,13 @@ namespace e2d
         }
 
         template < typename Asset >
-        str_hash typed_loading_asset<Asset>::address() const noexcept {
-            return address_;
+        void typed_loading_asset<Asset>::wait(deferrer& deferrer) const noexcept {
+            deferrer.active_safe_wait_promise(promise_);
+        }
+
+        template < typename Asset >
+        const str& typed_loading_asset<Asset>::main_address() const noexcept {
+            return main_address_;
         }
 
         template < typename Asset >
@@ -38,8 +219,13 @@ namespace e2d
         }
 
         template < typename Asset >
-        void typed_loading_asset<Asset>::wait(deferrer& deferrer) const noexcept {
-            deferrer.active_safe_wait_promise(promise_);
+        void typed_loading_asset<Asset>::resolve(const typename Asset::load_result& asset) {
+            promise_.resolve(asset);
+        }
+
+        template < typename Asset >
+        void typed_loading_asset<Asset>::reject(std::exception_ptr e) {
+            promise_.reject(e);
         }
     }
 
@@ -48,7 +234,9 @@ namespace e2d
     //
 
     inline library::library(starter::library_parameters params)
-    : params_(std::move(params)) {}
+    : params_(std::move(params)) {
+        store_.memory_budget(params_.memory_budget());
+    }
 
     inline library::~library() noexcept {
         cancelled_.store(true);
@@ -64,6 +252,7 @@ namespace e2d
     }
 
     inline std::size_t library::unload_unused_assets() noexcept {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
         return store_.unload_unused_assets();
     }
 
@@ -72,21 +261,101 @@ namespace e2d
         return loading_assets_.size();
     }
 
+    inline std::size_t library::queued_asset_count() const noexcept {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        return loading_queue_.size();
+    }
+
+    inline void library::process_loading_queue() noexcept {
+        process_loading_queue_();
+    }
+
+    inline library& library::memory_budget(std::size_t value) noexcept {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        store_.memory_budget(value);
+        return *this;
+    }
+
+    inline std::size_t library::memory_budget() const noexcept {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        return store_.memory_budget();
+    }
+
+    inline flat_map<str, asset_cache_statistics> library::statistics() const {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        return store_.statistics();
+    }
+
     template < typename Asset >
-    typename Asset::load_result library::load_main_asset(str_view address) const {
-        auto p = load_main_asset_async<Asset>(address);
+    library& library::register_asset_type() {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        asset_types_[make_hash(Asset::type_name())] = [](str_view address){
+            return impl::asset_dependency_iptr(
+                make_intrusive<impl::typed_asset_dependency<Asset>>(address));
+        };
+        return *this;
+    }
+
+    inline stdex::promise<asset_group> library::preload_async(
+        const manifest& manifest,
+        str_view address,
+        const asset_loading_request& request,
+        const asset_loading_progress_iptr& progress) const
+    {
+        asset_dependencies dependencies;
+        if ( const auto* list = manifest.find_dependencies(address) ) {
+            std::lock_guard<std::recursive_mutex> guard(mutex_);
+            for ( const manifest::dependency& d : *list ) {
+                const auto iter = asset_types_.find(make_hash(d.type));
+                if ( iter == asset_types_.end() ) {
+                    the<debug>().warning("LIBRARY: Unknown asset type in manifest:\n"
+                        "--> Type: %0\n"
+                        "--> Address: %1",
+                        d.type,
+                        d.address);
+                    continue;
+                }
+                dependencies.add_dependency(iter->second(d.address));
+            }
+        }
+        return dependencies.load_async(*this, request, progress);
+    }
+
+    inline void library::start_recording_loads() {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        recorded_loads_.clear();
+        recording_loads_ = true;
+    }
+
+    inline vector<manifest::dependency> library::stop_recording_loads() {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        recording_loads_ = false;
+        vector<manifest::dependency> result;
+        result.swap(recorded_loads_);
+        return result;
+    }
+
+    template < typename Asset >
+    typename Asset::load_result library::load_main_asset(
+        str_view address,
+        const asset_loading_request& request) const
+    {
+        auto p = load_main_asset_async<Asset>(address, request);
         the<deferrer>().active_safe_wait_promise(p);
         return p.get_or_default(nullptr);
     }
 
     template < typename Asset >
-    typename Asset::load_async_result library::load_main_asset_async(str_view address) const {
-        const str main_address = address::parent(address);
+    typename Asset::load_async_result library::load_main_asset_async(
+        str_view address,
+        const asset_loading_request& request) const
+    {
+        str main_address = address::parent(address);
         const str_hash main_address_hash = make_hash(main_address);
 
         std::lock_guard<std::recursive_mutex> guard(mutex_);
 
-        if ( cancelled_ ) {
+        if ( cancelled_ || (request.token() && request.token()->cancelled()) ) {
             return stdex::make_rejected_promise<typename Asset::load_result>(library_cancelled_exception());
         }
 
@@ -94,67 +363,56 @@ namespace e2d
             return stdex::make_resolved_promise(std::move(stored_asset));
         }
 
-        if ( auto asset = find_loading_asset_<Asset>(main_address_hash) )  {
+        if ( auto asset = find_loading_asset_<Asset>(main_address_hash) ) {
+            asset->add_request(request);
+            if ( asset->priority() == asset_loading_priority::visible ) {
+                const auto iter = std::find_if(
+                    loading_queue_.begin(), loading_queue_.end(),
+                    [&asset](const impl::loading_asset_iptr& queued) noexcept {
+                        return queued.get() == asset.get();
+                    });
+                if ( iter != loading_queue_.end() ) {
+                    loading_queue_.erase(iter);
+                    start_loading_asset_(asset);
+                }
+            }
             return asset->promise();
         }
 
-        auto p = Asset::load_async(*this, main_address)
-        .then([
-            this,
-            main_address_hash
-        ](const typename Asset::load_result& new_asset){
-            std::lock_guard<std::recursive_mutex> guard(mutex_);
-            store_.store<Asset>(main_address_hash, new_asset);
-            remove_loading_asset_<Asset>(main_address_hash);
-            return new_asset;
-        }).except([
-            this,
-            main_address,
-            main_address_hash
-        ](std::exception_ptr e) -> typename Asset::load_result {
-            {
-                std::lock_guard<std::recursive_mutex> guard(mutex_);
-                remove_loading_asset_<Asset>(main_address_hash);
-            }
-            try {
-                std::rethrow_exception(e);
-            } catch ( const std::exception& ee ) {
-                the<debug>().error("LIBRARY: Failed to load asset:\n"
-                    "--> Asset: %0\n"
-                    "--> Address: %1\n"
-                    "--> Exception: %2",
-                    Asset::type_name(),
-                    main_address,
-                    ee.what());
-            } catch (...) {
-                the<debug>().error("LIBRARY: Failed to load asset:\n"
-                    "--> Asset: %0\n"
-                    "--> Address: %1\n"
-                    "--> Exception: unexpected",
-                    Asset::type_name(),
-                    main_address);
-            }
-            std::rethrow_exception(e);
-        });
-
-        const auto zero_us = time::to_chrono(make_microseconds(0));
-        if ( p.wait_for(zero_us) == stdex::promise_wait_status::timeout ) {
-            loading_assets_.push_back(new impl::typed_loading_asset<Asset>(main_address_hash, p));
+        auto asset = make_intrusive<impl::typed_loading_asset<Asset>>(
+            *this,
+            std::move(main_address),
+            main_address_hash,
+            ++loading_sequence_);
+        asset->add_request(request);
+        loading_assets_.emplace(asset->key(), asset);
+
+        if ( asset->priority() == asset_loading_priority::visible ) {
+            start_loading_asset_(asset);
+        } else {
+            loading_queue_.push_back(asset);
+            process_loading_queue_();
         }
 
-        return p;
+        return asset->promise();
     }
 
     template < typename Asset, typename Nested >
-    typename Nested::load_result library::load_asset(str_view address) const {
-        auto p = load_asset_async<Asset, Nested>(address);
+    typename Nested::load_result library::load_asset(
+        str_view address,
+        const asset_loading_request& request) const
+    {
+        auto p = load_asset_async<Asset, Nested>(address, request);
         the<deferrer>().active_safe_wait_promise(p);
         return p.get_or_default(nullptr);
     }
 
     template < typename Asset, typename Nested >
-    typename Nested::load_async_result library::load_asset_async(str_view address) const {
-        return load_main_asset_async<Asset>(address)
+    typename Nested::load_async_result library::load_asset_async(
+        str_view address,
+        const asset_loading_request& request) const
+    {
+        return load_main_asset_async<Asset>(address, request)
         .then([
             address = str(address),
             nested_address = address::nested(address)
@@ -176,41 +434,150 @@ namespace e2d
         });
     }
 
-    template < typename Asset >
-    vector<impl::loading_asset_iptr>::iterator
-    library::find_loading_asset_iter_(str_hash address) const noexcept {
-        return std::find_if(
-            loading_assets_.begin(), loading_assets_.end(),
-            [address](const impl::loading_asset_iptr& asset) noexcept {
-                return asset->address() == address
-                    && dynamic_pointer_cast<impl::typed_loading_asset<Asset>>(asset);
-            });
-    }
-
     template < typename Asset >
     typename impl::typed_loading_asset<Asset>::ptr
     library::find_loading_asset_(str_hash address) const noexcept {
-        auto iter = find_loading_asset_iter_<Asset>(address);
+        const auto iter = loading_assets_.find(loading_asset_key_<Asset>(address));
         return iter != loading_assets_.end()
-            ? static_pointer_cast<impl::typed_loading_asset<Asset>>(*iter)
+            ? static_pointer_cast<impl::typed_loading_asset<Asset>>(iter->second)
             : nullptr;
     }
 
     template < typename Asset >
-    void library::remove_loading_asset_(str_hash address) const noexcept {
-        auto iter = find_loading_asset_iter_<Asset>(address);
-        if ( iter != loading_assets_.end() ) {
-            loading_assets_.erase(iter);
+    void library::complete_loading_asset_(
+        str_hash address,
+        const typename Asset::load_result& asset) const
+    {
+        typename impl::typed_loading_asset<Asset>::ptr loading;
+        {
+            std::lock_guard<std::recursive_mutex> guard(mutex_);
+            loading = find_loading_asset_<Asset>(address);
+            if ( loading && loading->persistent() ) {
+                store_.store<Asset>(address, asset);
+                if ( recording_loads_ ) {
+                    recorded_loads_.push_back({Asset::type_name(), loading->main_address()});
+                }
+            }
+            remove_loading_asset_<Asset>(address);
+        }
+        if ( loading ) {
+            loading->resolve(asset);
+        }
+        process_loading_queue_();
+    }
+
+    template < typename Asset >
+    void library::fail_loading_asset_(
+        str_hash address,
+        std::exception_ptr e) const
+    {
+        const auto loading = remove_loading_asset_<Asset>(address);
+        if ( loading ) {
+            loading->reject(e);
+        }
+        process_loading_queue_();
+    }
+
+    template < typename Asset >
+    typename impl::typed_loading_asset<Asset>::ptr
+    library::remove_loading_asset_(str_hash address) const noexcept {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        const auto iter = loading_assets_.find(loading_asset_key_<Asset>(address));
+        if ( iter == loading_assets_.end() ) {
+            return nullptr;
+        }
+        const auto loading = static_pointer_cast<impl::typed_loading_asset<Asset>>(iter->second);
+        if ( loading->has_loading_slot() ) {
+            --started_queued_loads_;
+        }
+        loading_assets_.erase(iter);
+        return loading;
+    }
+
+    template < typename Asset >
+    u64 library::loading_asset_key_(str_hash address) noexcept {
+        return (u64(utils::type_family<Asset>::id()) << 32u) | address.hash();
+    }
+
+    inline void library::start_loading_asset_(const impl::loading_asset_iptr& asset) const {
+        try {
+            asset->start();
+        } catch (...) {
+            std::lock_guard<std::recursive_mutex> guard(mutex_);
+            if ( loading_assets_.erase(asset->key()) && asset->has_loading_slot() ) {
+                --started_queued_loads_;
+            }
+            throw;
+        }
+    }
+
+    inline void library::process_loading_queue_() const noexcept {
+        vector<impl::loading_asset_iptr> cancelled_assets;
+        {
+            std::lock_guard<std::recursive_mutex> guard(mutex_);
+            try {
+                for ( auto iter = loading_queue_.begin(); iter != loading_queue_.end(); ) {
+                    if ( !(*iter)->cancelled() ) {
+                        ++iter;
+                        continue;
+                    }
+                    const auto asset = *iter;
+                    iter = loading_queue_.erase(iter);
+                    loading_assets_.erase(asset->key());
+                    cancelled_assets.push_back(asset);
+                }
+
+                // visible requests never wait in the queue, so there is
+                // always a free slot for the dependencies of queued loads
+                const std::size_t max_queued_loads = math::max(
+                    std::size_t(1u),
+                    params_.max_queued_loads());
+
+                while ( !loading_queue_.empty() && started_queued_loads_ < max_queued_loads ) {
+                    const auto iter = std::min_element(
+                        loading_queue_.begin(), loading_queue_.end(),
+                        [](const impl::loading_asset_iptr& l, const impl::loading_asset_iptr& r) noexcept {
+                            return l->priority() != r->priority()
+                                ? l->priority() > r->priority()
+                                : l->sequence() < r->sequence();
+                        });
+                    const auto asset = *iter;
+                    loading_queue_.erase(iter);
+                    asset->take_loading_slot();
+                    ++started_queued_loads_;
+                    try {
+                        start_loading_asset_(asset);
+                    } catch (...) {
+                        asset->cancel();
+                    }
+                }
+            } catch (...) {
+                // nothing
+            }
+        }
+        for ( const auto& asset : cancelled_assets ) {
+            asset->cancel();
         }
     }
 
     inline void library::wait_all_loading_assets_() noexcept {
+        vector<impl::loading_asset_iptr> queued_assets;
+        {
+            std::lock_guard<std::recursive_mutex> guard(mutex_);
+            queued_assets.swap(loading_queue_);
+            for ( const auto& asset : queued_assets ) {
+                loading_assets_.erase(asset->key());
+            }
+        }
+        for ( const auto& asset : queued_assets ) {
+            asset->cancel();
+        }
         while ( true ) {
             std::unique_lock<std::recursive_mutex> lock(mutex_);
             if ( loading_assets_.empty() ) {
                 break;
             }
-            const auto loading_asset_copy = loading_assets_.back();
+            const auto loading_asset_copy = loading_assets_.begin()->second;
             lock.unlock();
             loading_asset_copy->wait(the<deferrer>());
         }
@@ -279,8 +646,11 @@ namespace e2d
         }
 
         template < typename Asset >
-        stdex::promise<asset_ptr> typed_asset_dependency<Asset>::load_async(const library& library) {
-            return library.load_main_asset_async<Asset>(main_address_)
+        stdex::promise<asset_ptr> typed_asset_dependency<Asset>::load_async(
+            const library& library,
+            const asset_loading_request& request)
+        {
+            return library.load_main_asset_async<Asset>(main_address_, request)
             .then([](const typename Asset::load_result& main_asset){
                 return asset_ptr(main_asset);
             });
@@ -299,13 +669,34 @@ namespace e2d
         return *this;
     }
 
-    inline stdex::promise<asset_group> asset_dependencies::load_async(const library& library) const {
+    inline asset_dependencies& asset_dependencies::add_dependency(impl::asset_dependency_iptr dependency) {
+        str main_address = dependency->main_address();
+        dependencies_.emplace(std::move(main_address), std::move(dependency));
+        return *this;
+    }
+
+    inline std::size_t asset_dependencies::dependency_count() const noexcept {
+        return dependencies_.size();
+    }
+
+    inline stdex::promise<asset_group> asset_dependencies::load_async(
+        const library& library,
+        const asset_loading_request& request,
+        const asset_loading_progress_iptr& progress) const
+    {
+        if ( progress ) {
+            progress->add_total(dependencies_.size());
+        }
         vector<stdex::promise<std::pair<str, asset_ptr>>> promises;
         promises.reserve(dependencies_.size());
         for ( const auto& dp : dependencies_ ) {
-            promises.push_back(dp.second->load_async(library).then([
-                dep = dp.second
+            promises.push_back(dp.second->load_async(library, request).then([
+                dep = dp.second,
+                progress
             ](const asset_ptr& asset){
+                if ( progress ) {
+                    progress->add_finished(1u);
+                }
                 return std::make_pair(dep->main_address(), asset);
             }));
         }
@@ -25,6 +25,7 @@ namespace e2d
     class node
         : private noncopyable
         , public ref_counter<node>
+        , public pooled_object<node>
         , public intrusive_list_hook<node_children_ilist_tag> {
     public:
         virtual ~node() noexcept;
@@ -59,6 +60,14 @@ namespace e2d
         const m4f& local_matrix() const noexcept;
         const m4f& world_matrix() const noexcept;
 
+        // updates the world matrices of this node and its dirty descendants,
+        // top-down and once per node; intended to be called for scene roots
+        void update_world_matrix_recursive() const noexcept;
+
+        // changes every time the world matrix is recalculated,
+        // versions are never shared between nodes
+        u32 world_version() const noexcept;
+
         v4f local_to_world(const v4f& local) const noexcept;
         v4f world_to_local(const v4f& world) const noexcept;
 
@@ -153,11 +162,14 @@ namespace e2d
         enum flag_masks : u32 {
             fm_dirty_local_matrix = 1u << 0,
             fm_dirty_world_matrix = 1u << 1,
+            fm_dirty_subtree = 1u << 2,
         };
         void mark_dirty_local_matrix_() noexcept;
         void mark_dirty_world_matrix_() noexcept;
         void update_local_matrix_() const noexcept;
         void update_world_matrix_() const noexcept;
+        bool update_own_world_matrix_() const noexcept;
+        void update_children_world_matrices_() const noexcept;
     private:
         t2f transform_;
         gobject owner_;
@@ -165,6 +177,8 @@ namespace e2d
         node_children children_;
     private:
         mutable u32 flags_{0u};
+        mutable u32 world_version_{0u};
+        mutable u32 parent_world_version_{0u};
         mutable m4f local_matrix_;
         mutable m4f world_matrix_;
     };
@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "../_high.hpp"
+
+namespace e2d
+{
+    //
+    // manifest
+    //
+    // Maps asset addresses to their full transitive dependency lists,
+    // so all of them can be requested at once instead of one by one
+    // as the asset descriptions are parsed.
+    //
+
+    class manifest final {
+    public:
+        struct dependency {
+            str type;
+            str address;
+        };
+    public:
+        manifest() = default;
+        ~manifest() noexcept = default;
+
+        manifest(manifest&& other) noexcept;
+        manifest& operator=(manifest&& other) noexcept;
+
+        manifest(const manifest& other);
+        manifest& operator=(const manifest& other);
+
+        void clear() noexcept;
+        void swap(manifest& other) noexcept;
+
+        manifest& assign(manifest&& other) noexcept;
+        manifest& assign(const manifest& other);
+
+        manifest& add_dependency(str_view address, str_view type, str_view dependency);
+        manifest& set_dependencies(str_view address, vector<dependency> dependencies);
+
+        const vector<dependency>* find_dependencies(str_view address) const noexcept;
+        const flat_map<str, vector<dependency>>& dependencies() const noexcept;
+    private:
+        flat_map<str, vector<dependency>> dependencies_;
+    };
+
+    void swap(manifest& l, manifest& r) noexcept;
+    bool operator==(const manifest& l, const manifest& r) noexcept;
+    bool operator!=(const manifest& l, const manifest& r) noexcept;
+
+    bool operator==(const manifest::dependency& l, const manifest::dependency& r) noexcept;
+    bool operator!=(const manifest::dependency& l, const manifest::dependency& r) noexcept;
+}
+
+namespace e2d::manifests
+{
+    // writes the manifest in the format read by manifest_asset
+    bool try_save_manifest(
+        const manifest& src,
+        const output_stream_uptr& dst) noexcept;
+}
@@ -54,3 +54,48 @@ namespace e2d
     bool operator==(const prefab& l, const prefab& r) = delete;
     bool operator!=(const prefab& l, const prefab& r) = delete;
 }
+
+namespace e2d
+{
+    //
+    // flat_prefab
+    //
+    // Prefab hierarchy compiled into contiguous arrays in depth-first order:
+    // the root is always at index zero and every parent index is less than
+    // the index of its child. An empty flat prefab is instantiated as
+    // a single entity without components, like an empty prefab.
+    //
+
+    class flat_prefab final {
+    public:
+        static constexpr std::size_t no_parent = std::size_t(-1);
+    public:
+        flat_prefab() = default;
+        ~flat_prefab() noexcept = default;
+
+        explicit flat_prefab(const prefab& prefab);
+
+        flat_prefab(flat_prefab&& other) noexcept;
+        flat_prefab& operator=(flat_prefab&& other) noexcept;
+
+        flat_prefab(const flat_prefab& other);
+        flat_prefab& operator=(const flat_prefab& other);
+
+        void clear() noexcept;
+        void swap(flat_prefab& other) noexcept;
+
+        flat_prefab& assign(flat_prefab&& other) noexcept;
+        flat_prefab& assign(const flat_prefab& other);
+        flat_prefab& assign(const prefab& prefab);
+
+        bool empty() const noexcept;
+        std::size_t size() const noexcept;
+        std::size_t parent(std::size_t index) const noexcept;
+        const ecs::prototype& prototype(std::size_t index) const noexcept;
+    private:
+        vector<std::size_t> parents_;
+        vector<ecs::prototype> prototypes_;
+    };
+
+    void swap(flat_prefab& l, flat_prefab& r) noexcept;
+}
@@ -50,8 +50,16 @@ namespace e2d
     public:
         library_parameters& root(url value) noexcept;
         const url& root() const noexcept;
+
+        library_parameters& memory_budget(std::size_t value) noexcept;
+        std::size_t memory_budget() const noexcept;
+
+        library_parameters& max_queued_loads(std::size_t value) noexcept;
+        std::size_t max_queued_loads() const noexcept;
     private:
         url root_{"resources://bin/library"};
+        std::size_t memory_budget_{std::numeric_limits<std::size_t>::max()};
+        std::size_t max_queued_loads_{4u};
     };
 
     //
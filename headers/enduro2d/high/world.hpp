@@ -15,6 +15,12 @@
 
 namespace e2d
 {
+    class world_cancelled_exception : public exception {
+        const char* what() const noexcept override {
+            return "world cancelled exception";
+        }
+    };
+
     class world final : public module<world> {
     public:
         world() = default;
@@ -35,10 +41,36 @@ namespace e2d
         gobject instantiate(const prefab& prefab, const node_iptr& parent);
         gobject instantiate(const prefab& prefab, const node_iptr& parent, const t2f& transform);
 
+        vector<gobject> instantiate_batch(const flat_prefab& prefab, std::size_t count);
+        vector<gobject> instantiate_batch(const flat_prefab& prefab, const vector<t2f>& transforms);
+
+        vector<gobject> instantiate_batch(const flat_prefab& prefab, std::size_t count, const node_iptr& parent);
+        vector<gobject> instantiate_batch(const flat_prefab& prefab, const vector<t2f>& transforms, const node_iptr& parent);
+
+        stdex::promise<vector<gobject>> instantiate_batch_async(flat_prefab prefab, std::size_t count);
+        stdex::promise<vector<gobject>> instantiate_batch_async(flat_prefab prefab, vector<t2f> transforms);
+
+        stdex::promise<vector<gobject>> instantiate_batch_async(flat_prefab prefab, std::size_t count, node_iptr parent);
+        stdex::promise<vector<gobject>> instantiate_batch_async(flat_prefab prefab, vector<t2f> transforms, node_iptr parent);
+
+        world& async_instances_budget(microseconds<u64> budget) noexcept;
+        [[nodiscard]] microseconds<u64> async_instances_budget() const noexcept;
+
+        void process_async_instances();
+        void cancel_async_instances() noexcept;
+
         void destroy_instance(gobject inst) noexcept;
         void finalize_instances() noexcept;
+
+        static object_pool::statistics state_pool_statistics() noexcept;
+        static object_pool::statistics node_pool_statistics() noexcept;
+    private:
+        class async_batch;
+        using async_batch_uptr = std::unique_ptr<async_batch>;
     private:
         ecs::registry registry_;
         gobject::destroying_states destroying_states_;
+        vector<async_batch_uptr> async_batches_;
+        microseconds<u64> async_instances_budget_{make_microseconds<u64>(2000u)};
     };
 }
@@ -22,6 +22,8 @@
 #include "json_utils.hpp"
 #include "mesh.hpp"
 #include "module.hpp"
+#include "object_pool.hpp"
+#include "pack.hpp"
 #include "path.hpp"
 #include "shape.hpp"
 #include "streams.hpp"
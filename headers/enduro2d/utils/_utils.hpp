@@ -158,6 +158,127 @@ namespace e2d::utils
         return impl::sdbm_hash_impl(init, first, last);
     }
 
+    //
+    // xx_hash32
+    //
+
+    namespace impl
+    {
+        // Inspired by:
+        // https://github.com/Cyan4973/xxHash
+
+        constexpr u32 xx_hash32_prime1 = 0x9E3779B1u;
+        constexpr u32 xx_hash32_prime2 = 0x85EBCA77u;
+        constexpr u32 xx_hash32_prime3 = 0xC2B2AE3Du;
+        constexpr u32 xx_hash32_prime4 = 0x27D4EB2Fu;
+        constexpr u32 xx_hash32_prime5 = 0x165667B1u;
+
+        // narrow strings are read by four characters per word,
+        // wide characters are read as whole words
+        template < typename Char >
+        constexpr std::size_t xx_hash32_word_size = sizeof(Char) == 1u ? 4u : 1u;
+
+        constexpr u32 xx_hash32_rotl(u32 v, u32 r) noexcept {
+            return (v << r) | (v >> (32u - r));
+        }
+
+        constexpr u32 xx_hash32_round(u32 acc, u32 word) noexcept {
+            acc += word * xx_hash32_prime2;
+            acc = xx_hash32_rotl(acc, 13u);
+            return acc * xx_hash32_prime1;
+        }
+
+        template < typename Char >
+        constexpr u32 xx_hash32_unit(Char c) noexcept {
+            return static_cast<u32>(static_cast<std::make_unsigned_t<Char>>(c));
+        }
+
+        template < typename Char >
+        constexpr u32 xx_hash32_word(const Char* p) noexcept {
+            if constexpr ( xx_hash32_word_size<Char> == 4u ) {
+                // compilers fold it to a single unaligned load
+                return xx_hash32_unit(p[0])
+                    | (xx_hash32_unit(p[1]) << 8u)
+                    | (xx_hash32_unit(p[2]) << 16u)
+                    | (xx_hash32_unit(p[3]) << 24u);
+            } else {
+                return xx_hash32_unit(p[0]);
+            }
+        }
+
+        template < typename Char >
+        constexpr u32 xx_hash32_impl(u32 seed, const Char* str, std::size_t size) noexcept {
+            constexpr std::size_t word_size = xx_hash32_word_size<Char>;
+            constexpr std::size_t stripe_size = word_size * 4u;
+
+            const Char* first = str;
+            const Char* const last = str + size;
+
+            u32 hash = 0u;
+            if ( size >= stripe_size ) {
+                // four independent lanes per stripe
+                u32 v1 = seed + xx_hash32_prime1 + xx_hash32_prime2;
+                u32 v2 = seed + xx_hash32_prime2;
+                u32 v3 = seed;
+                u32 v4 = seed - xx_hash32_prime1;
+                const Char* const limit = last - stripe_size;
+                do {
+                    v1 = xx_hash32_round(v1, xx_hash32_word(first));
+                    v2 = xx_hash32_round(v2, xx_hash32_word(first + word_size));
+                    v3 = xx_hash32_round(v3, xx_hash32_word(first + word_size * 2u));
+                    v4 = xx_hash32_round(v4, xx_hash32_word(first + word_size * 3u));
+                    first += stripe_size;
+                } while ( first <= limit );
+                hash = xx_hash32_rotl(v1, 1u)
+                    + xx_hash32_rotl(v2, 7u)
+                    + xx_hash32_rotl(v3, 12u)
+                    + xx_hash32_rotl(v4, 18u);
+            } else {
+                hash = seed + xx_hash32_prime5;
+            }
+
+            hash += static_cast<u32>(size);
+
+            while ( static_cast<std::size_t>(last - first) >= word_size ) {
+                hash += xx_hash32_word(first) * xx_hash32_prime3;
+                hash = xx_hash32_rotl(hash, 17u) * xx_hash32_prime4;
+                first += word_size;
+            }
+
+            while ( first != last ) {
+                hash += xx_hash32_unit(*first++) * xx_hash32_prime5;
+                hash = xx_hash32_rotl(hash, 11u) * xx_hash32_prime1;
+            }
+
+            hash ^= hash >> 15u;
+            hash *= xx_hash32_prime2;
+            hash ^= hash >> 13u;
+            hash *= xx_hash32_prime3;
+            hash ^= hash >> 16u;
+            return hash;
+        }
+    }
+
+    template < typename Char >
+    constexpr u32 xx_hash32(const Char* str, std::size_t size) noexcept {
+        return impl::xx_hash32_impl(0u, str, size);
+    }
+
+    template < typename Char, typename Traits >
+    constexpr u32 xx_hash32(basic_string_view<Char, Traits> str) noexcept {
+        return impl::xx_hash32_impl(0u, str.data(), str.size());
+    }
+
+    template < typename Char >
+    constexpr u32 xx_hash32(u32 seed, const Char* str, std::size_t size) noexcept {
+        return impl::xx_hash32_impl(seed, str, size);
+    }
+
+    template < typename Char, typename Traits >
+    constexpr u32 xx_hash32(u32 seed, basic_string_view<Char, Traits> str) noexcept {
+        return impl::xx_hash32_impl(seed, str.data(), str.size());
+    }
+
     //
     // hash_combine
     //
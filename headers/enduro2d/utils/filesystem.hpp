@@ -29,12 +29,24 @@ namespace e2d
     public:
         virtual const str& path() const noexcept = 0;
     };
+
+    class mapped_file;
+    using mapped_file_uptr = std::unique_ptr<mapped_file>;
+    using mapped_file_sptr = std::shared_ptr<mapped_file>;
+
+    class mapped_file : private noncopyable {
+    public:
+        virtual ~mapped_file() noexcept = default;
+        virtual buffer_view content() const noexcept = 0;
+        virtual const str& path() const noexcept = 0;
+    };
 }
 
 namespace e2d
 {
     read_file_uptr make_read_file(str_view path) noexcept;
     write_file_uptr make_write_file(str_view path, bool append) noexcept;
+    mapped_file_uptr make_mapped_file(str_view path) noexcept;
 }
 
 namespace e2d::filesystem
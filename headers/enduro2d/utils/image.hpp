@@ -55,6 +55,17 @@ namespace e2d
         (rgba_pvrtc4_v2))
     ENUM_HPP_REGISTER_TRAITS(image_data_format)
 
+    ENUM_HPP_CLASS_DECL(image_mipmap_filter, u8,
+        (box)
+        (kaiser))
+    ENUM_HPP_REGISTER_TRAITS(image_mipmap_filter)
+
+    ENUM_HPP_CLASS_DECL(image_compression_quality, u8,
+        (fast)
+        (normal)
+        (best))
+    ENUM_HPP_REGISTER_TRAITS(image_compression_quality)
+
     class bad_image_access final : public exception {
     public:
         const char* what() const noexcept final {
@@ -72,14 +83,15 @@ namespace e2d
         image(const image& other);
         image& operator=(const image& other);
 
-        image(const v2u& size, image_data_format format, buffer&& data) noexcept;
-        image(const v2u& size, image_data_format format, const buffer& data);
+        // data holds the mipmap chain, the largest level goes first
+        image(const v2u& size, image_data_format format, buffer&& data, u32 mipmap_count = 1u) noexcept;
+        image(const v2u& size, image_data_format format, const buffer& data, u32 mipmap_count = 1u);
 
         image& assign(image&& other) noexcept;
         image& assign(const image& other);
 
-        image& assign(const v2u& size, image_data_format format, buffer&& data) noexcept;
-        image& assign(const v2u& size, image_data_format format, const buffer& data);
+        image& assign(const v2u& size, image_data_format format, buffer&& data, u32 mipmap_count = 1u) noexcept;
+        image& assign(const v2u& size, image_data_format format, const buffer& data, u32 mipmap_count = 1u);
 
         void swap(image& other) noexcept;
         void clear() noexcept;
@@ -91,10 +103,15 @@ namespace e2d
         const v2u& size() const noexcept;
         image_data_format format() const noexcept;
         const buffer& data() const noexcept;
+
+        u32 mipmap_count() const noexcept;
+        v2u mipmap_size(u32 level) const noexcept;
+        buffer_view mipmap_data(u32 level) const noexcept;
     private:
         buffer data_;
         v2u size_;
         image_data_format format_ = image_data_format::rgba8;
+        u32 mipmap_count_ = 0u;
     };
 
     void swap(image& l, image& r) noexcept;
@@ -125,4 +142,40 @@ namespace e2d::images
     bool check_save_image_support(
         const image& src,
         image_file_format format) noexcept;
+
+    bool is_compressed_format(
+        image_data_format format) noexcept;
+
+    std::size_t data_size_for_dimension(
+        image_data_format format,
+        const v2u& size) noexcept;
+
+    // the sum of the level sizes of the mipmap chain
+    std::size_t data_size_for_mipmaps(
+        image_data_format format,
+        const v2u& size,
+        u32 mipmap_count) noexcept;
+
+    // levels down to 1x1, each level is half of the previous one
+    u32 max_mipmap_count(const v2u& size) noexcept;
+    v2u mipmap_size(const v2u& size, u32 level) noexcept;
+
+    // replaces the levels below the largest one with downsampled ones,
+    // compressed images can't be downsampled
+    bool try_generate_mipmaps(
+        image& dst,
+        const image& src,
+        image_mipmap_filter filter) noexcept;
+
+    // encodes every mipmap level of an uncompressed image into
+    // rgba_dxt1/3/5, rgb_etc1/2 or rgba_etc2 blocks, dst can be src
+    bool try_compress(
+        image& dst,
+        const image& src,
+        image_data_format format,
+        image_compression_quality quality = image_compression_quality::normal) noexcept;
+
+    bool check_compress_support(
+        const image& src,
+        image_data_format format) noexcept;
 }
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "_utils.hpp"
+
+namespace e2d
+{
+    //
+    // object_pool
+    //
+    // Thread-safe free-list allocator of fixed-size blocks. Memory is
+    // reserved in chunks and returned to the system only on destruction.
+    //
+
+    class object_pool final : private noncopyable {
+    public:
+        struct statistics {
+            std::size_t live_count{0u};
+            std::size_t peak_count{0u};
+            std::size_t reserved_bytes{0u};
+        };
+    public:
+        object_pool(
+            std::size_t block_size,
+            std::size_t block_align,
+            std::size_t chunk_block_count = 256u);
+        ~object_pool() noexcept;
+
+        [[nodiscard]] void* allocate();
+        void deallocate(void* block) noexcept;
+
+        // makes sure the next 'count' allocations don't allocate chunks,
+        // missing blocks are allocated as one chunk
+        void reserve(std::size_t count);
+
+        [[nodiscard]] std::size_t block_size() const noexcept;
+        [[nodiscard]] statistics stats() const noexcept;
+    private:
+        struct free_block {
+            free_block* next{nullptr};
+        };
+        void add_chunk_(std::size_t block_count);
+    private:
+        std::size_t block_size_{0u};
+        std::size_t chunk_block_count_{0u};
+        mutable std::mutex mutex_;
+        vector<std::unique_ptr<u8[]>> chunks_;
+        free_block* free_blocks_{nullptr};
+        std::size_t free_count_{0u};
+        statistics stats_;
+    };
+
+    //
+    // pooled_object
+    //
+    // Routes new/delete of T through a per-type object_pool. Derived types
+    // of a different size fall back to the global allocator.
+    //
+
+    template < typename T >
+    class pooled_object {
+    public:
+        static void* operator new(std::size_t size) {
+            return size == pool().block_size()
+                ? pool().allocate()
+                : ::operator new(size);
+        }
+
+        static void operator delete(void* block, std::size_t size) noexcept {
+            if ( size == pool().block_size() ) {
+                pool().deallocate(block);
+            } else {
+                ::operator delete(block);
+            }
+        }
+
+        static object_pool::statistics pool_statistics() noexcept {
+            return pool().stats();
+        }
+
+        static void reserve_pool(std::size_t count) {
+            pool().reserve(count);
+        }
+    private:
+        static object_pool& pool() {
+            static object_pool pool(sizeof(T), alignof(T));
+            return pool;
+        }
+    };
+}
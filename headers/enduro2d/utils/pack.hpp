@@ -0,0 +1,132 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "_utils.hpp"
+
+#include "buffer.hpp"
+#include "buffer_view.hpp"
+#include "streams.hpp"
+
+namespace e2d
+{
+    //
+    // pack
+    //
+    // Table of contents of an e2d pack file. Entry data starts at
+    // pack::alignment boundaries, so stored entries can be mapped as is.
+    // Compressed entries are split into independent chunks of
+    // pack::chunk_size bytes that can be inflated in parallel.
+    //
+
+    class pack final {
+    public:
+        enum class compression : u8 {
+            none,
+            deflate
+        };
+
+        static constexpr std::size_t alignment = 4096u;
+        static constexpr std::size_t chunk_size = 64u * 1024u;
+
+        struct entry {
+            str path;
+            u32 path_hash{0u};
+            compression method{compression::none};
+            std::size_t offset{0u};
+            std::size_t stored_size{0u};
+            std::size_t size{0u};
+            std::size_t first_chunk{0u};
+            std::size_t chunk_count{0u};
+        };
+
+        struct chunk {
+            std::size_t offset{0u};
+            std::size_t stored_size{0u};
+        };
+    public:
+        pack() = default;
+        ~pack() noexcept = default;
+
+        pack(pack&& other) noexcept = default;
+        pack& operator=(pack&& other) noexcept = default;
+
+        pack(const pack& other) = default;
+        pack& operator=(const pack& other) = default;
+
+        // entries must be sorted by path, buckets hold entry indices
+        // plus one in the open addressing table of path hashes
+        pack(vector<entry> entries, vector<chunk> chunks, vector<u32> buckets) noexcept;
+
+        void swap(pack& other) noexcept;
+        void clear() noexcept;
+        bool empty() const noexcept;
+
+        std::size_t entry_count() const noexcept;
+        const entry& entry_at(std::size_t index) const noexcept;
+        const entry* find_entry(str_view path) const noexcept;
+
+        // entries are sorted by path, so the ones with a common
+        // prefix make up the [first, last) range of indices
+        std::pair<std::size_t, std::size_t> find_prefix(str_view prefix) const noexcept;
+
+        std::size_t chunk_count() const noexcept;
+        const chunk& chunk_at(std::size_t index) const noexcept;
+    private:
+        vector<entry> entries_;
+        vector<chunk> chunks_;
+        vector<u32> buckets_;
+    };
+
+    void swap(pack& l, pack& r) noexcept;
+
+    //
+    // pack_builder
+    //
+
+    class pack_builder final {
+    public:
+        pack_builder() = default;
+        ~pack_builder() noexcept = default;
+
+        pack_builder& add_file(
+            str path,
+            buffer content,
+            pack::compression method = pack::compression::deflate);
+
+        void clear() noexcept;
+        bool empty() const noexcept;
+        std::size_t file_count() const noexcept;
+
+        // compressed entries that don't get smaller are stored as is
+        bool try_save(const output_stream_uptr& dst) const noexcept;
+    private:
+        struct file {
+            str path;
+            buffer content;
+            pack::compression method{pack::compression::none};
+        };
+        vector<file> files_;
+    };
+}
+
+namespace e2d::packs
+{
+    // reads only the table of contents, one read after the fixed header
+    bool try_load_pack(
+        pack& dst,
+        const input_stream_uptr& src) noexcept;
+
+    bool try_load_pack(
+        pack& dst,
+        buffer_view src) noexcept;
+
+    bool try_inflate_chunk(
+        void* dst,
+        std::size_t dst_size,
+        buffer_view src) noexcept;
+}
@@ -41,7 +41,12 @@ namespace e2d
         virtual std::size_t write(const void* src, std::size_t size) = 0;
         virtual std::size_t seek(std::ptrdiff_t offset, bool relative) = 0;
         virtual std::size_t tell() const = 0;
+
+        // hands the written data over to the system
         virtual void flush() const = 0;
+
+        // flushes and waits until the data reaches the storage device
+        virtual void sync() const = 0;
     };
 }
 
@@ -87,6 +92,9 @@ namespace e2d
         output_sequence& flush() noexcept;
         output_sequence& flush_if(bool yesno) noexcept;
 
+        output_sequence& sync() noexcept;
+        output_sequence& sync_if(bool yesno) noexcept;
+
         template < typename T >
         std::enable_if_t<
             std::is_arithmetic<T>::value,
@@ -102,6 +110,11 @@ namespace e2d
 namespace e2d
 {
     input_stream_uptr make_memory_stream(buffer data) noexcept;
+
+    // collects small writes into one buffer_size write to the stream
+    output_stream_uptr make_buffered_stream(
+        output_stream_uptr stream,
+        std::size_t buffer_size = 64u * 1024u) noexcept;
 }
 
 namespace e2d::streams
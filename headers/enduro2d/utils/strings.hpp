@@ -10,34 +10,54 @@
 
 namespace e2d
 {
+    //
+    // basic_string_hash
+    //
+    // Hashes are checked for collisions in debug builds. Literals
+    // ("u_texture"_hash) evaluated at runtime are checked once per call
+    // site and thread, when the compiler can tell they are. Constants
+    // hashed at compile time are registered once with register_literal.
+    //
+
     template < typename Char >
     class basic_string_hash final {
     public:
-        basic_string_hash() noexcept = default;
+        constexpr basic_string_hash() noexcept = default;
         ~basic_string_hash() noexcept = default;
 
-        basic_string_hash(basic_string_hash&& other) noexcept;
-        basic_string_hash& operator=(basic_string_hash&& other) noexcept;
+        constexpr basic_string_hash(basic_string_hash&& other) noexcept;
+        constexpr basic_string_hash& operator=(basic_string_hash&& other) noexcept;
 
-        basic_string_hash(const basic_string_hash& other) noexcept;
-        basic_string_hash& operator=(const basic_string_hash& other) noexcept;
+        constexpr basic_string_hash(const basic_string_hash& other) noexcept;
+        constexpr basic_string_hash& operator=(const basic_string_hash& other) noexcept;
 
         basic_string_hash(const Char* str) noexcept;
         basic_string_hash(basic_string_view<Char> str) noexcept;
 
-        basic_string_hash& assign(basic_string_hash&& other) noexcept;
-        basic_string_hash& assign(const basic_string_hash& other) noexcept;
+        constexpr basic_string_hash& assign(basic_string_hash&& other) noexcept;
+        constexpr basic_string_hash& assign(const basic_string_hash& other) noexcept;
         basic_string_hash& assign(const Char* str) noexcept;
         basic_string_hash& assign(basic_string_view<Char> str) noexcept;
 
         void swap(basic_string_hash& other) noexcept;
         void clear() noexcept;
-        bool empty() const noexcept;
+        constexpr bool empty() const noexcept;
+
+        constexpr u32 hash() const noexcept;
 
-        u32 hash() const noexcept;
+        static constexpr basic_string_hash from_literal(
+            const Char* str,
+            std::size_t size) noexcept;
+
+        // checks a compile time hash for collisions in debug builds,
+        // does nothing otherwise and always returns true
+        static bool register_literal(
+            basic_string_hash hash,
+            basic_string_view<Char> str) noexcept;
     private:
-        static u32 empty_hash() noexcept;
+        static constexpr u32 empty_hash() noexcept;
         static u32 calculate_hash(basic_string_view<Char> str) noexcept;
+        static void debug_check_literal(u32 hash, const Char* str, std::size_t size) noexcept;
         static void debug_check_collisions(u32 hash, basic_string_view<Char> str) noexcept;
     private:
         u32 hash_ = empty_hash();
@@ -47,13 +67,24 @@ namespace e2d
     void swap(basic_string_hash<Char>& l, basic_string_hash<Char>& r) noexcept;
 
     template < typename Char >
-    bool operator<(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept;
+    constexpr bool operator<(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept;
 
     template < typename Char >
-    bool operator==(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept;
+    constexpr bool operator==(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept;
 
     template < typename Char >
-    bool operator!=(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept;
+    constexpr bool operator!=(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept;
+}
+
+namespace e2d
+{
+    inline namespace literals
+    {
+        constexpr str_hash operator""_hash(const char* str, std::size_t size) noexcept;
+        constexpr wstr_hash operator""_hash(const wchar_t* str, std::size_t size) noexcept;
+        constexpr str16_hash operator""_hash(const char16_t* str, std::size_t size) noexcept;
+        constexpr str32_hash operator""_hash(const char32_t* str, std::size_t size) noexcept;
+    }
 }
 
 namespace e2d
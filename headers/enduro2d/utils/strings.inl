@@ -11,28 +11,28 @@
 namespace e2d
 {
     template < typename Char >
-    basic_string_hash<Char>::basic_string_hash(
+    constexpr basic_string_hash<Char>::basic_string_hash(
         basic_string_hash&& other) noexcept
     {
         assign(std::move(other));
     }
 
     template < typename Char >
-    basic_string_hash<Char>& basic_string_hash<Char>::operator=(
+    constexpr basic_string_hash<Char>& basic_string_hash<Char>::operator=(
         basic_string_hash&& other) noexcept
     {
         return assign(std::move(other));
     }
 
     template < typename Char >
-    basic_string_hash<Char>::basic_string_hash(
+    constexpr basic_string_hash<Char>::basic_string_hash(
         const basic_string_hash& other) noexcept
     {
         assign(other);
     }
 
     template < typename Char >
-    basic_string_hash<Char>& basic_string_hash<Char>::operator=(
+    constexpr basic_string_hash<Char>& basic_string_hash<Char>::operator=(
         const basic_string_hash& other) noexcept
     {
         return assign(other);
@@ -53,18 +53,18 @@ namespace e2d
     }
 
     template < typename Char >
-    basic_string_hash<Char>& basic_string_hash<Char>::assign(
+    constexpr basic_string_hash<Char>& basic_string_hash<Char>::assign(
         basic_string_hash&& other) noexcept
     {
         if ( this != &other ) {
-            swap(other);
-            other.clear();
+            hash_ = other.hash_;
+            other.hash_ = empty_hash();
         }
         return *this;
     }
 
     template < typename Char >
-    basic_string_hash<Char>& basic_string_hash<Char>::assign(
+    constexpr basic_string_hash<Char>& basic_string_hash<Char>::assign(
         const basic_string_hash& other) noexcept
     {
         if ( this != &other ) {
@@ -101,28 +101,78 @@ namespace e2d
     }
 
     template < typename Char >
-    bool basic_string_hash<Char>::empty() const noexcept {
+    constexpr bool basic_string_hash<Char>::empty() const noexcept {
         return hash_ == empty_hash();
     }
 
     template < typename Char >
-    u32 basic_string_hash<Char>::hash() const noexcept {
+    constexpr u32 basic_string_hash<Char>::hash() const noexcept {
         return hash_;
     }
 
     template < typename Char >
-    u32 basic_string_hash<Char>::empty_hash() noexcept {
-        static u32 hash = calculate_hash(basic_string_view<Char>());
-        return hash;
+    constexpr basic_string_hash<Char> basic_string_hash<Char>::from_literal(
+        const Char* str,
+        std::size_t size) noexcept
+    {
+        basic_string_hash result;
+        result.hash_ = utils::xx_hash32(str, size);
+    #if defined(E2D_BUILD_MODE) && E2D_BUILD_MODE == E2D_BUILD_MODE_DEBUG
+    #  if defined(E2D_HAS_IS_CONSTANT_EVALUATED)
+        if ( !__builtin_is_constant_evaluated() ) {
+            debug_check_literal(result.hash_, str, size);
+        }
+    #  endif
+    #endif
+        return result;
+    }
+
+    template < typename Char >
+    bool basic_string_hash<Char>::register_literal(
+        basic_string_hash hash,
+        basic_string_view<Char> str) noexcept
+    {
+    #if defined(E2D_BUILD_MODE) && E2D_BUILD_MODE == E2D_BUILD_MODE_DEBUG
+        E2D_ASSERT_MSG(
+            hash.hash_ == utils::xx_hash32(str),
+            "basic_string_hash: literal doesn't match its hash");
+        debug_check_collisions(hash.hash_, str);
+    #else
+        E2D_UNUSED(hash, str);
+    #endif
+        return true;
+    }
+
+    template < typename Char >
+    constexpr u32 basic_string_hash<Char>::empty_hash() noexcept {
+        return utils::xx_hash32(basic_string_view<Char>());
     }
 
     template < typename Char >
     u32 basic_string_hash<Char>::calculate_hash(basic_string_view<Char> str) noexcept {
-        u32 hash = utils::sdbm_hash(str);
+        u32 hash = utils::xx_hash32(str);
         debug_check_collisions(hash, str);
         return hash;
     }
 
+    template < typename Char >
+    void basic_string_hash<Char>::debug_check_literal(u32 hash, const Char* str, std::size_t size) noexcept {
+    #if defined(E2D_BUILD_MODE) && E2D_BUILD_MODE == E2D_BUILD_MODE_DEBUG
+        // literals have static storage, so the address identifies the call
+        // site and the shared table is locked only on the first use
+        try {
+            static thread_local hash_set<const Char*> checked;
+            if ( checked.insert(str).second ) {
+                debug_check_collisions(hash, basic_string_view<Char>(str, size));
+            }
+        } catch (...) {
+            E2D_ASSERT_MSG(false, "basic_string_hash: unexpected debug exception");
+        }
+    #else
+        E2D_UNUSED(hash, str, size);
+    #endif
+    }
+
     template < typename Char >
     void basic_string_hash<Char>::debug_check_collisions(u32 hash, basic_string_view<Char> str) noexcept {
     #if defined(E2D_BUILD_MODE) && E2D_BUILD_MODE == E2D_BUILD_MODE_DEBUG
@@ -155,21 +205,43 @@ namespace e2d
     }
 
     template < typename Char >
-    bool operator<(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept {
+    constexpr bool operator<(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept {
         return l.hash() < r.hash();
     }
 
     template < typename Char >
-    bool operator==(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept {
+    constexpr bool operator==(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept {
         return l.hash() == r.hash();
     }
 
     template < typename Char >
-    bool operator!=(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept {
+    constexpr bool operator!=(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept {
         return !(l == r);
     }
 }
 
+namespace e2d
+{
+    inline namespace literals
+    {
+        constexpr str_hash operator""_hash(const char* str, std::size_t size) noexcept {
+            return str_hash::from_literal(str, size);
+        }
+
+        constexpr wstr_hash operator""_hash(const wchar_t* str, std::size_t size) noexcept {
+            return wstr_hash::from_literal(str, size);
+        }
+
+        constexpr str16_hash operator""_hash(const char16_t* str, std::size_t size) noexcept {
+            return str16_hash::from_literal(str, size);
+        }
+
+        constexpr str32_hash operator""_hash(const char32_t* str, std::size_t size) noexcept {
+            return str32_hash::from_literal(str, size);
+        }
+    }
+}
+
 namespace std
 {
     template < typename Char >
@@ -173,8 +173,8 @@ namespace e2d
                             : texture_ptr();
 
                         mprops_
-                            .property("u_MVP", projection)
-                            .sampler("u_texture", render::sampler_state()
+                            .property("u_MVP"_hash, projection)
+                            .sampler("u_texture"_hash, render::sampler_state()
                                 .texture(texture)
                                 .min_filter(render::sampler_min_filter::linear)
                                 .mag_filter(render::sampler_mag_filter::linear));
@@ -24,19 +24,50 @@ namespace e2d
     }
 
     void debug::unregister_sink(const sink& sink) noexcept {
-        std::lock_guard<std::mutex> guard(mutex_);
-        sinks_.erase(std::remove_if(
-            sinks_.begin(), sinks_.end(),
-            [&sink](const std::pair<level, sink_uptr>& p){
-                return p.second.get() == &sink;
-            }), sinks_.end());
+        std::shared_ptr<sink_entry> removed;
+        try {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if ( !sinks_ ) {
+                return;
+            }
+            const auto iter = std::find_if(
+                sinks_->begin(), sinks_->end(),
+                [&sink](const std::shared_ptr<sink_entry>& e){
+                    return e->sink.get() == &sink;
+                });
+            if ( iter == sinks_->end() ) {
+                return;
+            }
+            removed = *iter;
+            auto sinks = std::make_shared<sink_list>(*sinks_);
+            sinks->erase(sinks->begin() + (iter - sinks_->begin()));
+            sinks_ = std::move(sinks);
+        } catch (...) {
+            E2D_ASSERT_MSG(false, "DEBUG: failed to unregister log sink");
+            return;
+        }
+
+        // waits for messages that are being sent to the sink right now,
+        // the sink may be destroyed by its owner right after the call
+        std::unique_lock<std::shared_mutex> lock(removed->mutex);
+        removed->removed = true;
+        removed->sink.reset();
     }
 
     debug::sink& debug::register_sink_ex(level min_lvl, sink_uptr sink) {
         E2D_ASSERT(sink);
+        auto entry = std::make_shared<sink_entry>();
+        entry->min_level = min_lvl;
+        entry->thread_safe = sink->thread_safe();
+        entry->sink = std::move(sink);
+
         std::lock_guard<std::mutex> guard(mutex_);
-        sinks_.push_back(std::make_pair(min_lvl, std::move(sink)));
-        return *sinks_.back().second;
+        auto sinks = sinks_
+            ? std::make_shared<sink_list>(*sinks_)
+            : std::make_shared<sink_list>();
+        sinks->push_back(entry);
+        sinks_ = std::move(sinks);
+        return *entry->sink;
     }
 
     debug& debug::set_min_level(level lvl) noexcept {
@@ -50,6 +81,23 @@ namespace e2d
         return min_level_;
     }
 
+    void debug::send_message_(sink_entry& entry, level lvl, str_view text) noexcept {
+        bool success = true;
+        if ( entry.thread_safe ) {
+            std::shared_lock<std::shared_mutex> lock(entry.mutex);
+            if ( !entry.removed ) {
+                success = entry.sink->on_message(lvl, text);
+            }
+        } else {
+            std::unique_lock<std::shared_mutex> lock(entry.mutex);
+            if ( !entry.removed ) {
+                success = entry.sink->on_message(lvl, text);
+            }
+        }
+        E2D_UNUSED(success);
+        E2D_ASSERT_MSG(success, "DEBUG: ignored failed log sink call");
+    }
+
     //
     // debug_stream_sink
     //
@@ -72,6 +120,208 @@ namespace e2d
         }
     }
 
+    //
+    // debug_async_sink::internal_state
+    //
+
+    class debug_async_sink::internal_state final : private e2d::noncopyable {
+    public:
+        internal_state(output_stream_uptr stream, debug::level sync_level)
+        : stream_(std::move(stream))
+        , sync_level_(sync_level)
+        , head_(&stub_)
+        , tail_(&stub_)
+        {
+            thread_ = std::thread([this](){
+                worker_main_();
+            });
+        }
+
+        ~internal_state() noexcept {
+            {
+                std::lock_guard<std::mutex> guard(mutex_);
+                stop_ = true;
+            }
+            work_cond_.notify_one();
+            thread_.join();
+        }
+
+        bool on_message(debug::level lvl, str_view text) noexcept {
+            try {
+                push_(new message(log_text_format(lvl, text)));
+                pushed_.fetch_add(1u);
+                if ( sleeping_.load() ) {
+                    work_cond_.notify_one();
+                }
+            } catch (...) {
+                return false;
+            }
+            return lvl >= sync_level_
+                ? flush(true)
+                : !failed_.load();
+        }
+
+        bool flush(bool sync) noexcept {
+            std::unique_lock<std::mutex> lock(mutex_);
+            flush_target_ = math::max(flush_target_, pushed_.load());
+            const u64 request = ++flush_requests_;
+            sync_requested_ = sync_requested_ || sync;
+            work_cond_.notify_one();
+            done_cond_.wait(lock, [this, request](){
+                return flushes_done_ >= request;
+            });
+            return !failed_.load();
+        }
+    private:
+        struct message {
+            std::atomic<message*> next{nullptr};
+            str text;
+
+            message() = default;
+            message(str text) : text(std::move(text)) {}
+        };
+
+        // intrusive multiple producers single consumer queue,
+        // producers only exchange the head, the consumer owns the tail
+
+        void push_(message* m) noexcept {
+            m->next.store(nullptr, std::memory_order_relaxed);
+            message* prev = head_.exchange(m, std::memory_order_acq_rel);
+            prev->next.store(m, std::memory_order_release);
+        }
+
+        message* pop_() noexcept {
+            message* tail = tail_;
+            message* next = tail->next.load(std::memory_order_acquire);
+            if ( tail == &stub_ ) {
+                if ( !next ) {
+                    return nullptr;
+                }
+                tail_ = next;
+                tail = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+            if ( next ) {
+                tail_ = next;
+                return tail;
+            }
+            if ( tail != head_.load(std::memory_order_acquire) ) {
+                return nullptr;
+            }
+            push_(&stub_);
+            next = tail->next.load(std::memory_order_acquire);
+            if ( next ) {
+                tail_ = next;
+                return tail;
+            }
+            return nullptr;
+        }
+
+        void write_(const str& text) noexcept {
+            if ( !stream_ || !output_sequence(*stream_).write_all(text).success() ) {
+                failed_.store(true);
+            }
+        }
+
+        void worker_main_() noexcept {
+            u64 consumed = 0u;
+            while ( true ) {
+                while ( message* m = pop_() ) {
+                    write_(m->text);
+                    delete m;
+                    ++consumed;
+                }
+
+                std::unique_lock<std::mutex> lock(mutex_);
+
+                if ( flush_requests_ > flushes_done_ && consumed >= flush_target_ ) {
+                    const bool success = stream_ && output_sequence(*stream_)
+                        .flush()
+                        .sync_if(sync_requested_)
+                        .success();
+                    if ( !success ) {
+                        failed_.store(true);
+                    }
+                    sync_requested_ = false;
+                    flushes_done_ = flush_requests_;
+                    done_cond_.notify_all();
+                }
+
+                if ( consumed != pushed_.load() ) {
+                    // a producer is in the middle of a push
+                    lock.unlock();
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                if ( stop_ ) {
+                    break;
+                }
+
+                sleeping_.store(true);
+                work_cond_.wait_for(lock, std::chrono::milliseconds(100), [this, consumed](){
+                    return stop_
+                        || consumed != pushed_.load()
+                        || flush_requests_ > flushes_done_;
+                });
+                sleeping_.store(false);
+            }
+
+            try {
+                if ( stream_ ) {
+                    stream_->flush();
+                }
+            } catch (...) {
+                failed_.store(true);
+            }
+        }
+    private:
+        output_stream_uptr stream_;
+        debug::level sync_level_ = debug::level::fatal;
+
+        message stub_;
+        std::atomic<message*> head_{nullptr};
+        message* tail_{nullptr};
+        std::atomic<u64> pushed_{0u};
+        std::atomic<bool> sleeping_{false};
+        std::atomic<bool> failed_{false};
+
+        std::mutex mutex_;
+        std::condition_variable work_cond_;
+        std::condition_variable done_cond_;
+        u64 flush_target_{0u};
+        u64 flush_requests_{0u};
+        u64 flushes_done_{0u};
+        bool sync_requested_{false};
+        bool stop_{false};
+
+        std::thread thread_;
+    };
+
+    //
+    // debug_async_sink
+    //
+
+    debug_async_sink::debug_async_sink(output_stream_uptr stream)
+    : state_(std::make_unique<internal_state>(std::move(stream), debug::level::fatal)) {}
+
+    debug_async_sink::debug_async_sink(output_stream_uptr stream, debug::level sync_level)
+    : state_(std::make_unique<internal_state>(std::move(stream), sync_level)) {}
+
+    debug_async_sink::~debug_async_sink() noexcept = default;
+
+    bool debug_async_sink::on_message(debug::level lvl, str_view text) noexcept {
+        return state_->on_message(lvl, text);
+    }
+
+    bool debug_async_sink::thread_safe() const noexcept {
+        return true;
+    }
+
+    bool debug_async_sink::flush(bool sync) noexcept {
+        return state_->flush(sync);
+    }
+
     //
     // debug_console_sink
     //
@@ -27,7 +27,114 @@ namespace e2d
         return scheduler_;
     }
 
+    deferrer& deferrer::main_thread_budget(microseconds<u64> budget) noexcept {
+        std::lock_guard<std::mutex> guard(tasks_mutex_);
+        main_thread_budget_ = budget;
+        return *this;
+    }
+
+    microseconds<u64> deferrer::main_thread_budget() const noexcept {
+        std::lock_guard<std::mutex> guard(tasks_mutex_);
+        return main_thread_budget_;
+    }
+
+    deferrer_statistics deferrer::statistics() const noexcept {
+        std::lock_guard<std::mutex> guard(tasks_mutex_);
+        deferrer_statistics result = statistics_;
+        result.queued_tasks = queued_tasks_;
+        return result;
+    }
+
+    bool deferrer::process_one_main_thread_task() noexcept {
+        E2D_ASSERT(is_in_main_thread());
+        main_thread_task_uptr task = pop_main_thread_task_(
+            std::numeric_limits<u64>::max());
+        if ( !task ) {
+            return false;
+        }
+
+        const microseconds<u64> start_time = time::now_us<u64>();
+        task->run();
+        const microseconds<u64> spent_time = time::now_us<u64>() - start_time;
+
+        std::lock_guard<std::mutex> guard(tasks_mutex_);
+        statistics_.total_executed_tasks += 1u;
+        statistics_.total_spent_time += spent_time;
+        return true;
+    }
+
     void deferrer::frame_tick() noexcept {
+        E2D_ASSERT(is_in_main_thread());
         scheduler_.process_all_tasks();
+
+        microseconds<u64> budget;
+        u64 frame_sequence_end = 0u;
+        {
+            std::lock_guard<std::mutex> guard(tasks_mutex_);
+            budget = main_thread_budget_;
+            frame_sequence_end = next_task_sequence_;
+        }
+
+        const microseconds<u64> start_time = time::now_us<u64>();
+
+        // tasks queued during the tick wait for the next frame, even the
+        // high priority ones, so rescheduling tasks can't take the whole
+        // budget. makes progress even with a zero budget
+        std::size_t executed_tasks = 0u;
+        for ( ;; ) {
+            main_thread_task_uptr task = pop_main_thread_task_(frame_sequence_end);
+            if ( !task ) {
+                break;
+            }
+            task->run();
+            ++executed_tasks;
+            if ( time::now_us<u64>() - start_time >= budget ) {
+                break;
+            }
+        }
+
+        const microseconds<u64> spent_time = time::now_us<u64>() - start_time;
+
+        std::lock_guard<std::mutex> guard(tasks_mutex_);
+        statistics_.executed_tasks = executed_tasks;
+        statistics_.deferred_tasks = queued_tasks_;
+        statistics_.spent_time = spent_time;
+        statistics_.total_executed_tasks += executed_tasks;
+        statistics_.total_spent_time += spent_time;
+    }
+
+    void deferrer::push_main_thread_task_(
+        deferrer_priority priority,
+        main_thread_task_uptr task)
+    {
+        const std::size_t index = utils::enum_to_underlying(priority);
+        E2D_ASSERT(index < tasks_.size());
+        std::lock_guard<std::mutex> guard(tasks_mutex_);
+        tasks_[index].tasks.push_back({next_task_sequence_++, std::move(task)});
+        ++queued_tasks_;
+    }
+
+    deferrer::main_thread_task_uptr deferrer::pop_main_thread_task_(u64 sequence_end) noexcept {
+        std::lock_guard<std::mutex> guard(tasks_mutex_);
+        for ( auto iter = tasks_.rbegin(); iter != tasks_.rend(); ++iter ) {
+            main_thread_task_queue& queue = *iter;
+            // sequences grow within a queue, so only the head is checked
+            if ( queue.head < queue.tasks.size() && queue.tasks[queue.head].sequence < sequence_end ) {
+                main_thread_task_uptr task = std::move(queue.tasks[queue.head++].task);
+                if ( queue.head == queue.tasks.size() ) {
+                    queue.tasks.clear();
+                    queue.head = 0u;
+                } else if ( queue.head >= 64u && queue.head * 2u >= queue.tasks.size() ) {
+                    // the queue is never drained while producers keep up
+                    queue.tasks.erase(
+                        queue.tasks.begin(),
+                        queue.tasks.begin() + math::numeric_cast<std::ptrdiff_t>(queue.head));
+                    queue.head = 0u;
+                }
+                --queued_tasks_;
+                return task;
+            }
+        }
+        return nullptr;
     }
 }
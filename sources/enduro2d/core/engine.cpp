@@ -115,6 +115,32 @@ namespace e2d
         return maximal_framerate_;
     }
 
+    //
+    // engine::vfs_parameters
+    //
+
+    engine::vfs_parameters& engine::vfs_parameters::worker_threads(u32 value) noexcept {
+        worker_threads_ = value;
+        return *this;
+    }
+
+    u32 engine::vfs_parameters::worker_threads() const noexcept {
+        return worker_threads_;
+    }
+
+    //
+    // engine::deferrer_parameters
+    //
+
+    engine::deferrer_parameters& engine::deferrer_parameters::main_thread_budget(microseconds<u64> value) noexcept {
+        main_thread_budget_ = value;
+        return *this;
+    }
+
+    microseconds<u64> engine::deferrer_parameters::main_thread_budget() const noexcept {
+        return main_thread_budget_;
+    }
+
     //
     // engine::window_parameters
     //
@@ -207,6 +233,16 @@ namespace e2d
         return *this;
     }
 
+    engine::parameters& engine::parameters::vfs_params(vfs_parameters value) noexcept {
+        vfs_params_ = std::move(value);
+        return *this;
+    }
+
+    engine::parameters& engine::parameters::deferrer_params(deferrer_parameters value) noexcept {
+        deferrer_params_ = std::move(value);
+        return *this;
+    }
+
     str& engine::parameters::game_name() noexcept {
         return game_name_;
     }
@@ -235,6 +271,14 @@ namespace e2d
         return timer_params_;
     }
 
+    engine::vfs_parameters& engine::parameters::vfs_params() noexcept {
+        return vfs_params_;
+    }
+
+    engine::deferrer_parameters& engine::parameters::deferrer_params() noexcept {
+        return deferrer_params_;
+    }
+
     const str& engine::parameters::game_name() const noexcept {
         return game_name_;
     }
@@ -263,6 +307,14 @@ namespace e2d
         return timer_params_;
     }
 
+    const engine::vfs_parameters& engine::parameters::vfs_params() const noexcept {
+        return vfs_params_;
+    }
+
+    const engine::deferrer_parameters& engine::parameters::deferrer_params() const noexcept {
+        return deferrer_params_;
+    }
+
     //
     // engine
     //
@@ -367,6 +419,8 @@ namespace e2d
         // setup deferrer
 
         safe_module_initialize<deferrer>();
+        the<deferrer>().main_thread_budget(
+            params.deferrer_params().main_thread_budget());
 
         // setup debug
 
@@ -378,7 +432,8 @@ namespace e2d
 
         // setup vfs
 
-        safe_module_initialize<vfs>();
+        safe_module_initialize<vfs>(
+            params.vfs_params().worker_threads());
 
         the<vfs>().register_scheme<filesystem_file_source>("file");
         safe_register_predef_path(the<vfs>(), "home", filesystem::predef_path::home);
@@ -394,8 +449,9 @@ namespace e2d
                 / params.company_name()
                 / params.game_name()
                 / params.debug_params().log_filename();
-            output_stream_uptr log_stream = the<vfs>().write(log_url, false);
-            the<debug>().register_sink<debug_stream_sink>(std::move(log_stream));
+            output_stream_uptr log_stream = make_buffered_stream(
+                the<vfs>().write(log_url, false));
+            the<debug>().register_sink<debug_async_sink>(std::move(log_stream));
         }
 
         // setup input
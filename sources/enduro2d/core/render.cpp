@@ -118,6 +118,80 @@ namespace
     private:
         render& render_;
     };
+
+    // target:8 | layer:16 | depth:16 | material:12 | texture:12
+    const u64 sort_key_target_mask = 0xFFu;
+    const u64 sort_key_layer_mask = 0xFFFFu;
+    const u64 sort_key_depth_mask = 0xFFFFu;
+    const u64 sort_key_material_mask = 0xFFFu;
+    const u64 sort_key_texture_mask = 0xFFFu;
+
+    bool is_draw_command(const render::command_value& value) noexcept {
+        return std::holds_alternative<render::draw_command>(value);
+    }
+
+    bool try_merge_draw_commands(
+        render::draw_command& l,
+        const render::draw_command& r) noexcept
+    {
+        if ( &l.material_ref() != &r.material_ref()
+            || &l.geometry_ref() != &r.geometry_ref()
+            || &l.properties_ref() != &r.properties_ref() )
+        {
+            return false;
+        }
+        if ( l.index_count() == std::size_t(-1)
+            || l.first_index() + l.index_count() != r.first_index() )
+        {
+            return false;
+        }
+        if ( r.index_count() == std::size_t(-1) ) {
+            l.index_count(std::size_t(-1));
+        } else {
+            l.index_count(l.index_count() + r.index_count());
+        }
+        return true;
+    }
+
+    std::size_t property_value_hash(const render::property_value& value) noexcept {
+        E2D_ASSERT(!value.valueless_by_exception());
+        return std::visit([](const auto& v) noexcept {
+            using value_type = std::decay_t<decltype(v)>;
+            static_assert(std::is_trivially_copyable_v<value_type>);
+            const auto* bytes = reinterpret_cast<const u8*>(&v);
+            std::size_t result = sizeof(value_type);
+            for ( std::size_t i = 0; i < sizeof(value_type); i += sizeof(std::size_t) ) {
+                std::size_t word = 0;
+                std::memcpy(&word, bytes + i, math::min(sizeof(word), sizeof(value_type) - i));
+                result = utils::hash_combine(result, word);
+            }
+            return result;
+        }, value);
+    }
+
+    std::size_t sampler_state_hash(const render::sampler_state& sampler) noexcept {
+        std::size_t result = std::hash<const texture*>()(sampler.texture().get());
+        result = utils::hash_combine(result, utils::enum_to_underlying(sampler.s_wrap()));
+        result = utils::hash_combine(result, utils::enum_to_underlying(sampler.t_wrap()));
+        result = utils::hash_combine(result, utils::enum_to_underlying(sampler.min_filter()));
+        result = utils::hash_combine(result, utils::enum_to_underlying(sampler.mag_filter()));
+        return result;
+    }
+
+    bool is_same_property_value(
+        const render::property_value& l,
+        const render::property_value& r) noexcept
+    {
+        // bitwise, approximate comparison would swallow small uniform changes
+        if ( l.index() != r.index() ) {
+            return false;
+        }
+        return std::visit([&r](const auto& lv) noexcept {
+            using value_type = std::decay_t<decltype(lv)>;
+            static_assert(std::is_trivially_copyable_v<value_type>);
+            return 0 == std::memcmp(&lv, std::get_if<value_type>(&r), sizeof(value_type));
+        }, l);
+    }
 }
 
 namespace e2d
@@ -703,16 +777,21 @@ namespace e2d
     render::property_block& render::property_block::clear() noexcept {
         properties_.clear();
         samplers_.clear();
+        hash_valid_ = false;
         return *this;
     }
 
     render::property_block& render::property_block::merge(const property_block& pb) {
         properties_.merge(pb.properties_);
         samplers_.merge(pb.samplers_);
+        hash_valid_ = false;
         return *this;
     }
 
     bool render::property_block::equals(const property_block& other) const noexcept {
+        if ( this == &other ) {
+            return true;
+        }
         if ( properties_.size() != other.properties_.size() ) {
             return false;
         }
@@ -723,28 +802,40 @@ namespace e2d
             && samplers_.equals(other.samplers_);
     }
 
+    std::size_t render::property_block::hash() const noexcept {
+        if ( hash_valid_ ) {
+            return hash_;
+        }
+        std::size_t result = 0;
+        properties_.foreach([&result](str_hash name, const property_value& value) noexcept {
+            result = utils::hash_combine(result, name.hash());
+            result = utils::hash_combine(result, property_value_hash(value));
+        });
+        samplers_.foreach([&result](str_hash name, const sampler_state& sampler) noexcept {
+            result = utils::hash_combine(result, name.hash());
+            result = utils::hash_combine(result, sampler_state_hash(sampler));
+        });
+        hash_ = result;
+        hash_valid_ = true;
+        return hash_;
+    }
+
     render::property_block& render::property_block::sampler(str_hash name, const sampler_state& s) {
         samplers_.assign(name, s);
+        hash_valid_ = false;
         return *this;
     }
 
-    render::sampler_state* render::property_block::sampler(str_hash name) noexcept {
-        return samplers_.find(name);
-    }
-
     const render::sampler_state* render::property_block::sampler(str_hash name) const noexcept {
         return samplers_.find(name);
     }
 
     render::property_block& render::property_block::property(str_hash name, const property_value& v) {
         properties_.assign(name, v);
+        hash_valid_ = false;
         return *this;
     }
 
-    render::property_value* render::property_block::property(str_hash name) noexcept {
-        return properties_.find(name);
-    }
-
     const render::property_value* render::property_block::property(str_hash name) const noexcept {
         return properties_.find(name);
     }
@@ -1124,6 +1215,586 @@ namespace e2d
         return scissoring_;
     }
 
+    //
+    // command_queue
+    //
+
+    u64 render::command_queue::make_sort_key(
+        u32 target,
+        u32 layer,
+        u32 depth,
+        u32 material,
+        u32 texture) noexcept
+    {
+        return ((target & sort_key_target_mask) << 56u)
+            | ((layer & sort_key_layer_mask) << 40u)
+            | ((depth & sort_key_depth_mask) << 24u)
+            | ((material & sort_key_material_mask) << 12u)
+            | (texture & sort_key_texture_mask);
+    }
+
+    render::command_queue& render::command_queue::add_command(u64 sort_key, command_value&& value) {
+        commands_.push_back({sort_key, std::move(value)});
+        return *this;
+    }
+
+    render::command_queue& render::command_queue::add_command(u64 sort_key, const command_value& value) {
+        commands_.push_back({sort_key, value});
+        return *this;
+    }
+
+    render::command_queue& render::command_queue::sort() {
+        // clear, target and viewport commands are barriers,
+        // draws are reordered only between them
+        const auto less = [](const entry& l, const entry& r) noexcept {
+            return l.sort_key < r.sort_key;
+        };
+        for ( auto first = commands_.begin(); first != commands_.end(); ) {
+            if ( !is_draw_command(first->value) ) {
+                ++first;
+                continue;
+            }
+            const auto last = std::find_if(first, commands_.end(), [](const entry& e) noexcept {
+                return !is_draw_command(e.value);
+            });
+            std::stable_sort(first, last, less);
+            first = last;
+        }
+
+        // adjacent draws of the same index range tail are merged
+        std::size_t merged = 0;
+        for ( std::size_t i = 1, e = commands_.size(); i < e; ++i ) {
+            entry& prev = commands_[merged];
+            entry& curr = commands_[i];
+            const bool merge =
+                is_draw_command(prev.value) &&
+                is_draw_command(curr.value) &&
+                try_merge_draw_commands(
+                    std::get<draw_command>(prev.value),
+                    std::get<draw_command>(curr.value));
+            if ( !merge ) {
+                ++merged;
+                if ( merged != i ) {
+                    commands_[merged] = std::move(curr);
+                }
+            }
+        }
+        if ( !commands_.empty() ) {
+            commands_.erase(commands_.begin() + merged + 1, commands_.end());
+        }
+        return *this;
+    }
+
+    render::command_queue& render::command_queue::clear() noexcept {
+        commands_.clear();
+        return *this;
+    }
+
+    const render::command_value& render::command_queue::command(std::size_t index) const noexcept {
+        E2D_ASSERT(index < commands_.size());
+        return commands_[index].value;
+    }
+
+    u64 render::command_queue::sort_key(std::size_t index) const noexcept {
+        E2D_ASSERT(index < commands_.size());
+        return commands_[index].sort_key;
+    }
+
+    std::size_t render::command_queue::command_count() const noexcept {
+        return commands_.size();
+    }
+
+    //
+    // ring_allocator
+    //
+
+    render::ring_allocator::ring_allocator(std::size_t capacity, std::size_t frame_count) noexcept
+    : capacity_(capacity)
+    , frame_count_(math::max(frame_count, std::size_t(1))) {}
+
+    std::optional<render::ring_allocator::allocation> render::ring_allocator::allocate(
+        std::size_t size,
+        std::size_t alignment) noexcept
+    {
+        E2D_ASSERT(alignment > 0);
+        if ( size > capacity_ ) {
+            return std::nullopt;
+        }
+
+        if ( !used_ ) {
+            head_ = 0;
+        }
+
+        // the free space starts at the head and ends at the oldest frame in flight
+        const std::size_t offset = (head_ + alignment - 1u) / alignment * alignment;
+        if ( offset + size <= capacity_ && used_ + (offset - head_) + size <= capacity_ ) {
+            const std::size_t consumed = (offset - head_) + size;
+            head_ = offset + size;
+            used_ += consumed;
+            frame_used_ += consumed;
+            return allocation{offset, false};
+        }
+
+        // the tail of the storage is wasted until its frame retires
+        const std::size_t wasted = capacity_ - head_;
+        if ( used_ + wasted + size <= capacity_ ) {
+            head_ = size;
+            used_ += wasted + size;
+            frame_used_ += wasted + size;
+            return allocation{0u, false};
+        }
+
+        // all free regions are still in flight, so the storage is orphaned
+        frames_used_.clear();
+        head_ = size;
+        used_ = size;
+        frame_used_ = size;
+        return allocation{0u, true};
+    }
+
+    render::ring_allocator& render::ring_allocator::next_frame() {
+        frames_used_.push_back(frame_used_);
+        frame_used_ = 0;
+        if ( frames_used_.size() >= frame_count_ ) {
+            const std::size_t retired = frames_used_.size() - frame_count_ + 1u;
+            for ( std::size_t i = 0; i < retired; ++i ) {
+                E2D_ASSERT(used_ >= frames_used_[i]);
+                used_ -= frames_used_[i];
+            }
+            frames_used_.erase(
+                frames_used_.begin(),
+                frames_used_.begin() + math::numeric_cast<std::ptrdiff_t>(retired));
+        }
+        return *this;
+    }
+
+    render::ring_allocator& render::ring_allocator::reset(std::size_t capacity) noexcept {
+        capacity_ = capacity;
+        head_ = 0;
+        used_ = 0;
+        frame_used_ = 0;
+        frames_used_.clear();
+        return *this;
+    }
+
+    std::size_t render::ring_allocator::capacity() const noexcept {
+        return capacity_;
+    }
+
+    std::size_t render::ring_allocator::frame_count() const noexcept {
+        return frame_count_;
+    }
+
+    std::size_t render::ring_allocator::used_size() const noexcept {
+        return used_;
+    }
+
+    //
+    // state_cache
+    //
+
+    render::state_cache::state_cache(backend& backend) noexcept
+    : backend_(backend) {}
+
+    render::state_cache& render::state_cache::invalidate() noexcept {
+        // attribute arrays are toggled through the cache only, so they are kept
+        program_.reset();
+        active_unit_.reset();
+        textures_.clear();
+        return *this;
+    }
+
+    render::state_cache& render::state_cache::use_program(u32 program) noexcept {
+        if ( program_ == program ) {
+            ++stats_.avoided_program_binds;
+            return *this;
+        }
+        backend_.use_program(program);
+        program_ = program;
+        return *this;
+    }
+
+    render::state_cache& render::state_cache::set_uniform(
+        uniform_values& values,
+        std::size_t slot,
+        i32 location,
+        const property_value& value)
+    {
+        E2D_ASSERT(!value.valueless_by_exception());
+        if ( slot >= values.size() ) {
+            values.resize(slot + 1u);
+        }
+        std::optional<property_value>& current = values[slot];
+        if ( current && is_same_property_value(*current, value) ) {
+            ++stats_.avoided_uniform_uploads;
+            return *this;
+        }
+        backend_.set_uniform(location, value);
+        current = value;
+        return *this;
+    }
+
+    render::state_cache& render::state_cache::bind_texture(u32 unit, u32 target, u32 texture) {
+        const auto key = std::make_pair(unit, target);
+        const auto iter = textures_.find(key);
+        if ( iter != textures_.end() && iter->second == texture ) {
+            ++stats_.avoided_texture_binds;
+            return *this;
+        }
+
+        if ( active_unit_ == unit ) {
+            ++stats_.avoided_texture_units;
+        } else {
+            active_texture_(unit);
+        }
+
+        backend_.bind_texture(target, texture);
+        if ( iter != textures_.end() ) {
+            iter->second = texture;
+        } else {
+            textures_.emplace(key, texture);
+        }
+        return *this;
+    }
+
+    render::state_cache& render::state_cache::set_sampler(
+        sampler_values& values,
+        u32 unit,
+        u32 target,
+        const sampler_state& sampler) noexcept
+    {
+        // parameters apply to the texture bound to the active unit
+        if ( !values.valid || values.s_wrap != sampler.s_wrap() ) {
+            active_texture_(unit);
+            backend_.set_texture_s_wrap(target, sampler.s_wrap());
+            values.s_wrap = sampler.s_wrap();
+        } else {
+            ++stats_.avoided_sampler_params;
+        }
+
+        if ( !values.valid || values.t_wrap != sampler.t_wrap() ) {
+            active_texture_(unit);
+            backend_.set_texture_t_wrap(target, sampler.t_wrap());
+            values.t_wrap = sampler.t_wrap();
+        } else {
+            ++stats_.avoided_sampler_params;
+        }
+
+        if ( !values.valid || values.min_filter != sampler.min_filter() ) {
+            active_texture_(unit);
+            backend_.set_texture_min_filter(target, sampler.min_filter());
+            values.min_filter = sampler.min_filter();
+        } else {
+            ++stats_.avoided_sampler_params;
+        }
+
+        if ( !values.valid || values.mag_filter != sampler.mag_filter() ) {
+            active_texture_(unit);
+            backend_.set_texture_mag_filter(target, sampler.mag_filter());
+            values.mag_filter = sampler.mag_filter();
+        } else {
+            ++stats_.avoided_sampler_params;
+        }
+
+        values.valid = true;
+        return *this;
+    }
+
+    render::state_cache& render::state_cache::begin_attributes() noexcept {
+        std::fill(
+            desired_attributes_.begin(),
+            desired_attributes_.end(),
+            false);
+        return *this;
+    }
+
+    render::state_cache& render::state_cache::enable_attribute(u32 index) {
+        if ( index >= desired_attributes_.size() ) {
+            desired_attributes_.resize(index + 1u, false);
+        }
+        if ( index >= enabled_attributes_.size() ) {
+            enabled_attributes_.resize(index + 1u, false);
+        }
+        if ( !desired_attributes_[index] ) {
+            desired_attributes_[index] = true;
+            if ( enabled_attributes_[index] ) {
+                ++stats_.avoided_attribute_toggles;
+            } else {
+                backend_.enable_attribute(index);
+                enabled_attributes_[index] = true;
+            }
+        }
+        return *this;
+    }
+
+    render::state_cache& render::state_cache::end_attributes() noexcept {
+        for ( std::size_t i = 0, e = enabled_attributes_.size(); i < e; ++i ) {
+            const bool desired = i < desired_attributes_.size() && desired_attributes_[i];
+            if ( enabled_attributes_[i] && !desired ) {
+                backend_.disable_attribute(math::numeric_cast<u32>(i));
+                enabled_attributes_[i] = false;
+            }
+        }
+        return *this;
+    }
+
+    render::state_cache& render::state_cache::reset_statistics() noexcept {
+        stats_ = statistics();
+        return *this;
+    }
+
+    const render::state_cache::statistics& render::state_cache::stats() const noexcept {
+        return stats_;
+    }
+
+    void render::state_cache::active_texture_(u32 unit) noexcept {
+        if ( active_unit_ == unit ) {
+            return;
+        }
+        backend_.active_texture(unit);
+        active_unit_ = unit;
+    }
+
+    //
+    // texture_uploader::upload
+    //
+
+    render::texture_uploader::upload::upload(
+        texture_ptr texture,
+        std::shared_ptr<const image> source,
+        const pixel_declaration& decl)
+    : texture_(std::move(texture))
+    , source_(std::move(source))
+    , decl_(decl) {}
+
+    const texture_ptr& render::texture_uploader::upload::texture() const noexcept {
+        return texture_;
+    }
+
+    const stdex::promise<texture_ptr>& render::texture_uploader::upload::result() const noexcept {
+        return result_;
+    }
+
+    bool render::texture_uploader::upload::ready() const noexcept {
+        return !source_;
+    }
+
+    u32 render::texture_uploader::upload::uploaded_levels() const noexcept {
+        return uploaded_levels_;
+    }
+
+    u32 render::texture_uploader::upload::uploaded_rows() const noexcept {
+        return uploaded_rows_;
+    }
+
+    //
+    // texture_uploader
+    //
+
+    render::texture_uploader::texture_uploader(backend& backend) noexcept
+    : backend_(backend) {}
+
+    render::texture_uploader::~texture_uploader() noexcept {
+        for ( const upload_ptr& u : pending_ ) {
+            u->result_.reject(std::make_exception_ptr(bad_render_operation()));
+        }
+    }
+
+    render::texture_uploader::upload_ptr render::texture_uploader::upload_texture(
+        image image,
+        const pixel_declaration& decl)
+    {
+        return upload_texture(
+            std::make_shared<const e2d::image>(std::move(image)),
+            decl);
+    }
+
+    render::texture_uploader::upload_ptr render::texture_uploader::upload_texture(
+        std::shared_ptr<const image> image,
+        const pixel_declaration& decl)
+    {
+        E2D_ASSERT(image);
+
+        if ( image->data().size() <= byte_budget_ || !is_band_uploadable(decl) ) {
+            texture_ptr tex = backend_.create_texture(*image);
+            if ( !tex ) {
+                return nullptr;
+            }
+            auto u = std::make_shared<upload>(tex, nullptr, decl);
+            u->level_count_ = math::min(image->mipmap_count(), backend_.texture_mipmap_count(tex));
+            u->uploaded_levels_ = u->level_count_;
+            u->result_.resolve(tex);
+            stats_.total_uploaded_bytes += image->data().size();
+            return u;
+        }
+
+        texture_ptr tex = backend_.create_texture(image->size(), decl, image->mipmap_count());
+        if ( !tex ) {
+            return nullptr;
+        }
+
+        // only the allocated levels are uploaded
+        const u32 mipmap_count = image->mipmap_count();
+        auto u = std::make_shared<upload>(std::move(tex), std::move(image), decl);
+        u->level_count_ = math::min(mipmap_count, backend_.texture_mipmap_count(u->texture_));
+        pending_.push_back(u);
+        return u;
+    }
+
+    render::texture_uploader& render::texture_uploader::frame_tick() {
+        std::size_t bands = 0;
+        std::size_t bytes = 0;
+        while ( !pending_.empty() && (!bands || bytes < byte_budget_) ) {
+            bytes += upload_band_(*pending_.front());
+            ++bands;
+        }
+        stats_.uploaded_bands = bands;
+        stats_.uploaded_bytes = bytes;
+        return *this;
+    }
+
+    render::texture_uploader& render::texture_uploader::flush() {
+        while ( !pending_.empty() ) {
+            upload_band_(*pending_.front());
+        }
+        return *this;
+    }
+
+    render::texture_uploader& render::texture_uploader::byte_budget(std::size_t budget) noexcept {
+        byte_budget_ = budget;
+        return *this;
+    }
+
+    std::size_t render::texture_uploader::byte_budget() const noexcept {
+        return byte_budget_;
+    }
+
+    bool render::texture_uploader::empty() const noexcept {
+        return pending_.empty();
+    }
+
+    std::size_t render::texture_uploader::pending_count() const noexcept {
+        return pending_.size();
+    }
+
+    render::texture_uploader& render::texture_uploader::reset_statistics() noexcept {
+        stats_ = statistics();
+        return *this;
+    }
+
+    const render::texture_uploader::statistics& render::texture_uploader::stats() const noexcept {
+        return stats_;
+    }
+
+    u32 render::texture_uploader::band_height(
+        const pixel_declaration& decl,
+        u32 width,
+        std::size_t budget) noexcept
+    {
+        const u32 block_height = math::max(decl.block_size().y, 1u);
+        const std::size_t block_row_size = decl.data_size_for_dimension(v2u(width, block_height));
+        const std::size_t block_rows = block_row_size > 0u
+            ? math::max(budget / block_row_size, std::size_t(1))
+            : std::size_t(1);
+        const std::size_t max_block_rows = std::numeric_limits<u32>::max() / block_height;
+        return math::numeric_cast<u32>(math::min(block_rows, max_block_rows)) * block_height;
+    }
+
+    bool render::texture_uploader::is_band_uploadable(
+        const pixel_declaration& decl) noexcept
+    {
+        switch ( decl.type() ) {
+            case pixel_declaration::pixel_type::rgb_etc1:
+            case pixel_declaration::pixel_type::rgb_pvrtc2:
+            case pixel_declaration::pixel_type::rgb_pvrtc4:
+            case pixel_declaration::pixel_type::rgba_pvrtc2:
+            case pixel_declaration::pixel_type::rgba_pvrtc4:
+            case pixel_declaration::pixel_type::rgba_pvrtc2_v2:
+            case pixel_declaration::pixel_type::rgba_pvrtc4_v2:
+                return false;
+            default:
+                return true;
+        }
+    }
+
+    std::size_t render::texture_uploader::upload_band_(upload& u) {
+        E2D_ASSERT(!pending_.empty() && pending_.front().get() == &u);
+        E2D_ASSERT(!u.ready());
+
+        const u32 level = u.uploaded_levels_;
+        const v2u size = u.source_->mipmap_size(level);
+        const buffer_view level_data = u.source_->mipmap_data(level);
+
+        // compressed bands are whole block rows, except the last one
+        const u32 rows = math::min(
+            band_height(u.decl_, size.x, byte_budget_),
+            size.y - u.uploaded_rows_);
+
+        const std::size_t offset = u.decl_.data_size_for_dimension(v2u(size.x, u.uploaded_rows_));
+        const std::size_t length = u.decl_.data_size_for_dimension(v2u(size.x, rows));
+        E2D_ASSERT(offset + length <= level_data.size());
+
+        backend_.update_texture(
+            u.texture_,
+            buffer_view(static_cast<const u8*>(level_data.data()) + offset, length),
+            b2u(0u, u.uploaded_rows_, size.x, rows),
+            level);
+
+        u.uploaded_rows_ += rows;
+        stats_.total_uploaded_bytes += length;
+
+        if ( u.uploaded_rows_ == size.y ) {
+            u.uploaded_rows_ = 0u;
+            ++u.uploaded_levels_;
+        }
+
+        if ( u.uploaded_levels_ == u.level_count_ ) {
+            // keeps the upload alive while its result callbacks run
+            const upload_ptr done = pending_.front();
+            pending_.erase(pending_.begin());
+            done->source_.reset();
+            done->result_.resolve(done->texture_);
+        }
+
+        return length;
+    }
+
+    //
+    // render::texture_upload_backend
+    //
+
+    render::texture_upload_backend::texture_upload_backend(render& render) noexcept
+    : render_(render) {}
+
+    texture_ptr render::texture_upload_backend::create_texture(
+        const image& image)
+    {
+        return render_.create_texture(image);
+    }
+
+    texture_ptr render::texture_upload_backend::create_texture(
+        const v2u& size,
+        const pixel_declaration& decl,
+        u32 mipmap_count)
+    {
+        return render_.create_texture(size, decl, mipmap_count);
+    }
+
+    void render::texture_upload_backend::update_texture(
+        const texture_ptr& tex,
+        buffer_view pixels,
+        const b2u& region,
+        u32 mipmap_level)
+    {
+        render_.update_texture(tex, pixels, region, mipmap_level);
+    }
+
+    u32 render::texture_upload_backend::texture_mipmap_count(
+        const texture_ptr& tex) const noexcept
+    {
+        return tex->mipmap_count();
+    }
+
     //
     // render
     //
@@ -1134,6 +1805,42 @@ namespace e2d
         std::visit(command_value_visitor(*this), command);
         return *this;
     }
+
+    render& render::execute(const command_queue& commands) {
+        E2D_ASSERT(is_in_main_thread());
+        for ( std::size_t i = 0, e = commands.command_count(); i < e; ++i ) {
+            execute(commands.command(i));
+        }
+        return *this;
+    }
+
+    render::texture_uploader::upload_ptr render::upload_texture(image image) {
+        return upload_texture(std::make_shared<const e2d::image>(std::move(image)));
+    }
+
+    render::texture_uploader& render::texture_uploads() noexcept {
+        return *texture_uploader_;
+    }
+
+    const render::texture_uploader& render::texture_uploads() const noexcept {
+        return *texture_uploader_;
+    }
+
+    void render::schedule_texture_uploads_() {
+        if ( texture_uploads_scheduled_ ) {
+            return;
+        }
+        // the deferrer runs tasks queued during a frame tick in the next one,
+        // so the budget is spent once per frame and synchronous waits still progress
+        the<deferrer>().do_in_main_thread(deferrer_priority::low, [this](){
+            texture_uploads_scheduled_ = false;
+            texture_uploader_->frame_tick();
+            if ( !texture_uploader_->empty() ) {
+                schedule_texture_uploads_();
+            }
+        });
+        texture_uploads_scheduled_ = true;
+    }
 }
 
 namespace e2d
@@ -7,5 +7,37 @@
 #pragma once
 
 #include <enduro2d/core/debug.hpp>
+#include <enduro2d/core/deferrer.hpp>
 #include <enduro2d/core/render.hpp>
 #include <enduro2d/core/window.hpp>
+
+namespace e2d
+{
+    //
+    // render::texture_upload_backend
+    //
+
+    class render::texture_upload_backend final : public render::texture_uploader::backend {
+    public:
+        explicit texture_upload_backend(render& render) noexcept;
+
+        texture_ptr create_texture(
+            const image& image) final;
+
+        texture_ptr create_texture(
+            const v2u& size,
+            const pixel_declaration& decl,
+            u32 mipmap_count) final;
+
+        void update_texture(
+            const texture_ptr& tex,
+            buffer_view pixels,
+            const b2u& region,
+            u32 mipmap_level) final;
+
+        u32 texture_mipmap_count(
+            const texture_ptr& tex) const noexcept final;
+    private:
+        render& render_;
+    };
+}
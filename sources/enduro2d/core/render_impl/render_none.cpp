@@ -109,6 +109,10 @@ namespace e2d
         return decl;
     }
 
+    u32 texture::mipmap_count() const noexcept {
+        return 1u;
+    }
+
     //
     // index_buffer
     //
@@ -169,7 +173,9 @@ namespace e2d
     //
 
     render::render(debug& d, window& w)
-    : state_(new internal_state(d, w)) {}
+    : state_(new internal_state(d, w))
+    , texture_upload_backend_(new texture_upload_backend(*this))
+    , texture_uploader_(new texture_uploader(*texture_upload_backend_)) {}
     render::~render() noexcept = default;
 
     shader_ptr render::create_shader(
@@ -193,8 +199,12 @@ namespace e2d
         return nullptr;
     }
 
-    texture_ptr render::create_texture(const v2u& size, const pixel_declaration& decl) {
-        E2D_UNUSED(size, decl);
+    texture_ptr render::create_texture(
+        const v2u& size,
+        const pixel_declaration& decl,
+        u32 mipmap_count)
+    {
+        E2D_UNUSED(size, decl, mipmap_count);
         return nullptr;
     }
 
@@ -207,6 +217,15 @@ namespace e2d
         return nullptr;
     }
 
+    index_buffer_ptr render::create_index_buffer(
+        std::size_t size,
+        const index_declaration& decl,
+        index_buffer::usage usage)
+    {
+        E2D_UNUSED(size, decl, usage);
+        return nullptr;
+    }
+
     vertex_buffer_ptr render::create_vertex_buffer(
         buffer_view vertices,
         const vertex_declaration& decl,
@@ -216,6 +235,15 @@ namespace e2d
         return nullptr;
     }
 
+    vertex_buffer_ptr render::create_vertex_buffer(
+        std::size_t size,
+        const vertex_declaration& decl,
+        vertex_buffer::usage usage)
+    {
+        E2D_UNUSED(size, decl, usage);
+        return nullptr;
+    }
+
     render_target_ptr render::create_render_target(
         const v2u& size,
         const pixel_declaration& color_decl,
@@ -264,6 +292,20 @@ namespace e2d
         return *this;
     }
 
+    render& render::orphan_buffer(
+        const index_buffer_ptr& ibuffer)
+    {
+        E2D_UNUSED(ibuffer);
+        return *this;
+    }
+
+    render& render::orphan_buffer(
+        const vertex_buffer_ptr& vbuffer)
+    {
+        E2D_UNUSED(vbuffer);
+        return *this;
+    }
+
     render& render::update_texture(
         const texture_ptr& tex,
         const image& img,
@@ -276,9 +318,10 @@ namespace e2d
     render& render::update_texture(
         const texture_ptr& tex,
         buffer_view pixels,
-        const b2u& region)
+        const b2u& region,
+        u32 mipmap_level)
     {
-        E2D_UNUSED(tex, pixels, region);
+        E2D_UNUSED(tex, pixels, region, mipmap_level);
         return *this;
     }
 
@@ -301,6 +344,16 @@ namespace e2d
         E2D_UNUSED(decl);
         return false;
     }
+
+    const render::state_cache::statistics& render::state_statistics() const noexcept {
+        static state_cache::statistics stats;
+        return stats;
+    }
+
+    render::texture_uploader::upload_ptr render::upload_texture(std::shared_ptr<const image> image) {
+        E2D_UNUSED(image);
+        return nullptr;
+    }
 }
 
 #endif
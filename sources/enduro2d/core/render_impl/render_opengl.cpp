@@ -80,208 +80,78 @@ namespace
     using namespace e2d;
     using namespace e2d::opengl;
 
-    class property_block_value_visitor final : private noncopyable {
-    public:
-        property_block_value_visitor(debug& debug, uniform_info ui) noexcept
-        : debug_(debug)
-        , ui_(std::move(ui)) {}
-
-        void operator()(i32 v) const noexcept {
-            if ( check_property_type(uniform_type::signed_integer) ) {
-                GL_CHECK_CODE(debug_, glUniform1i(ui_.location, v));
-            }
-        }
-
-        void operator()(f32 v) const noexcept {
-            if ( check_property_type(uniform_type::floating_point) ) {
-                GL_CHECK_CODE(debug_, glUniform1f(ui_.location, v));
-            }
-        }
-
-        void operator()(const v2i& v) const noexcept {
-            if ( check_property_type(uniform_type::v2i) ) {
-                GL_CHECK_CODE(debug_, glUniform2iv(ui_.location, 1, v.data()));
-            }
-        }
-
-        void operator()(const v3i& v) const noexcept {
-            if ( check_property_type(uniform_type::v3i) ) {
-                GL_CHECK_CODE(debug_, glUniform3iv(ui_.location, 1, v.data()));
-            }
-        }
+    index_buffer_ptr create_index_buffer_impl(
+        render& render,
+        debug& debug,
+        const void* data,
+        std::size_t size,
+        const index_declaration& decl,
+        index_buffer::usage usage)
+    {
+        E2D_ASSERT(size % decl.bytes_per_index() == 0);
 
-        void operator()(const v4i& v) const noexcept {
-            if ( check_property_type(uniform_type::v4i) ) {
-                GL_CHECK_CODE(debug_, glUniform4iv(ui_.location, 1, v.data()));
-            }
+        if ( !render.is_index_supported(decl) ) {
+            debug.error("RENDER: Failed to create index buffer:\n"
+                "--> Info: unsupported index declaration\n"
+                "--> Index type: %0",
+                decl.type());
+            return nullptr;
         }
 
-        void operator()(const v2f& v) const noexcept {
-            if ( check_property_type(uniform_type::v2f) ) {
-                GL_CHECK_CODE(debug_, glUniform2fv(ui_.location, 1, v.data()));
-            }
+        gl_buffer_id id = gl_buffer_id::create(debug, GL_ELEMENT_ARRAY_BUFFER);
+        if ( id.empty() ) {
+            debug.error("RENDER: Failed to create index buffer:\n"
+                "--> Info: failed to create index buffer id");
+            return nullptr;
         }
 
-        void operator()(const v3f& v) const noexcept {
-            if ( check_property_type(uniform_type::v3f) ) {
-                GL_CHECK_CODE(debug_, glUniform3fv(ui_.location, 1, v.data()));
-            }
-        }
+        with_gl_bind_buffer(debug, id, [&debug, &id, data, size, usage]() {
+            GL_CHECK_CODE(debug, glBufferData(
+                id.target(),
+                math::numeric_cast<GLsizeiptr>(size),
+                data,
+                convert_buffer_usage(usage)));
+        });
 
-        void operator()(const v4f& v) const noexcept {
-            if ( check_property_type(uniform_type::v4f) ) {
-                GL_CHECK_CODE(debug_, glUniform4fv(ui_.location, 1, v.data()));
-            }
-        }
+        return std::make_shared<index_buffer>(
+            std::make_unique<index_buffer::internal_state>(
+                debug, std::move(id), size, decl, usage));
+    }
 
-        void operator()(const m2f& v) const noexcept {
-            if ( check_property_type(uniform_type::m2f) ) {
-                GL_CHECK_CODE(debug_, glUniformMatrix2fv(ui_.location, 1, GL_TRUE, v.data()));
-            }
-        }
+    vertex_buffer_ptr create_vertex_buffer_impl(
+        render& render,
+        debug& debug,
+        const void* data,
+        std::size_t size,
+        const vertex_declaration& decl,
+        vertex_buffer::usage usage)
+    {
+        E2D_ASSERT(size % decl.bytes_per_vertex() == 0);
 
-        void operator()(const m3f& v) const noexcept {
-            if ( check_property_type(uniform_type::m3f) ) {
-                GL_CHECK_CODE(debug_, glUniformMatrix3fv(ui_.location, 1, GL_TRUE, v.data()));
-            }
+        if ( !render.is_vertex_supported(decl) ) {
+            debug.error("RENDER: Failed to create vertex buffer:\n"
+                "--> Info: unsupported vertex declaration");
+            return nullptr;
         }
 
-        void operator()(const m4f& v) const noexcept {
-            if ( check_property_type(uniform_type::m4f) ) {
-                GL_CHECK_CODE(debug_, glUniformMatrix4fv(ui_.location, 1, GL_TRUE, v.data()));
-            }
-        }
-    private:
-        bool check_property_type(uniform_type type) const noexcept {
-            if ( type == ui_.type ) {
-                return true;
-            }
-            E2D_ASSERT_MSG(false, "unexpected property type");
-            debug_.error("RENDER: unexpected property type:\n"
-                "--> Type: %0\n"
-                "--> Expected: %1",
-                type,
-                ui_.type);
-            return false;
+        gl_buffer_id id = gl_buffer_id::create(debug, GL_ARRAY_BUFFER);
+        if ( id.empty() ) {
+            debug.error("RENDER: Failed to create vertex buffer:\n"
+                "--> Info: failed to create vertex buffer id");
+            return nullptr;
         }
-    private:
-        debug& debug_;
-        uniform_info ui_;
-    };
 
-    void bind_property_block(
-        debug& debug,
-        const shader_ptr& ps,
-        const render::property_block& pb) noexcept
-    {
-        E2D_ASSERT(ps && gl_program_id::current(debug) == ps->state().id());
-        pb.foreach_by_properties([&debug, &ps](str_hash name, const render::property_value& value) noexcept {
-            ps->state().with_uniform_location(name, [&debug, &value](const uniform_info& ui) noexcept {
-                E2D_ASSERT(!value.valueless_by_exception());
-                std::visit(property_block_value_visitor(debug, ui), value);
-            });
-        });
-        GLint unit = 0;
-        pb.foreach_by_samplers([&debug, &ps, &unit](str_hash name, const render::sampler_state& sampler) noexcept {
-            ps->state().with_uniform_location(name, [&debug, &sampler, &unit](const uniform_info& ui) noexcept {
-                GL_CHECK_CODE(debug, glActiveTexture(
-                    math::numeric_cast<GLenum>(GL_TEXTURE0 + unit)));
-                GL_CHECK_CODE(debug, glUniform1i(
-                    ui.location, math::numeric_cast<GLint>(unit)));
-                if ( sampler.texture() ) {
-                    const gl_texture_id& texture_id = sampler.texture()->state().id();
-                    GL_CHECK_CODE(debug, glBindTexture(
-                        texture_id.target(), *texture_id));
-                    GL_CHECK_CODE(debug, glTexParameteri(
-                        texture_id.target(),
-                        GL_TEXTURE_WRAP_S,
-                        convert_sampler_wrap(sampler.s_wrap())));
-                    GL_CHECK_CODE(debug, glTexParameteri(
-                        texture_id.target(),
-                        GL_TEXTURE_WRAP_T,
-                        convert_sampler_wrap(sampler.t_wrap())));
-                    GL_CHECK_CODE(debug, glTexParameteri(
-                        texture_id.target(),
-                        GL_TEXTURE_MIN_FILTER,
-                        convert_sampler_filter(sampler.min_filter())));
-                    GL_CHECK_CODE(debug, glTexParameteri(
-                        texture_id.target(),
-                        GL_TEXTURE_MAG_FILTER,
-                        convert_sampler_filter(sampler.mag_filter())));
-                } else {
-                    GL_CHECK_CODE(debug, glBindTexture(GL_TEXTURE_2D, 0));
-                    GL_CHECK_CODE(debug, glBindTexture(GL_TEXTURE_CUBE_MAP, 0));
-                }
-                ++unit;
-            });
-        });
-    }
-
-    void unbind_property_block(
-        debug& debug,
-        const shader_ptr& ps,
-        const render::property_block& pb) noexcept
-    {
-        E2D_ASSERT(ps && gl_program_id::current(debug) == ps->state().id());
-        GLint unit = 0;
-        pb.foreach_by_samplers([&debug, &ps, &unit](str_hash name, const render::sampler_state& sampler) noexcept {
-            E2D_UNUSED(sampler);
-            ps->state().with_uniform_location(name, [&debug, &unit](const uniform_info& ui) noexcept {
-                E2D_UNUSED(ui);
-                GL_CHECK_CODE(debug, glActiveTexture(
-                    math::numeric_cast<GLenum>(GL_TEXTURE0 + unit)));
-                GL_CHECK_CODE(debug, glBindTexture(GL_TEXTURE_2D, 0));
-                GL_CHECK_CODE(debug, glBindTexture(GL_TEXTURE_CUBE_MAP, 0));
-                ++unit;
-            });
-        });
-    }
-
-    void bind_vertex_declaration(
-        debug& debug,
-        const shader_ptr& ps,
-        const vertex_buffer_ptr& vb) noexcept
-    {
-        E2D_ASSERT(ps && vb);
-        opengl::with_gl_bind_buffer(debug, vb->state().id(), [&debug, &ps, &vb]() noexcept {
-            const vertex_declaration& decl = vb->decl();
-            for ( std::size_t i = 0, e = decl.attribute_count(); i < e; ++i ) {
-                const vertex_declaration::attribute_info& vai = decl.attribute(i);
-                ps->state().with_attribute_location(vai.name, [&debug, &decl, &vai](const attribute_info& ai) noexcept {
-                    const GLuint rows = math::numeric_cast<GLuint>(vai.rows);
-                    for ( GLuint row = 0; row < rows; ++row ) {
-                        GL_CHECK_CODE(debug, glEnableVertexAttribArray(
-                            math::numeric_cast<GLuint>(ai.location) + row));
-                        GL_CHECK_CODE(debug, glVertexAttribPointer(
-                            math::numeric_cast<GLuint>(ai.location) + row,
-                            math::numeric_cast<GLint>(vai.columns),
-                            convert_attribute_type(vai.type),
-                            vai.normalized ? GL_TRUE : GL_FALSE,
-                            math::numeric_cast<GLsizei>(decl.bytes_per_vertex()),
-                            reinterpret_cast<const GLvoid*>(vai.stride + row * vai.row_size())));
-                    }
-                });
-            }
+        with_gl_bind_buffer(debug, id, [&debug, &id, data, size, usage]() {
+            GL_CHECK_CODE(debug, glBufferData(
+                id.target(),
+                math::numeric_cast<GLsizeiptr>(size),
+                data,
+                convert_buffer_usage(usage)));
         });
-    }
 
-    void unbind_vertex_declaration(
-        debug& debug,
-        const shader_ptr& ps,
-        const vertex_buffer_ptr& vb) noexcept
-    {
-        E2D_ASSERT(ps && vb);
-        const vertex_declaration& decl = vb->decl();
-        for ( std::size_t i = 0, e = decl.attribute_count(); i < e; ++i ) {
-            const vertex_declaration::attribute_info& vai = decl.attribute(i);
-            ps->state().with_attribute_location(vai.name, [&debug, &vai](const attribute_info& ai) noexcept {
-                const GLuint rows = math::numeric_cast<GLuint>(vai.rows);
-                for ( GLuint row = 0; row < rows; ++row ) {
-                    GL_CHECK_CODE(debug, glDisableVertexAttribArray(
-                        math::numeric_cast<GLuint>(ai.location) + row));
-                }
-            });
-        }
+        return std::make_shared<vertex_buffer>(
+            std::make_unique<vertex_buffer::internal_state>(
+                debug, std::move(id), size, decl, usage));
     }
 
     void draw_indexed_primitive(
@@ -303,64 +173,6 @@ namespace
             }
         });
     }
-
-    template < typename F, typename... Args >
-    void with_material_shader(
-        debug& debug,
-        const shader_ptr& ps,
-        const render::property_block& pb,
-        F&& f,
-        Args&&... args)
-    {
-        bind_property_block(debug, ps, pb);
-        try {
-            std::invoke(
-                std::forward<F>(f),
-                std::forward<Args>(args)...);
-        } catch (...) {
-            unbind_property_block(debug, ps, pb);
-            throw;
-        }
-        unbind_property_block(debug, ps, pb);
-    }
-
-    template < typename F, typename... Args >
-    void with_geometry_vertices(
-        debug& debug,
-        const shader_ptr& ps,
-        const render::geometry& geo,
-        F&& f,
-        Args&&... args)
-    {
-        for ( std::size_t i = 0, e = geo.vertices_count(); i < e; ++i ) {
-            const vertex_buffer_ptr& vb = geo.vertices(i);
-            if ( vb ) {
-                bind_vertex_declaration(debug, ps, vb);
-            }
-        }
-        try {
-            std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
-        } catch (...) {
-            for ( std::size_t i = 0, e = geo.vertices_count(); i < e; ++i ) {
-                const vertex_buffer_ptr& vb = geo.vertices(i);
-                if ( vb ) {
-                    unbind_vertex_declaration(debug, ps, vb);
-                }
-            }
-            throw;
-        }
-        for ( std::size_t i = 0, e = geo.vertices_count(); i < e; ++i ) {
-            const vertex_buffer_ptr& vb = geo.vertices(i);
-            if ( vb ) {
-                unbind_vertex_declaration(debug, ps, vb);
-            }
-        }
-    }
-
-    render::property_block& main_property_cache() {
-        static render::property_block props;
-        return props;
-    }
 }
 
 namespace e2d
@@ -401,6 +213,10 @@ namespace e2d
         return state_->decl();
     }
 
+    u32 texture::mipmap_count() const noexcept {
+        return state_->mipmap_count();
+    }
+
     //
     // index_buffer
     //
@@ -486,7 +302,9 @@ namespace e2d
     //
 
     render::render(debug& ndebug, window& nwindow)
-    : state_(new internal_state(ndebug, nwindow)) {
+    : state_(new internal_state(ndebug, nwindow))
+    , texture_upload_backend_(new texture_upload_backend(*this))
+    , texture_uploader_(new texture_uploader(*texture_upload_backend_)) {
         E2D_ASSERT(main_thread() == nwindow.main_thread());
     }
     render::~render() noexcept = default;
@@ -590,41 +408,64 @@ namespace e2d
             return nullptr;
         }
 
-        with_gl_bind_texture(state_->dbg(), id, [this, &id, &image, &decl]() noexcept {
-            if ( decl.is_compressed() ) {
-                GL_CHECK_CODE(state_->dbg(), glCompressedTexImage2D(
-                    id.target(),
-                    0,
-                    convert_pixel_type_to_internal_format_e(decl.type()),
-                    math::numeric_cast<GLsizei>(image.size().x),
-                    math::numeric_cast<GLsizei>(image.size().y),
-                    0,
-                    math::numeric_cast<GLsizei>(image.data().size()),
-                    image.data().data()));
-            } else {
-                GL_CHECK_CODE(state_->dbg(), glTexImage2D(
-                    id.target(),
-                    0,
-                    convert_pixel_type_to_internal_format(decl.type()),
-                    math::numeric_cast<GLsizei>(image.size().x),
-                    math::numeric_cast<GLsizei>(image.size().y),
-                    0,
-                    convert_image_data_format_to_external_format(image.format()),
-                    convert_image_data_format_to_external_data_type(image.format()),
-                    image.data().data()));
+        // without npot support only the first level of npot textures is usable
+        const u32 mipmap_count =
+            device_capabilities().npot_texture_supported
+            || (math::is_power_of_2(image.size().x) && math::is_power_of_2(image.size().y))
+                ? math::max(image.mipmap_count(), 1u)
+                : 1u;
+
+        with_gl_bind_texture(state_->dbg(), id, [this, &id, &image, &decl, mipmap_count]() noexcept {
+            for ( u32 level = 0; level < mipmap_count; ++level ) {
+                const v2u level_size = image.mipmap_size(level);
+                const buffer_view level_data = image.mipmap_data(level);
+                if ( decl.is_compressed() ) {
+                    GL_CHECK_CODE(state_->dbg(), glCompressedTexImage2D(
+                        id.target(),
+                        math::numeric_cast<GLint>(level),
+                        convert_pixel_type_to_internal_format_e(decl.type()),
+                        math::numeric_cast<GLsizei>(level_size.x),
+                        math::numeric_cast<GLsizei>(level_size.y),
+                        0,
+                        math::numeric_cast<GLsizei>(level_data.size()),
+                        level_data.data()));
+                } else {
+                    GL_CHECK_CODE(state_->dbg(), glTexImage2D(
+                        id.target(),
+                        math::numeric_cast<GLint>(level),
+                        convert_pixel_type_to_internal_format(decl.type()),
+                        math::numeric_cast<GLsizei>(level_size.x),
+                        math::numeric_cast<GLsizei>(level_size.y),
+                        0,
+                        convert_image_data_format_to_external_format(image.format()),
+                        convert_image_data_format_to_external_data_type(image.format()),
+                        level_data.data()));
+                }
             }
+        #if E2D_RENDER_MODE == E2D_RENDER_MODE_OPENGL
+            GL_CHECK_CODE(state_->dbg(), glTexParameteri(
+                id.target(),
+                GL_TEXTURE_MAX_LEVEL,
+                math::numeric_cast<GLint>(mipmap_count - 1u)));
+            GL_CHECK_CODE(state_->dbg(), glTexParameteri(
+                id.target(),
+                GL_TEXTURE_BASE_LEVEL,
+                0));
+        #endif
         });
 
         return std::make_shared<texture>(
             std::make_unique<texture::internal_state>(
-                state_->dbg(), std::move(id), image.size(), decl));
+                state_->dbg(), std::move(id), image.size(), decl, mipmap_count));
     }
 
     texture_ptr render::create_texture(
         const v2u& size,
-        const pixel_declaration& decl)
+        const pixel_declaration& decl,
+        u32 mipmap_count)
     {
         E2D_ASSERT(is_in_main_thread());
+        E2D_ASSERT(mipmap_count > 0u && mipmap_count <= images::max_mipmap_count(size));
 
         if ( !is_pixel_supported(decl) ) {
             state_->dbg().error("RENDER: Failed to create texture:\n"
@@ -666,35 +507,45 @@ namespace e2d
             return nullptr;
         }
 
-        with_gl_bind_texture(state_->dbg(), id, [this, &id, &size, &decl]() noexcept {
-            if ( decl.is_compressed() ) {
-                buffer empty_data(decl.data_size_for_dimension(size));
-                GL_CHECK_CODE(state_->dbg(), glCompressedTexImage2D(
-                    id.target(),
-                    0,
-                    convert_pixel_type_to_internal_format_e(decl.type()),
-                    math::numeric_cast<GLsizei>(size.x),
-                    math::numeric_cast<GLsizei>(size.y),
-                    0,
-                    math::numeric_cast<GLsizei>(empty_data.size()),
-                    empty_data.data()));
-            } else {
-                GL_CHECK_CODE(state_->dbg(), glTexImage2D(
-                    id.target(),
-                    0,
-                    convert_pixel_type_to_internal_format(decl.type()),
-                    math::numeric_cast<GLsizei>(size.x),
-                    math::numeric_cast<GLsizei>(size.y),
-                    0,
-                    convert_pixel_type_to_external_format(decl.type()),
-                    convert_pixel_type_to_external_data_type(decl.type()),
-                    nullptr));
+        // without npot support only the first level of npot textures is usable
+        if ( !device_capabilities().npot_texture_supported
+            && (!math::is_power_of_2(size.x) || !math::is_power_of_2(size.y)) )
+        {
+            mipmap_count = 1u;
+        }
+
+        with_gl_bind_texture(state_->dbg(), id, [this, &id, &size, &decl, mipmap_count]() noexcept {
+            for ( u32 level = 0; level < mipmap_count; ++level ) {
+                const v2u level_size = images::mipmap_size(size, level);
+                if ( decl.is_compressed() ) {
+                    buffer empty_data(decl.data_size_for_dimension(level_size));
+                    GL_CHECK_CODE(state_->dbg(), glCompressedTexImage2D(
+                        id.target(),
+                        math::numeric_cast<GLint>(level),
+                        convert_pixel_type_to_internal_format_e(decl.type()),
+                        math::numeric_cast<GLsizei>(level_size.x),
+                        math::numeric_cast<GLsizei>(level_size.y),
+                        0,
+                        math::numeric_cast<GLsizei>(empty_data.size()),
+                        empty_data.data()));
+                } else {
+                    GL_CHECK_CODE(state_->dbg(), glTexImage2D(
+                        id.target(),
+                        math::numeric_cast<GLint>(level),
+                        convert_pixel_type_to_internal_format(decl.type()),
+                        math::numeric_cast<GLsizei>(level_size.x),
+                        math::numeric_cast<GLsizei>(level_size.y),
+                        0,
+                        convert_pixel_type_to_external_format(decl.type()),
+                        convert_pixel_type_to_external_data_type(decl.type()),
+                        nullptr));
+                }
             }
         #if E2D_RENDER_MODE == E2D_RENDER_MODE_OPENGL
             GL_CHECK_CODE(state_->dbg(), glTexParameteri(
                 id.target(),
                 GL_TEXTURE_MAX_LEVEL,
-                0));
+                math::numeric_cast<GLint>(mipmap_count - 1u)));
             GL_CHECK_CODE(state_->dbg(), glTexParameteri(
                 id.target(),
                 GL_TEXTURE_BASE_LEVEL,
@@ -704,7 +555,7 @@ namespace e2d
 
         return std::make_shared<texture>(
             std::make_unique<texture::internal_state>(
-                state_->dbg(), std::move(id), size, decl));
+                state_->dbg(), std::move(id), size, decl, mipmap_count));
     }
 
     index_buffer_ptr render::create_index_buffer(
@@ -713,34 +564,18 @@ namespace e2d
         index_buffer::usage usage)
     {
         E2D_ASSERT(is_in_main_thread());
-        E2D_ASSERT(indices.size() % decl.bytes_per_index() == 0);
-
-        if ( !is_index_supported(decl) ) {
-            state_->dbg().error("RENDER: Failed to create index buffer:\n"
-                "--> Info: unsupported index declaration\n"
-                "--> Index type: %0",
-                decl.type());
-            return nullptr;
-        }
-
-        gl_buffer_id id = gl_buffer_id::create(state_->dbg(), GL_ELEMENT_ARRAY_BUFFER);
-        if ( id.empty() ) {
-            state_->dbg().error("RENDER: Failed to create index buffer:\n"
-                "--> Info: failed to create index buffer id");
-            return nullptr;
-        }
-
-        with_gl_bind_buffer(state_->dbg(), id, [this, &id, &indices, &usage]() {
-            GL_CHECK_CODE(state_->dbg(), glBufferData(
-                id.target(),
-                math::numeric_cast<GLsizeiptr>(indices.size()),
-                indices.data(),
-                convert_buffer_usage(usage)));
-        });
+        return create_index_buffer_impl(
+            *this, state_->dbg(), indices.data(), indices.size(), decl, usage);
+    }
 
-        return std::make_shared<index_buffer>(
-            std::make_unique<index_buffer::internal_state>(
-                state_->dbg(), std::move(id), indices.size(), decl));
+    index_buffer_ptr render::create_index_buffer(
+        std::size_t size,
+        const index_declaration& decl,
+        index_buffer::usage usage)
+    {
+        E2D_ASSERT(is_in_main_thread());
+        return create_index_buffer_impl(
+            *this, state_->dbg(), nullptr, size, decl, usage);
     }
 
     vertex_buffer_ptr render::create_vertex_buffer(
@@ -749,32 +584,18 @@ namespace e2d
         vertex_buffer::usage usage)
     {
         E2D_ASSERT(is_in_main_thread());
-        E2D_ASSERT(vertices.size() % decl.bytes_per_vertex() == 0);
-
-        if ( !is_vertex_supported(decl) ) {
-            state_->dbg().error("RENDER: Failed to create vertex buffer:\n"
-                "--> Info: unsupported vertex declaration");
-            return nullptr;
-        }
-
-        gl_buffer_id id = gl_buffer_id::create(state_->dbg(), GL_ARRAY_BUFFER);
-        if ( id.empty() ) {
-            state_->dbg().error("RENDER: Failed to create vertex buffer:\n"
-                "--> Info: failed to create vertex buffer id");
-            return nullptr;
-        }
-
-        with_gl_bind_buffer(state_->dbg(), id, [this, &id, &vertices, &usage]() {
-            GL_CHECK_CODE(state_->dbg(), glBufferData(
-                id.target(),
-                math::numeric_cast<GLsizeiptr>(vertices.size()),
-                vertices.data(),
-                convert_buffer_usage(usage)));
-        });
+        return create_vertex_buffer_impl(
+            *this, state_->dbg(), vertices.data(), vertices.size(), decl, usage);
+    }
 
-        return std::make_shared<vertex_buffer>(
-            std::make_unique<vertex_buffer::internal_state>(
-                state_->dbg(), std::move(id), vertices.size(), decl));
+    vertex_buffer_ptr render::create_vertex_buffer(
+        std::size_t size,
+        const vertex_declaration& decl,
+        vertex_buffer::usage usage)
+    {
+        E2D_ASSERT(is_in_main_thread());
+        return create_vertex_buffer_impl(
+            *this, state_->dbg(), nullptr, size, decl, usage);
     }
 
     render_target_ptr render::create_render_target(
@@ -914,28 +735,16 @@ namespace e2d
             if ( !pass.shader() || !geo.indices() ) {
                 continue;
             }
-            try {
-                const property_block& main_props = main_property_cache()
-                    .merge(mat.properties())
-                    .merge(pass.properties())
-                    .merge(props);
-                state_->set_states(pass.states());
-                state_->set_shader_program(pass.shader());
-                with_material_shader(state_->dbg(), pass.shader(), main_props, [this, &command, &pass, &geo]() noexcept {
-                    with_geometry_vertices(state_->dbg(), pass.shader(), command.geometry_ref(), [this, &command, &geo]() noexcept {
-                        draw_indexed_primitive(
-                            state_->dbg(),
-                            geo.topo(),
-                            geo.indices(),
-                            command.first_index(),
-                            command.index_count());
-                    });
-                });
-            } catch (...) {
-                main_property_cache().clear();
-                throw;
-            }
-            main_property_cache().clear();
+            state_->set_states(pass.states());
+            state_->set_shader_program(pass.shader());
+            state_->set_properties(mat.properties(), pass.properties(), props);
+            state_->set_vertices(geo);
+            draw_indexed_primitive(
+                state_->dbg(),
+                geo.topo(),
+                geo.indices(),
+                command.first_index(),
+                command.index_count());
         }
         return *this;
     }
@@ -1062,6 +871,38 @@ namespace e2d
         return *this;
     }
 
+    render& render::orphan_buffer(
+        const index_buffer_ptr& ibuffer)
+    {
+        E2D_ASSERT(is_in_main_thread());
+        E2D_ASSERT(ibuffer);
+        opengl::with_gl_bind_buffer(ibuffer->state().dbg(), ibuffer->state().id(),
+            [&ibuffer]() noexcept {
+                GL_CHECK_CODE(ibuffer->state().dbg(), glBufferData(
+                    ibuffer->state().id().target(),
+                    math::numeric_cast<GLsizeiptr>(ibuffer->state().size()),
+                    nullptr,
+                    convert_buffer_usage(ibuffer->state().usage())));
+            });
+        return *this;
+    }
+
+    render& render::orphan_buffer(
+        const vertex_buffer_ptr& vbuffer)
+    {
+        E2D_ASSERT(is_in_main_thread());
+        E2D_ASSERT(vbuffer);
+        opengl::with_gl_bind_buffer(vbuffer->state().dbg(), vbuffer->state().id(),
+            [&vbuffer]() noexcept {
+                GL_CHECK_CODE(vbuffer->state().dbg(), glBufferData(
+                    vbuffer->state().id().target(),
+                    math::numeric_cast<GLsizeiptr>(vbuffer->state().size()),
+                    nullptr,
+                    convert_buffer_usage(vbuffer->state().usage())));
+            });
+        return *this;
+    }
+
     render& render::update_texture(
         const texture_ptr& tex,
         const image& img,
@@ -1082,31 +923,38 @@ namespace e2d
             throw bad_render_operation();
         }
 
-        return update_texture(tex, img.data(), b2u(offset, img.size()));
+        return update_texture(tex, img.mipmap_data(0), b2u(offset, img.size()));
     }
 
     render& render::update_texture(
         const texture_ptr& tex,
         buffer_view pixels,
-        const b2u& region)
+        const b2u& region,
+        u32 mipmap_level)
     {
         E2D_ASSERT(is_in_main_thread());
         E2D_ASSERT(tex);
-        E2D_ASSERT(region.position.x < tex->size().x && region.position.y < tex->size().y);
-        E2D_ASSERT(region.position.x + region.size.x <= tex->size().x);
-        E2D_ASSERT(region.position.y + region.size.y <= tex->size().y);
+        E2D_ASSERT(mipmap_level < tex->mipmap_count());
+
+        const v2u level_size = images::mipmap_size(tex->size(), mipmap_level);
+        E2D_UNUSED(level_size);
+        E2D_ASSERT(region.position.x < level_size.x && region.position.y < level_size.y);
+        E2D_ASSERT(region.position.x + region.size.x <= level_size.x);
+        E2D_ASSERT(region.position.y + region.size.y <= level_size.y);
         E2D_ASSERT(pixels.size() == tex->decl().data_size_for_dimension(region.size));
 
         if ( tex->decl().is_compressed() ) {
             const v2u block_size = tex->decl().block_size();
             E2D_UNUSED(block_size);
             E2D_ASSERT(region.position.x % block_size.x == 0 && region.position.y % block_size.y == 0);
-            E2D_ASSERT(region.size.x % block_size.x == 0 && region.size.y % block_size.y == 0);
+            // partial blocks are allowed only at the level edges
+            E2D_ASSERT(region.size.x % block_size.x == 0 || region.position.x + region.size.x == level_size.x);
+            E2D_ASSERT(region.size.y % block_size.y == 0 || region.position.y + region.size.y == level_size.y);
             opengl::with_gl_bind_texture(state_->dbg(), tex->state().id(),
-                [&tex, &pixels, &region]() noexcept {
+                [&tex, &pixels, &region, mipmap_level]() noexcept {
                     GL_CHECK_CODE(tex->state().dbg(), glCompressedTexSubImage2D(
                         tex->state().id().target(),
-                        0,
+                        math::numeric_cast<GLint>(mipmap_level),
                         math::numeric_cast<GLint>(region.position.x),
                         math::numeric_cast<GLint>(region.position.y),
                         math::numeric_cast<GLsizei>(region.size.x),
@@ -1117,10 +965,10 @@ namespace e2d
                 });
         } else {
             opengl::with_gl_bind_texture(state_->dbg(), tex->state().id(),
-                [&tex, &pixels, &region]() noexcept {
+                [&tex, &pixels, &region, mipmap_level]() noexcept {
                     GL_CHECK_CODE(tex->state().dbg(), glTexSubImage2D(
                         tex->state().id().target(),
-                        0,
+                        math::numeric_cast<GLint>(mipmap_level),
                         math::numeric_cast<GLint>(region.position.x),
                         math::numeric_cast<GLint>(region.position.y),
                         math::numeric_cast<GLsizei>(region.size.x),
@@ -1217,6 +1065,28 @@ namespace e2d
         E2D_ASSERT(is_in_main_thread());
         return decl.attribute_count() <= device_capabilities().max_vertex_attributes;
     }
+
+    const render::state_cache::statistics& render::state_statistics() const noexcept {
+        E2D_ASSERT(is_in_main_thread());
+        return state_->state_statistics();
+    }
+
+    render::texture_uploader::upload_ptr render::upload_texture(std::shared_ptr<const image> image) {
+        E2D_ASSERT(is_in_main_thread());
+        E2D_ASSERT(image);
+
+        const pixel_declaration decl =
+            convert_image_data_format_to_pixel_declaration(image->format());
+        texture_uploader::upload_ptr upload = texture_uploader_->upload_texture(
+            std::move(image),
+            decl);
+
+        if ( upload && !upload->ready() ) {
+            schedule_texture_uploads_();
+        }
+
+        return upload;
+    }
 }
 
 #endif
@@ -959,6 +959,10 @@ namespace e2d::opengl
         switch ( f ) {
             DEFINE_CASE(nearest, GL_NEAREST);
             DEFINE_CASE(linear, GL_LINEAR);
+            DEFINE_CASE(nearest_mipmap_nearest, GL_NEAREST_MIPMAP_NEAREST);
+            DEFINE_CASE(linear_mipmap_nearest, GL_LINEAR_MIPMAP_NEAREST);
+            DEFINE_CASE(nearest_mipmap_linear, GL_NEAREST_MIPMAP_LINEAR);
+            DEFINE_CASE(linear_mipmap_linear, GL_LINEAR_MIPMAP_LINEAR);
             default:
                 E2D_ASSERT_MSG(false, "unexpected sampler min filter");
                 return 0;
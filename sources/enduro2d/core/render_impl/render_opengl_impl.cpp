@@ -93,6 +93,179 @@ namespace
             nullptr,
             GL_FALSE));
     }
+
+    class property_value_upload_visitor final : private noncopyable {
+    public:
+        property_value_upload_visitor(debug& debug, GLint location) noexcept
+        : debug_(debug)
+        , location_(location) {}
+
+        void operator()(i32 v) const noexcept {
+            GL_CHECK_CODE(debug_, glUniform1i(location_, v));
+        }
+
+        void operator()(f32 v) const noexcept {
+            GL_CHECK_CODE(debug_, glUniform1f(location_, v));
+        }
+
+        void operator()(const v2i& v) const noexcept {
+            GL_CHECK_CODE(debug_, glUniform2iv(location_, 1, v.data()));
+        }
+
+        void operator()(const v3i& v) const noexcept {
+            GL_CHECK_CODE(debug_, glUniform3iv(location_, 1, v.data()));
+        }
+
+        void operator()(const v4i& v) const noexcept {
+            GL_CHECK_CODE(debug_, glUniform4iv(location_, 1, v.data()));
+        }
+
+        void operator()(const v2f& v) const noexcept {
+            GL_CHECK_CODE(debug_, glUniform2fv(location_, 1, v.data()));
+        }
+
+        void operator()(const v3f& v) const noexcept {
+            GL_CHECK_CODE(debug_, glUniform3fv(location_, 1, v.data()));
+        }
+
+        void operator()(const v4f& v) const noexcept {
+            GL_CHECK_CODE(debug_, glUniform4fv(location_, 1, v.data()));
+        }
+
+        void operator()(const m2f& v) const noexcept {
+            GL_CHECK_CODE(debug_, glUniformMatrix2fv(location_, 1, GL_TRUE, v.data()));
+        }
+
+        void operator()(const m3f& v) const noexcept {
+            GL_CHECK_CODE(debug_, glUniformMatrix3fv(location_, 1, GL_TRUE, v.data()));
+        }
+
+        void operator()(const m4f& v) const noexcept {
+            GL_CHECK_CODE(debug_, glUniformMatrix4fv(location_, 1, GL_TRUE, v.data()));
+        }
+    private:
+        debug& debug_;
+        GLint location_ = -1;
+    };
+
+    struct property_value_type_visitor final {
+        uniform_type operator()(i32) const noexcept { return uniform_type::signed_integer; }
+        uniform_type operator()(f32) const noexcept { return uniform_type::floating_point; }
+        uniform_type operator()(const v2i&) const noexcept { return uniform_type::v2i; }
+        uniform_type operator()(const v3i&) const noexcept { return uniform_type::v3i; }
+        uniform_type operator()(const v4i&) const noexcept { return uniform_type::v4i; }
+        uniform_type operator()(const v2f&) const noexcept { return uniform_type::v2f; }
+        uniform_type operator()(const v3f&) const noexcept { return uniform_type::v3f; }
+        uniform_type operator()(const v4f&) const noexcept { return uniform_type::v4f; }
+        uniform_type operator()(const m2f&) const noexcept { return uniform_type::m2f; }
+        uniform_type operator()(const m3f&) const noexcept { return uniform_type::m3f; }
+        uniform_type operator()(const m4f&) const noexcept { return uniform_type::m4f; }
+    };
+
+    bool check_property_type(
+        debug& debug,
+        const uniform_info& ui,
+        const render::property_value& value) noexcept
+    {
+        const uniform_type type = std::visit(property_value_type_visitor(), value);
+        if ( type == ui.type ) {
+            return true;
+        }
+        E2D_ASSERT_MSG(false, "unexpected property type");
+        debug.error("RENDER: unexpected property type:\n"
+            "--> Type: %0\n"
+            "--> Expected: %1",
+            type,
+            ui.type);
+        return false;
+    }
+    bool is_mipmap_filter(render::sampler_min_filter filter) noexcept {
+        return filter != render::sampler_min_filter::nearest
+            && filter != render::sampler_min_filter::linear;
+    }
+
+    render::sampler_min_filter without_mipmap_filter(render::sampler_min_filter filter) noexcept {
+        switch ( filter ) {
+            case render::sampler_min_filter::nearest_mipmap_nearest:
+            case render::sampler_min_filter::nearest_mipmap_linear:
+                return render::sampler_min_filter::nearest;
+            case render::sampler_min_filter::linear_mipmap_nearest:
+            case render::sampler_min_filter::linear_mipmap_linear:
+                return render::sampler_min_filter::linear;
+            default:
+                return filter;
+        }
+    }
+}
+
+namespace e2d::opengl
+{
+    //
+    // gl_state_cache_backend
+    //
+
+    gl_state_cache_backend::gl_state_cache_backend(debug& debug) noexcept
+    : debug_(debug) {}
+
+    void gl_state_cache_backend::use_program(u32 program) noexcept {
+        GL_CHECK_CODE(debug_, glUseProgram(
+            math::numeric_cast<GLuint>(program)));
+    }
+
+    void gl_state_cache_backend::set_uniform(i32 location, const render::property_value& value) noexcept {
+        E2D_ASSERT(!value.valueless_by_exception());
+        std::visit(property_value_upload_visitor(
+            debug_, math::numeric_cast<GLint>(location)), value);
+    }
+
+    void gl_state_cache_backend::active_texture(u32 unit) noexcept {
+        GL_CHECK_CODE(debug_, glActiveTexture(
+            math::numeric_cast<GLenum>(GL_TEXTURE0 + unit)));
+    }
+
+    void gl_state_cache_backend::bind_texture(u32 target, u32 texture) noexcept {
+        GL_CHECK_CODE(debug_, glBindTexture(
+            math::numeric_cast<GLenum>(target),
+            math::numeric_cast<GLuint>(texture)));
+    }
+
+    void gl_state_cache_backend::set_texture_s_wrap(u32 target, render::sampler_wrap wrap) noexcept {
+        GL_CHECK_CODE(debug_, glTexParameteri(
+            math::numeric_cast<GLenum>(target),
+            GL_TEXTURE_WRAP_S,
+            convert_sampler_wrap(wrap)));
+    }
+
+    void gl_state_cache_backend::set_texture_t_wrap(u32 target, render::sampler_wrap wrap) noexcept {
+        GL_CHECK_CODE(debug_, glTexParameteri(
+            math::numeric_cast<GLenum>(target),
+            GL_TEXTURE_WRAP_T,
+            convert_sampler_wrap(wrap)));
+    }
+
+    void gl_state_cache_backend::set_texture_min_filter(u32 target, render::sampler_min_filter filter) noexcept {
+        GL_CHECK_CODE(debug_, glTexParameteri(
+            math::numeric_cast<GLenum>(target),
+            GL_TEXTURE_MIN_FILTER,
+            convert_sampler_filter(filter)));
+    }
+
+    void gl_state_cache_backend::set_texture_mag_filter(u32 target, render::sampler_mag_filter filter) noexcept {
+        GL_CHECK_CODE(debug_, glTexParameteri(
+            math::numeric_cast<GLenum>(target),
+            GL_TEXTURE_MAG_FILTER,
+            convert_sampler_filter(filter)));
+    }
+
+    void gl_state_cache_backend::enable_attribute(u32 index) noexcept {
+        GL_CHECK_CODE(debug_, glEnableVertexAttribArray(
+            math::numeric_cast<GLuint>(index)));
+    }
+
+    void gl_state_cache_backend::disable_attribute(u32 index) noexcept {
+        GL_CHECK_CODE(debug_, glDisableVertexAttribArray(
+            math::numeric_cast<GLuint>(index)));
+    }
 }
 
 namespace e2d
@@ -121,6 +294,21 @@ namespace e2d
         for ( const auto& info : attributes ) {
             attributes_.emplace(info.name, info);
         }
+
+        for ( const auto& info : uniforms ) {
+            const bool sampler =
+                info.type == uniform_type::sampler_2d ||
+                info.type == uniform_type::sampler_cube;
+            (sampler ? sampler_slots_ : property_slots_).push_back(info);
+        }
+
+        const auto name_less = [](const uniform_info& l, const uniform_info& r) noexcept {
+            return l.name < r.name;
+        };
+        std::sort(property_slots_.begin(), property_slots_.end(), name_less);
+        std::sort(sampler_slots_.begin(), sampler_slots_.end(), name_less);
+
+        uniform_cache_.resize(property_slots_.size() + sampler_slots_.size());
     }
 
     debug& shader::internal_state::dbg() const noexcept {
@@ -131,6 +319,18 @@ namespace e2d
         return id_;
     }
 
+    render::state_cache::uniform_values& shader::internal_state::uniform_cache() const noexcept {
+        return uniform_cache_;
+    }
+
+    const vector<uniform_info>& shader::internal_state::property_slots() const noexcept {
+        return property_slots_;
+    }
+
+    const vector<uniform_info>& shader::internal_state::sampler_slots() const noexcept {
+        return sampler_slots_;
+    }
+
     //
     // texture::internal_state
     //
@@ -139,12 +339,15 @@ namespace e2d
         debug& debug,
         gl_texture_id id,
         const v2u& size,
-        const pixel_declaration& decl)
+        const pixel_declaration& decl,
+        u32 mipmap_count)
     : debug_(debug)
     , id_(std::move(id))
     , size_(size)
-    , decl_(decl){
+    , decl_(decl)
+    , mipmap_count_(mipmap_count) {
         E2D_ASSERT(!id_.empty());
+        E2D_ASSERT(mipmap_count_ > 0u);
     }
 
     debug& texture::internal_state::dbg() const noexcept {
@@ -163,6 +366,14 @@ namespace e2d
         return decl_;
     }
 
+    u32 texture::internal_state::mipmap_count() const noexcept {
+        return mipmap_count_;
+    }
+
+    render::state_cache::sampler_values& texture::internal_state::sampler_cache() const noexcept {
+        return sampler_cache_;
+    }
+
     //
     // index_buffer::internal_state
     //
@@ -171,11 +382,13 @@ namespace e2d
         debug& debug,
         gl_buffer_id id,
         std::size_t size,
-        const index_declaration& decl)
+        const index_declaration& decl,
+        index_buffer::usage usage)
     : debug_(debug)
     , id_(std::move(id))
     , size_(size)
-    , decl_(decl) {
+    , decl_(decl)
+    , usage_(usage) {
         E2D_ASSERT(!id_.empty());
     }
 
@@ -195,6 +408,10 @@ namespace e2d
         return decl_;
     }
 
+    index_buffer::usage index_buffer::internal_state::usage() const noexcept {
+        return usage_;
+    }
+
     //
     // vertex_buffer::internal_state
     //
@@ -203,11 +420,13 @@ namespace e2d
         debug& debug,
         gl_buffer_id id,
         std::size_t size,
-        const vertex_declaration& decl)
+        const vertex_declaration& decl,
+        vertex_buffer::usage usage)
     : debug_(debug)
     , id_(std::move(id))
     , size_(size)
-    , decl_(decl) {
+    , decl_(decl)
+    , usage_(usage) {
         E2D_ASSERT(!id_.empty());
     }
 
@@ -227,6 +446,10 @@ namespace e2d
         return decl_;
     }
 
+    vertex_buffer::usage vertex_buffer::internal_state::usage() const noexcept {
+        return usage_;
+    }
+
     //
     // render_target::internal_state
     //
@@ -283,6 +506,8 @@ namespace e2d
     render::internal_state::internal_state(debug& debug, window& window)
     : debug_(debug)
     , window_(window)
+    , state_backend_(debug)
+    , state_cache_(state_backend_)
     , default_sp_(gl_program_id::current(debug))
     , default_fb_(gl_framebuffer_id::current(debug, GL_FRAMEBUFFER))
     {
@@ -315,6 +540,10 @@ namespace e2d
         return render_target_;
     }
 
+    const render::state_cache::statistics& render::internal_state::state_statistics() const noexcept {
+        return state_cache_.stats();
+    }
+
     render::internal_state& render::internal_state::reset_states() noexcept {
         set_depth_state_(state_block_.depth());
         set_stencil_state_(state_block_.stencil());
@@ -357,19 +586,16 @@ namespace e2d
         const gl_program_id& sp_id = shader_program_
             ? shader_program_->state().id()
             : default_sp_;
-        GL_CHECK_CODE(debug_, glUseProgram(*sp_id));
+        state_cache_.invalidate();
+        state_cache_.use_program(*sp_id);
         return *this;
     }
 
     render::internal_state& render::internal_state::set_shader_program(const shader_ptr& sp) noexcept {
-        if ( sp == shader_program_ ) {
-            return *this;
-        }
-
         const gl_program_id& sp_id = sp
             ? sp->state().id()
             : default_sp_;
-        GL_CHECK_CODE(debug_, glUseProgram(*sp_id));
+        state_cache_.use_program(*sp_id);
 
         shader_program_ = sp;
         return *this;
@@ -397,6 +623,113 @@ namespace e2d
         return *this;
     }
 
+    render::internal_state& render::internal_state::set_properties(
+        const property_block& material_props,
+        const property_block& pass_props,
+        const property_block& command_props)
+    {
+        E2D_ASSERT(shader_program_);
+        const shader::internal_state& sp = shader_program_->state();
+
+        // command properties override pass ones, pass properties override material ones
+        const vector<uniform_info>& property_slots = sp.property_slots();
+        for ( std::size_t slot = 0, e = property_slots.size(); slot < e; ++slot ) {
+            const uniform_info& ui = property_slots[slot];
+            const property_value* value = command_props.property(ui.name);
+            if ( !value ) {
+                value = pass_props.property(ui.name);
+            }
+            if ( !value ) {
+                value = material_props.property(ui.name);
+            }
+            if ( value && check_property_type(debug_, ui, *value) ) {
+                state_cache_.set_uniform(sp.uniform_cache(), slot, ui.location, *value);
+            }
+        }
+
+        const vector<uniform_info>& sampler_slots = sp.sampler_slots();
+        if ( texture_units_.size() < sampler_slots.size() ) {
+            texture_units_.resize(sampler_slots.size());
+        }
+        for ( std::size_t slot = 0, e = sampler_slots.size(); slot < e; ++slot ) {
+            const uniform_info& ui = sampler_slots[slot];
+            const sampler_state* sampler = command_props.sampler(ui.name);
+            if ( !sampler ) {
+                sampler = pass_props.sampler(ui.name);
+            }
+            if ( !sampler ) {
+                sampler = material_props.sampler(ui.name);
+            }
+            if ( !sampler ) {
+                continue;
+            }
+
+            const u32 unit = math::numeric_cast<u32>(slot);
+            state_cache_.set_uniform(
+                sp.uniform_cache(),
+                property_slots.size() + slot,
+                ui.location,
+                property_value(math::numeric_cast<i32>(unit)));
+
+            if ( sampler->texture() ) {
+                const texture::internal_state& ts = sampler->texture()->state();
+                state_cache_.bind_texture(unit, ts.id().target(), *ts.id());
+                if ( ts.mipmap_count() == 1u && is_mipmap_filter(sampler->min_filter()) ) {
+                    // textures without mipmaps are incomplete with mipmap filters
+                    const sampler_state fallback = sampler_state(*sampler)
+                        .min_filter(without_mipmap_filter(sampler->min_filter()));
+                    state_cache_.set_sampler(ts.sampler_cache(), unit, ts.id().target(), fallback);
+                } else {
+                    state_cache_.set_sampler(ts.sampler_cache(), unit, ts.id().target(), *sampler);
+                }
+            } else {
+                state_cache_.bind_texture(unit, GL_TEXTURE_2D, 0);
+                state_cache_.bind_texture(unit, GL_TEXTURE_CUBE_MAP, 0);
+            }
+
+            // bound textures are kept alive, otherwise their ids may be reused
+            texture_units_[slot] = sampler->texture();
+        }
+
+        return *this;
+    }
+
+    render::internal_state& render::internal_state::set_vertices(const geometry& geo) {
+        E2D_ASSERT(shader_program_);
+        const shader::internal_state& sp = shader_program_->state();
+
+        state_cache_.begin_attributes();
+        for ( std::size_t i = 0, e = geo.vertices_count(); i < e; ++i ) {
+            const vertex_buffer_ptr& vb = geo.vertices(i);
+            if ( !vb ) {
+                continue;
+            }
+            with_gl_bind_buffer(debug_, vb->state().id(), [this, &sp, &vb]() {
+                const vertex_declaration& decl = vb->decl();
+                for ( std::size_t j = 0, je = decl.attribute_count(); j < je; ++j ) {
+                    const vertex_declaration::attribute_info& vai = decl.attribute(j);
+                    sp.with_attribute_location(vai.name, [this, &decl, &vai](const attribute_info& ai) {
+                        const GLuint rows = math::numeric_cast<GLuint>(vai.rows);
+                        for ( GLuint row = 0; row < rows; ++row ) {
+                            const GLuint index = math::numeric_cast<GLuint>(ai.location) + row;
+                            state_cache_.enable_attribute(index);
+                            GL_CHECK_CODE(debug_, glVertexAttribPointer(
+                                index,
+                                math::numeric_cast<GLint>(vai.columns),
+                                convert_attribute_type(vai.type),
+                                vai.normalized ? GL_TRUE : GL_FALSE,
+                                math::numeric_cast<GLsizei>(decl.bytes_per_vertex()),
+                                reinterpret_cast<const GLvoid*>(vai.stride + row * vai.row_size())));
+                        }
+                    });
+                }
+            });
+        }
+        state_cache_.end_attributes();
+
+        return *this;
+    }
+
     void render::internal_state::set_depth_state_(const depth_state& ds) noexcept {
     #if E2D_RENDER_MODE == E2D_RENDER_MODE_OPENGL
         GL_CHECK_CODE(debug_, glDepthRange(
@@ -12,6 +12,35 @@
 #if defined(E2D_RENDER_MODE)
 #if E2D_RENDER_MODE == E2D_RENDER_MODE_OPENGL || E2D_RENDER_MODE == E2D_RENDER_MODE_OPENGLES
 
+namespace e2d::opengl
+{
+    //
+    // gl_state_cache_backend
+    //
+
+    class gl_state_cache_backend final : public render::state_cache::backend {
+    public:
+        gl_state_cache_backend(debug& debug) noexcept;
+        ~gl_state_cache_backend() noexcept final = default;
+
+        void use_program(u32 program) noexcept final;
+        void set_uniform(i32 location, const render::property_value& value) noexcept final;
+
+        void active_texture(u32 unit) noexcept final;
+        void bind_texture(u32 target, u32 texture) noexcept final;
+
+        void set_texture_s_wrap(u32 target, render::sampler_wrap wrap) noexcept final;
+        void set_texture_t_wrap(u32 target, render::sampler_wrap wrap) noexcept final;
+        void set_texture_min_filter(u32 target, render::sampler_min_filter filter) noexcept final;
+        void set_texture_mag_filter(u32 target, render::sampler_mag_filter filter) noexcept final;
+
+        void enable_attribute(u32 index) noexcept final;
+        void disable_attribute(u32 index) noexcept final;
+    private:
+        debug& debug_;
+    };
+}
+
 namespace e2d
 {
     //
@@ -27,6 +56,12 @@ namespace e2d
     public:
         debug& dbg() const noexcept;
         const opengl::gl_program_id& id() const noexcept;
+        render::state_cache::uniform_values& uniform_cache() const noexcept;
+    public:
+        // property slots come first in the uniform cache, sampler slots follow them,
+        // a sampler slot index is also its texture unit
+        const vector<opengl::uniform_info>& property_slots() const noexcept;
+        const vector<opengl::uniform_info>& sampler_slots() const noexcept;
     public:
         template < typename F >
         void with_uniform_location(str_hash name, F&& f) const;
@@ -37,6 +72,9 @@ namespace e2d
         opengl::gl_program_id id_;
         hash_map<str_hash, opengl::uniform_info> uniforms_;
         hash_map<str_hash, opengl::attribute_info> attributes_;
+        vector<opengl::uniform_info> property_slots_;
+        vector<opengl::uniform_info> sampler_slots_;
+        mutable render::state_cache::uniform_values uniform_cache_;
     };
 
     template < typename F >
@@ -65,18 +103,23 @@ namespace e2d
             debug& debug,
             opengl::gl_texture_id id,
             const v2u& size,
-            const pixel_declaration& decl);
+            const pixel_declaration& decl,
+            u32 mipmap_count);
         ~internal_state() noexcept = default;
     public:
         debug& dbg() const noexcept;
         const opengl::gl_texture_id& id() const noexcept;
         const v2u& size() const noexcept;
         const pixel_declaration& decl() const noexcept;
+        u32 mipmap_count() const noexcept;
+        render::state_cache::sampler_values& sampler_cache() const noexcept;
     private:
         debug& debug_;
         opengl::gl_texture_id id_;
         v2u size_;
         pixel_declaration decl_;
+        u32 mipmap_count_ = 1u;
+        mutable render::state_cache::sampler_values sampler_cache_;
     };
 
     //
@@ -89,18 +132,21 @@ namespace e2d
             debug& debug,
             opengl::gl_buffer_id id,
             std::size_t size,
-            const index_declaration& decl);
+            const index_declaration& decl,
+            index_buffer::usage usage);
         ~internal_state() noexcept = default;
     public:
         debug& dbg() const noexcept;
         const opengl::gl_buffer_id& id() const noexcept;
         std::size_t size() const noexcept;
         const index_declaration& decl() const noexcept;
+        index_buffer::usage usage() const noexcept;
     private:
         debug& debug_;
         opengl::gl_buffer_id id_;
         std::size_t size_ = 0;
         index_declaration decl_;
+        index_buffer::usage usage_;
     };
 
     //
@@ -113,18 +159,21 @@ namespace e2d
             debug& debug,
             opengl::gl_buffer_id id,
             std::size_t size,
-            const vertex_declaration& decl);
+            const vertex_declaration& decl,
+            vertex_buffer::usage usage);
         ~internal_state() noexcept = default;
     public:
         debug& dbg() const noexcept;
         const opengl::gl_buffer_id& id() const noexcept;
         std::size_t size() const noexcept;
         const vertex_declaration& decl() const noexcept;
+        vertex_buffer::usage usage() const noexcept;
     private:
         debug& debug_;
         opengl::gl_buffer_id id_;
         std::size_t size_ = 0;
         vertex_declaration decl_;
+        vertex_buffer::usage usage_;
     };
 
     //
@@ -175,6 +224,7 @@ namespace e2d
         window& wnd() const noexcept;
         const device_caps& device_capabilities() const noexcept;
         const render_target_ptr& render_target() const noexcept;
+        const state_cache::statistics& state_statistics() const noexcept;
     public:
         internal_state& reset_states() noexcept;
         internal_state& set_states(const state_block& sb) noexcept;
@@ -184,6 +234,12 @@ namespace e2d
 
         internal_state& reset_render_target() noexcept;
         internal_state& set_render_target(const render_target_ptr& rt) noexcept;
+
+        internal_state& set_properties(
+            const property_block& material_props,
+            const property_block& pass_props,
+            const property_block& command_props);
+        internal_state& set_vertices(const geometry& geo);
     private:
         void set_depth_state_(const depth_state& ds) noexcept;
         void set_stencil_state_(const stencil_state& ss) noexcept;
@@ -197,6 +253,9 @@ namespace e2d
         state_block state_block_;
         shader_ptr shader_program_;
         render_target_ptr render_target_;
+        vector<texture_ptr> texture_units_;
+        opengl::gl_state_cache_backend state_backend_;
+        state_cache state_cache_;
         opengl::gl_program_id default_sp_;
         opengl::gl_framebuffer_id default_fb_;
     };
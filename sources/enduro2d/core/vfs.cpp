@@ -21,9 +21,9 @@ namespace
         OwnedState owned_state_;
         iter_state_uptr iter_state_;
     public:
-        archive_stream(const OwnedState& owned_state, mz_zip_archive* archive, const char* filename)
+        archive_stream(const OwnedState& owned_state, mz_zip_archive* archive, mz_uint32 index)
         : owned_state_(owned_state)
-        , iter_state_(open_iter_state_(archive, filename))
+        , iter_state_(open_iter_state_(archive, index))
         {
             if ( !iter_state_ ) {
                 throw bad_vfs_operation();
@@ -56,9 +56,9 @@ namespace
                 iter_state_->file_stat.m_uncomp_size);
         }
     private:
-        static iter_state_uptr open_iter_state_(mz_zip_archive* archive, const char* filename) noexcept {
-            mz_zip_reader_extract_iter_state* iter_state = mz_zip_reader_extract_file_iter_new(
-                archive, filename, MZ_ZIP_FLAG_CASE_SENSITIVE);
+        static iter_state_uptr open_iter_state_(mz_zip_archive* archive, mz_uint32 index) noexcept {
+            mz_zip_reader_extract_iter_state* iter_state = mz_zip_reader_extract_iter_new(
+                archive, index, 0);
             return iter_state_uptr(iter_state, state_deleter_);
         }
 
@@ -68,110 +68,519 @@ namespace
             }
         }
     };
+
+    class buffered_mapped_file final : public mapped_file {
+    public:
+        buffered_mapped_file(str path, buffer content) noexcept
+        : path_(std::move(path))
+        , content_(std::move(content)) {}
+
+        buffer_view content() const noexcept final {
+            return content_;
+        }
+
+        const str& path() const noexcept final {
+            return path_;
+        }
+    private:
+        str path_;
+        buffer content_;
+    };
+
+    std::size_t seek_position(
+        std::size_t pos,
+        std::size_t length,
+        std::ptrdiff_t offset,
+        bool relative)
+    {
+        const std::ptrdiff_t npos = relative
+            ? math::numeric_cast<std::ptrdiff_t>(pos) + offset
+            : offset;
+        if ( npos < 0 || math::numeric_cast<std::size_t>(npos) > length ) {
+            throw bad_vfs_operation();
+        }
+        return math::numeric_cast<std::size_t>(npos);
+    }
+
+    // stored entries are read right from the archive stream, so they are seekable
+    template < typename OwnedState >
+    class archive_stored_stream final : public input_stream {
+        OwnedState owned_state_;
+        std::size_t offset_ = 0;
+        std::size_t length_ = 0;
+        std::size_t pos_ = 0;
+    public:
+        archive_stored_stream(const OwnedState& owned_state, std::size_t offset, std::size_t length)
+        : owned_state_(owned_state)
+        , offset_(offset)
+        , length_(length) {}
+
+        std::size_t read(void* dst, std::size_t size) final {
+            const std::size_t read_bytes = math::min(size, length_ - pos_);
+            if ( read_bytes > 0u ) {
+                std::lock_guard<std::mutex> guard(owned_state_.stream->mutex);
+                if ( !input_sequence(*owned_state_.stream->stream)
+                    .seek(math::numeric_cast<std::ptrdiff_t>(offset_ + pos_), false)
+                    .read(dst, read_bytes)
+                    .success() )
+                {
+                    throw bad_vfs_operation();
+                }
+            }
+            pos_ += read_bytes;
+            return read_bytes;
+        }
+
+        std::size_t seek(std::ptrdiff_t offset, bool relative) final {
+            pos_ = seek_position(pos_, length_, offset, relative);
+            return pos_;
+        }
+
+        std::size_t tell() const final {
+            return pos_;
+        }
+
+        std::size_t length() const noexcept final {
+            return length_;
+        }
+    };
+
+    using shared_buffer = std::shared_ptr<const buffer>;
+
+    class shared_buffer_stream final : public input_stream {
+        shared_buffer content_;
+        std::size_t pos_ = 0;
+    public:
+        shared_buffer_stream(shared_buffer content) noexcept
+        : content_(std::move(content)) {}
+
+        std::size_t read(void* dst, std::size_t size) final {
+            const std::size_t read_bytes = math::min(size, content_->size() - pos_);
+            if ( read_bytes > 0u ) {
+                std::memcpy(dst, content_->data() + pos_, read_bytes);
+            }
+            pos_ += read_bytes;
+            return read_bytes;
+        }
+
+        std::size_t seek(std::ptrdiff_t offset, bool relative) final {
+            pos_ = seek_position(pos_, content_->size(), offset, relative);
+            return pos_;
+        }
+
+        std::size_t tell() const final {
+            return pos_;
+        }
+
+        std::size_t length() const noexcept final {
+            return content_->size();
+        }
+    };
+
+    class shared_buffer_mapped_file final : public mapped_file {
+    public:
+        shared_buffer_mapped_file(str path, shared_buffer content) noexcept
+        : path_(std::move(path))
+        , content_(std::move(content)) {}
+
+        buffer_view content() const noexcept final {
+            return *content_;
+        }
+
+        const str& path() const noexcept final {
+            return path_;
+        }
+    private:
+        str path_;
+        shared_buffer content_;
+    };
+
+    class archive_entry_cache final : private noncopyable {
+    public:
+        archive_entry_cache(std::size_t budget) noexcept
+        : budget_(budget) {}
+
+        std::size_t budget() const noexcept {
+            return budget_;
+        }
+
+        std::size_t size() const noexcept {
+            std::lock_guard<std::mutex> guard(mutex_);
+            return size_;
+        }
+
+        shared_buffer find(mz_uint32 index) {
+            std::lock_guard<std::mutex> guard(mutex_);
+            const auto iter = items_.find(index);
+            if ( iter == items_.end() ) {
+                return nullptr;
+            }
+            if ( head_ != index ) {
+                unlink_(iter->second);
+                link_front_(iter->second, index);
+            }
+            return iter->second.content;
+        }
+
+        void insert(mz_uint32 index, const shared_buffer& content) {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if ( content->size() > budget_ || items_.count(index) ) {
+                return;
+            }
+            while ( size_ + content->size() > budget_ ) {
+                // the tail item is the least recently used one
+                const auto lru_iter = items_.find(tail_);
+                unlink_(lru_iter->second);
+                size_ -= lru_iter->second.content->size();
+                items_.erase(lru_iter);
+            }
+            item& i = items_[index];
+            i.content = content;
+            link_front_(i, index);
+            size_ += content->size();
+        }
+    private:
+        static constexpr mz_uint32 no_index = std::numeric_limits<mz_uint32>::max();
+
+        // items are linked from the most recently used (head_)
+        // to the least recently used one (tail_)
+        struct item {
+            shared_buffer content;
+            mz_uint32 prev{no_index};
+            mz_uint32 next{no_index};
+        };
+
+        void unlink_(item& i) noexcept {
+            if ( i.prev != no_index ) {
+                items_.find(i.prev)->second.next = i.next;
+            } else {
+                head_ = i.next;
+            }
+            if ( i.next != no_index ) {
+                items_.find(i.next)->second.prev = i.prev;
+            } else {
+                tail_ = i.prev;
+            }
+            i.prev = i.next = no_index;
+        }
+
+        void link_front_(item& i, mz_uint32 index) noexcept {
+            i.prev = no_index;
+            i.next = head_;
+            if ( head_ != no_index ) {
+                items_.find(head_)->second.prev = index;
+            } else {
+                tail_ = index;
+            }
+            head_ = index;
+        }
+    private:
+        mutable std::mutex mutex_;
+        std::size_t budget_{0u};
+        std::size_t size_{0u};
+        mz_uint32 head_{no_index};
+        mz_uint32 tail_{no_index};
+        hash_map<mz_uint32, item> items_;
+    };
+
+    // bytes of a pack file, either mapped or read through a shared stream
+    class pack_data final : private noncopyable {
+    public:
+        pack_data(mapped_file_uptr file) noexcept
+        : file_(std::move(file)) {}
+
+        pack_data(input_stream_uptr stream) noexcept
+        : stream_(std::move(stream)) {}
+
+        bool valid() const noexcept {
+            return file_ || stream_;
+        }
+
+        bool mapped() const noexcept {
+            return !!file_;
+        }
+
+        buffer_view view(std::size_t offset, std::size_t size) const {
+            E2D_ASSERT(mapped());
+            const buffer_view content = file_->content();
+            if ( offset > content.size() || size > content.size() - offset ) {
+                throw bad_vfs_operation();
+            }
+            return size
+                ? buffer_view(static_cast<const u8*>(content.data()) + offset, size)
+                : buffer_view();
+        }
+
+        void read(std::size_t offset, void* dst, std::size_t size) {
+            if ( mapped() ) {
+                const buffer_view src = view(offset, size);
+                if ( size > 0u ) {
+                    std::memcpy(dst, src.data(), size);
+                }
+                return;
+            }
+            std::lock_guard<std::mutex> guard(mutex_);
+            if ( !input_sequence(*stream_)
+                .seek(math::numeric_cast<std::ptrdiff_t>(offset), false)
+                .read(dst, size)
+                .success() )
+            {
+                throw bad_vfs_operation();
+            }
+        }
+
+        bool load_toc(pack& dst) {
+            if ( mapped() ) {
+                return packs::try_load_pack(dst, file_->content());
+            }
+            std::lock_guard<std::mutex> guard(mutex_);
+            return packs::try_load_pack(dst, stream_);
+        }
+    private:
+        mapped_file_uptr file_;
+        std::mutex mutex_;
+        input_stream_uptr stream_;
+    };
+    using pack_data_ptr = std::shared_ptr<pack_data>;
+
+    class pack_entry_stream final : public input_stream {
+        pack_data_ptr data_;
+        std::size_t offset_ = 0;
+        std::size_t length_ = 0;
+        std::size_t pos_ = 0;
+    public:
+        pack_entry_stream(pack_data_ptr data, std::size_t offset, std::size_t length) noexcept
+        : data_(std::move(data))
+        , offset_(offset)
+        , length_(length) {}
+
+        std::size_t read(void* dst, std::size_t size) final {
+            const std::size_t read_bytes = math::min(size, length_ - pos_);
+            if ( read_bytes > 0u ) {
+                data_->read(offset_ + pos_, dst, read_bytes);
+            }
+            pos_ += read_bytes;
+            return read_bytes;
+        }
+
+        std::size_t seek(std::ptrdiff_t offset, bool relative) final {
+            pos_ = seek_position(pos_, length_, offset, relative);
+            return pos_;
+        }
+
+        std::size_t tell() const final {
+            return pos_;
+        }
+
+        std::size_t length() const noexcept final {
+            return length_;
+        }
+    };
+
+    class pack_mapped_entry final : public mapped_file {
+    public:
+        pack_mapped_entry(str path, pack_data_ptr data, buffer_view content) noexcept
+        : path_(std::move(path))
+        , data_(std::move(data))
+        , content_(content) {}
+
+        buffer_view content() const noexcept final {
+            return content_;
+        }
+
+        const str& path() const noexcept final {
+            return path_;
+        }
+    private:
+        str path_;
+        pack_data_ptr data_;
+        buffer_view content_;
+    };
 }
 
 namespace e2d
 {
+    //
+    // vfs::file_source
+    //
+
+    mapped_file_uptr vfs::file_source::map(str_view path) const {
+        buffer content;
+        const input_stream_uptr stream = read(path);
+        if ( !stream || !streams::try_read_tail(content, stream) ) {
+            return nullptr;
+        }
+        return std::make_unique<buffered_mapped_file>(
+            str(path),
+            std::move(content));
+    }
+
     //
     // vfs
     //
 
     class vfs::state final : private e2d::noncopyable {
     public:
-        std::mutex mutex;
-        stdex::jobber worker{1};
-        flat_map<str, url> aliases;
-        flat_map<str, file_source_uptr> schemes;
+        using file_source_sptr = std::shared_ptr<file_source>;
+
+        // immutable after publishing, readers never lock
+        struct snapshot {
+            flat_map<str, url> aliases;
+            flat_map<str, file_source_sptr> schemes;
+        };
+        using snapshot_ptr = std::shared_ptr<const snapshot>;
     public:
-        url resolve_url(const url& url, u8 level = 0) const {
+        state(u32 worker_threads)
+        : snapshot_(std::make_shared<snapshot>())
+        , worker(worker_threads) {}
+
+        snapshot_ptr load_snapshot() const noexcept {
+            return std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+        }
+
+        // writers are serialized, each one publishes a modified copy
+        template < typename F >
+        bool update_snapshot(F&& f) {
+            std::lock_guard<std::mutex> guard(write_mutex_);
+            auto next = std::make_shared<snapshot>(*load_snapshot());
+            if ( !std::invoke(std::forward<F>(f), *next) ) {
+                return false;
+            }
+            std::atomic_store_explicit(
+                &snapshot_,
+                snapshot_ptr(std::move(next)),
+                std::memory_order_release);
+            return true;
+        }
+
+        static url resolve_url(const snapshot& snap, const url& url, u8 level = 0) {
             if ( level > 32 ) {
                 throw bad_vfs_operation();
             }
-            const auto alias_iter = aliases.find(url.scheme());
-            return alias_iter != aliases.cend()
-                ? resolve_url(alias_iter->second / url.path(), level + 1)
+            const auto alias_iter = snap.aliases.find(url.scheme());
+            return alias_iter != snap.aliases.cend()
+                ? resolve_url(snap, alias_iter->second / url.path(), level + 1)
                 : url;
         }
 
         template < typename F, typename R >
         R with_file_source(const url& url, F&& f, R&& fallback_result) const {
-            const auto resolved_url = resolve_url(url);
-            const auto scheme_iter = schemes.find(resolved_url.scheme());
-            return (scheme_iter != schemes.cend() && scheme_iter->second)
+            // the snapshot keeps the source alive even if it is unregistered meanwhile
+            const snapshot_ptr snap = load_snapshot();
+            const auto resolved_url = resolve_url(*snap, url);
+            const auto scheme_iter = snap->schemes.find(resolved_url.scheme());
+            return (scheme_iter != snap->schemes.cend() && scheme_iter->second)
                 ? std::invoke(
                     std::forward<F>(f),
-                    scheme_iter->second,
+                    *scheme_iter->second,
                     resolved_url.path())
                 : std::forward<R>(fallback_result);
         }
+    private:
+        std::mutex write_mutex_;
+        snapshot_ptr snapshot_;
+    public:
+        // declared last to join the workers before anything else is destroyed
+        stdex::jobber worker;
     };
 
     vfs::vfs()
-    : state_(new state()){}
+    : vfs(0u) {}
+
+    vfs::vfs(u32 worker_threads)
+    : state_(new state(worker_threads
+        ? worker_threads
+        : math::clamp(std::thread::hardware_concurrency(), 2u, 4u))) {}
+
     vfs::~vfs() noexcept = default;
 
     stdex::jobber& vfs::worker() noexcept {
-        std::lock_guard<std::mutex> guard(state_->mutex);
         return state_->worker;
     }
 
     const stdex::jobber& vfs::worker() const noexcept {
-        std::lock_guard<std::mutex> guard(state_->mutex);
         return state_->worker;
     }
 
     bool vfs::register_scheme(str_view scheme, file_source_uptr source) {
-        std::lock_guard<std::mutex> guard(state_->mutex);
-        return (source && source->valid())
-            ? state_->schemes.emplace(scheme, std::move(source)).second
-            : false;
+        if ( !source || !source->valid() ) {
+            return false;
+        }
+        return state_->update_snapshot([scheme, &source](state::snapshot& snap){
+            return snap.schemes.emplace(scheme, std::move(source)).second;
+        });
     }
 
     bool vfs::unregister_scheme(str_view scheme) noexcept {
-        std::lock_guard<std::mutex> guard(state_->mutex);
-        const auto iter = state_->schemes.find(scheme);
-        return iter != state_->schemes.end()
-            ? (state_->schemes.erase(iter), true)
-            : false;
+        try {
+            return state_->update_snapshot([scheme](state::snapshot& snap){
+                const auto iter = snap.schemes.find(scheme);
+                return iter != snap.schemes.end()
+                    ? (snap.schemes.erase(iter), true)
+                    : false;
+            });
+        } catch (...) {
+            return false;
+        }
     }
 
     bool vfs::register_scheme_alias(str_view scheme, url alias) {
-        std::lock_guard<std::mutex> guard(state_->mutex);
-        return state_->aliases.emplace(scheme, std::move(alias)).second;
+        return state_->update_snapshot([scheme, &alias](state::snapshot& snap){
+            return snap.aliases.emplace(scheme, std::move(alias)).second;
+        });
     }
 
     bool vfs::unregister_scheme_alias(str_view scheme) noexcept {
-        std::lock_guard<std::mutex> guard(state_->mutex);
-        const auto iter = state_->aliases.find(scheme);
-        return iter != state_->aliases.end()
-            ? (state_->aliases.erase(iter), true)
-            : false;
+        try {
+            return state_->update_snapshot([scheme](state::snapshot& snap){
+                const auto iter = snap.aliases.find(scheme);
+                return iter != snap.aliases.end()
+                    ? (snap.aliases.erase(iter), true)
+                    : false;
+            });
+        } catch (...) {
+            return false;
+        }
     }
 
     bool vfs::exists(const url& url) const {
-        std::lock_guard<std::mutex> guard(state_->mutex);
         return state_->with_file_source(url,
-            [](const file_source_uptr& source, const str& path) {
-                return source->exists(path);
+            [](const file_source& source, const str& path) {
+                return source.exists(path);
             }, false);
     }
 
     input_stream_uptr vfs::read(const url& url) const {
-        std::lock_guard<std::mutex> guard(state_->mutex);
         return state_->with_file_source(url,
-            [](const file_source_uptr& source, const str& path) {
-                return source->read(path);
+            [](const file_source& source, const str& path) {
+                return source.read(path);
             }, input_stream_uptr());
     }
 
     output_stream_uptr vfs::write(const url& url, bool append) const {
-        std::lock_guard<std::mutex> guard(state_->mutex);
         return state_->with_file_source(url,
-            [&append](const file_source_uptr& source, const str& path) {
-                return source->write(path, append);
+            [&append](const file_source& source, const str& path) {
+                return source.write(path, append);
             }, output_stream_uptr());
     }
 
+    mapped_file_uptr vfs::map(const url& url) const {
+        return state_->with_file_source(url,
+            [](const file_source& source, const str& path) {
+                return source.map(path);
+            }, mapped_file_uptr());
+    }
+
+    stdex::promise<mapped_file_sptr> vfs::map_async(const url& url) const {
+        return state_->worker.async([this, url](){
+            mapped_file_sptr file = map(url);
+            if ( !file ) {
+                throw vfs_load_async_exception();
+            }
+            return file;
+        });
+    }
+
     std::optional<buffer> vfs::load(const url& url) const {
         return load_async(url).then([](auto&& src){
             return std::optional<buffer>(std::forward<decltype(src)>(src));
@@ -207,16 +616,14 @@ namespace e2d
     }
 
     bool vfs::trace(const url& url, filesystem::trace_func func) const {
-        std::lock_guard<std::mutex> guard(state_->mutex);
         return state_->with_file_source(url,
-            [&func](const file_source_uptr& source, const str& path) {
-                return source->trace(path, func);
+            [&func](const file_source& source, const str& path) {
+                return source.trace(path, func);
             }, false);
     }
 
     url vfs::resolve_scheme_aliases(const url& url) const {
-        std::lock_guard<std::mutex> guard(state_->mutex);
-        return state_->resolve_url(url);
+        return state::resolve_url(*state_->load_snapshot(), url);
     }
 
     //
@@ -225,24 +632,133 @@ namespace e2d
 
     class archive_file_source::state final : private e2d::noncopyable {
     public:
+        // several vfs workers can read entries of one archive at the same
+        // time, so seeking and reading of the shared stream is serialized
+        struct archive_io {
+            std::mutex mutex;
+            input_stream_uptr stream;
+        };
+        struct entry {
+            str name;
+            mz_uint32 index{0u};
+            bool directory{false};
+            bool stored{false};
+            std::size_t size{0u};
+            std::size_t header_offset{0u};
+        };
         using archive_ptr = std::shared_ptr<mz_zip_archive>;
-        using stream_ptr = std::shared_ptr<input_stream>;
-        archive_ptr archive;
+        using stream_ptr = std::shared_ptr<archive_io>;
         stream_ptr stream;
+        archive_ptr archive;
+        vector<entry> entries;
+        hash_map<str, std::size_t> entry_index;
+        vector<std::size_t> sorted_entries;
+        archive_entry_cache cache;
     public:
-        state(input_stream_uptr nstream)
-        : archive(open_archive_(nstream))
-        , stream(std::move(nstream)) {}
+        state(input_stream_uptr nstream, std::size_t cache_budget)
+        : stream(open_stream_(std::move(nstream)))
+        , archive(open_archive_(stream))
+        , cache(cache_budget)
+        {
+            if ( archive ) {
+                build_index_();
+            }
+        }
         ~state() noexcept = default;
+
+        const entry* find_entry(str_view path) const {
+            const auto iter = entry_index.find(make_utf8(path));
+            return iter != entry_index.end()
+                ? &entries[iter->second]
+                : nullptr;
+        }
+
+        std::size_t find_data_offset(const entry& e) const {
+            // local header: signature, ..., name length at 26, extra length at 28
+            u8 header[30] = {0};
+            std::lock_guard<std::mutex> guard(stream->mutex);
+            if ( !input_sequence(*stream->stream)
+                .seek(math::numeric_cast<std::ptrdiff_t>(e.header_offset), false)
+                .read(header, sizeof(header))
+                .success() )
+            {
+                throw bad_vfs_operation();
+            }
+            if ( header[0] != 0x50 || header[1] != 0x4b || header[2] != 0x03 || header[3] != 0x04 ) {
+                throw bad_vfs_operation();
+            }
+            const std::size_t name_length = header[26] | (header[27] << 8u);
+            const std::size_t extra_length = header[28] | (header[29] << 8u);
+            return e.header_offset + sizeof(header) + name_length + extra_length;
+        }
+
+        // returns null if the cache is disabled or the entry doesn't fit in it
+        shared_buffer cached_content(const entry& e) {
+            if ( e.size > cache.budget() ) {
+                return nullptr;
+            }
+            if ( shared_buffer content = cache.find(e.index) ) {
+                return content;
+            }
+            buffer content(e.size);
+            if ( !content.empty() && !mz_zip_reader_extract_to_mem(
+                archive.get(),
+                e.index,
+                content.data(),
+                content.size(),
+                0) )
+            {
+                throw bad_vfs_operation();
+            }
+            auto shared_content = std::make_shared<const buffer>(std::move(content));
+            cache.insert(e.index, shared_content);
+            return shared_content;
+        }
     private:
-        static archive_ptr open_archive_(const input_stream_uptr& stream) noexcept {
-            if ( stream ) {
+        void build_index_() {
+            const mz_uint num_files = mz_zip_reader_get_num_files(archive.get());
+            entries.reserve(num_files);
+            entry_index.reserve(num_files);
+            for ( mz_uint i = 0; i < num_files; ++i ) {
+                mz_zip_archive_file_stat file_stat;
+                if ( !mz_zip_reader_file_stat(archive.get(), i, &file_stat) ) {
+                    continue;
+                }
+                entry e;
+                e.name = file_stat.m_filename;
+                e.index = i;
+                e.directory = !!file_stat.m_is_directory;
+                e.stored = !file_stat.m_method
+                    && !file_stat.m_is_encrypted
+                    && !!file_stat.m_is_supported;
+                e.size = math::numeric_cast<std::size_t>(file_stat.m_uncomp_size);
+                e.header_offset = math::numeric_cast<std::size_t>(file_stat.m_local_header_ofs);
+                if ( entry_index.emplace(e.name, entries.size()).second ) {
+                    entries.push_back(std::move(e));
+                }
+            }
+            sorted_entries.resize(entries.size());
+            std::iota(sorted_entries.begin(), sorted_entries.end(), std::size_t(0u));
+            std::sort(sorted_entries.begin(), sorted_entries.end(),
+                [this](std::size_t l, std::size_t r) noexcept {
+                    return entries[l].name < entries[r].name;
+                });
+        }
+
+        static stream_ptr open_stream_(input_stream_uptr stream) {
+            auto io = std::make_shared<archive_io>();
+            io->stream = std::move(stream);
+            return io;
+        }
+
+        static archive_ptr open_archive_(const stream_ptr& io) noexcept {
+            if ( io->stream ) {
                 mz_zip_archive* archive = static_cast<mz_zip_archive*>(
                     std::calloc(1, sizeof(mz_zip_archive)));
                 if ( archive ) {
                     archive->m_pRead = archive_reader_;
-                    archive->m_pIO_opaque = stream.get();
-                    if ( mz_zip_reader_init(archive, stream->length(), 0) ) {
+                    archive->m_pIO_opaque = io.get();
+                    if ( mz_zip_reader_init(archive, io->stream->length(), 0) ) {
                         return archive_ptr(archive, archive_deleter_);
                     }
                     std::free(archive);
@@ -259,16 +775,17 @@ namespace e2d
         }
 
         static size_t archive_reader_(void* opaque, mz_uint64 pos, void* dst, size_t size) noexcept {
-            input_stream* stream = static_cast<input_stream*>(opaque);
-            return input_sequence(*stream)
+            archive_io* io = static_cast<archive_io*>(opaque);
+            std::lock_guard<std::mutex> guard(io->mutex);
+            return input_sequence(*io->stream)
                 .seek(math::numeric_cast<std::ptrdiff_t>(pos), false)
                 .read(dst, size)
                 .success() ? size : 0;
         }
     };
 
-    archive_file_source::archive_file_source(input_stream_uptr stream)
-    : state_(new state(std::move(stream))) {}
+    archive_file_source::archive_file_source(input_stream_uptr stream, std::size_t cache_budget)
+    : state_(new state(std::move(stream), cache_budget)) {}
     archive_file_source::~archive_file_source() noexcept = default;
 
     bool archive_file_source::valid() const noexcept {
@@ -276,23 +793,32 @@ namespace e2d
     }
 
     bool archive_file_source::exists(str_view path) const {
-        return -1 != mz_zip_reader_locate_file(
-            state_->archive.get(),
-            make_utf8(path).c_str(),
-            nullptr,
-            MZ_ZIP_FLAG_CASE_SENSITIVE);
+        return !!state_->find_entry(path);
     }
 
     input_stream_uptr archive_file_source::read(str_view path) const {
         try {
+            const state::entry* entry = state_->find_entry(path);
+            if ( !entry ) {
+                return nullptr;
+            }
             struct owned_state_t {
                 state::archive_ptr archive;
                 state::stream_ptr stream;
             } owned_state{state_->archive, state_->stream};
+            if ( entry->stored ) {
+                return std::make_unique<archive_stored_stream<owned_state_t>>(
+                    owned_state,
+                    state_->find_data_offset(*entry),
+                    entry->size);
+            }
+            if ( shared_buffer content = state_->cached_content(*entry) ) {
+                return std::make_unique<shared_buffer_stream>(std::move(content));
+            }
             return std::make_unique<archive_stream<owned_state_t>>(
                 std::move(owned_state),
                 state_->archive.get(),
-                make_utf8(path).c_str());
+                entry->index);
         } catch (...) {
             return nullptr;
         }
@@ -309,40 +835,232 @@ namespace e2d
             if ( parent.back() != '/' ) {
                 parent += '/';
             }
-            mz_uint32 dir_index = 0;
-            if ( !mz_zip_reader_locate_file_v2(
-                state_->archive.get(),
-                parent.c_str(),
-                nullptr,
-                MZ_ZIP_FLAG_CASE_SENSITIVE,
-                &dir_index) )
-            {
+            const state::entry* dir = state_->find_entry(parent);
+            if ( !dir || !dir->directory ) {
                 return false;
             }
-            mz_zip_archive_file_stat dir_stat;
-            if ( !mz_zip_reader_file_stat(
-                state_->archive.get(),
-                dir_index, &dir_stat) )
-            {
-                return false;
+        }
+
+        // entries with a common prefix are adjacent in the sorted index
+        const auto& entries = state_->entries;
+        const auto& sorted_entries = state_->sorted_entries;
+        auto iter = std::lower_bound(
+            sorted_entries.begin(), sorted_entries.end(), parent,
+            [&entries](std::size_t l, const str& r) noexcept {
+                return entries[l].name < r;
+            });
+
+        vector<std::size_t> children;
+        for ( ; iter != sorted_entries.end(); ++iter ) {
+            const str& filename = entries[*iter].name;
+            if ( !strings::starts_with(filename, parent) ) {
+                break;
             }
-            if ( !dir_stat.m_is_directory ) {
-                return false;
+            if ( filename.size() > parent.size() ) {
+                children.push_back(*iter);
+            }
+        }
+
+        // report children in the archive order
+        std::sort(children.begin(), children.end());
+        for ( std::size_t child : children ) {
+            func(entries[child].name, entries[child].directory);
+        }
+        return true;
+    }
+
+    mapped_file_uptr archive_file_source::map(str_view path) const {
+        try {
+            const state::entry* entry = state_->find_entry(path);
+            if ( !entry ) {
+                return nullptr;
             }
+            if ( !entry->stored ) {
+                if ( shared_buffer content = state_->cached_content(*entry) ) {
+                    return std::make_unique<shared_buffer_mapped_file>(
+                        str(path),
+                        std::move(content));
+                }
+            }
+        } catch (...) {
+            return nullptr;
         }
-        mz_uint num_files = mz_zip_reader_get_num_files(state_->archive.get());
-        for ( mz_uint i = 0; i < num_files; ++i ) {
-            mz_zip_archive_file_stat file_stat;
-            if ( mz_zip_reader_file_stat(state_->archive.get(), i, &file_stat) ) {
-                const str_view filename{file_stat.m_filename};
-                if ( filename.size() > parent.size() && strings::starts_with(filename, parent) ) {
-                    func(file_stat.m_filename, !!file_stat.m_is_directory);
+        return vfs::file_source::map(path);
+    }
+
+    std::size_t archive_file_source::cache_budget() const noexcept {
+        return state_->cache.budget();
+    }
+
+    std::size_t archive_file_source::cache_size() const noexcept {
+        return state_->cache.size();
+    }
+
+    //
+    // pack_file_source
+    //
+
+    class pack_file_source::state final : private e2d::noncopyable {
+    public:
+        pack_data_ptr data;
+        pack toc;
+        bool valid{false};
+    public:
+        state(pack_data_ptr ndata, u32 worker_threads)
+        : data(std::move(ndata))
+        , worker_(worker_threads
+            ? worker_threads
+            : math::clamp(std::thread::hardware_concurrency(), 1u, 4u))
+        {
+            valid = data->valid() && data->load_toc(toc);
+        }
+        ~state() noexcept = default;
+
+        buffer inflate_entry(const pack::entry& e) {
+            E2D_ASSERT(e.method == pack::compression::deflate);
+            buffer content(e.size);
+            if ( e.chunk_count == 1u ) {
+                inflate_chunk_(e, 0u, content);
+                return content;
+            }
+
+            // chunks are independent deflate streams, so they are inflated in parallel
+            vector<stdex::promise<void>> chunks;
+            chunks.reserve(e.chunk_count);
+            for ( std::size_t i = 0; i < e.chunk_count; ++i ) {
+                chunks.push_back(worker_.async([this, &e, &content, i](){
+                    inflate_chunk_(e, i, content);
+                }));
+            }
+
+            // every task refers to the content, so all of them must be finished
+            for ( const auto& chunk : chunks ) {
+                chunk.wait();
+            }
+            for ( const auto& chunk : chunks ) {
+                chunk.get();
+            }
+            return content;
+        }
+    private:
+        void inflate_chunk_(const pack::entry& e, std::size_t index, buffer& content) {
+            const pack::chunk& c = toc.chunk_at(e.first_chunk + index);
+            const std::size_t offset = index * pack::chunk_size;
+            const std::size_t size = math::min(pack::chunk_size, e.size - offset);
+
+            buffer stored;
+            buffer_view src;
+            if ( data->mapped() ) {
+                src = data->view(c.offset, c.stored_size);
+            } else {
+                stored.resize(c.stored_size);
+                data->read(c.offset, stored.data(), stored.size());
+                src = stored;
+            }
+
+            if ( !packs::try_inflate_chunk(content.data() + offset, size, src) ) {
+                throw bad_vfs_operation();
+            }
+        }
+    private:
+        stdex::jobber worker_;
+    };
+
+    pack_file_source::pack_file_source(mapped_file_uptr file, u32 worker_threads)
+    : state_(new state(std::make_shared<pack_data>(std::move(file)), worker_threads)) {}
+
+    pack_file_source::pack_file_source(input_stream_uptr stream, u32 worker_threads)
+    : state_(new state(std::make_shared<pack_data>(std::move(stream)), worker_threads)) {}
+
+    pack_file_source::~pack_file_source() noexcept = default;
+
+    bool pack_file_source::valid() const noexcept {
+        return state_->valid;
+    }
+
+    bool pack_file_source::exists(str_view path) const {
+        return !!state_->toc.find_entry(path);
+    }
+
+    input_stream_uptr pack_file_source::read(str_view path) const {
+        try {
+            const pack::entry* entry = state_->toc.find_entry(path);
+            if ( !entry ) {
+                return nullptr;
+            }
+            if ( entry->method == pack::compression::none ) {
+                return std::make_unique<pack_entry_stream>(
+                    state_->data,
+                    entry->offset,
+                    entry->size);
+            }
+            return make_memory_stream(state_->inflate_entry(*entry));
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+    output_stream_uptr pack_file_source::write(str_view path, bool append) const {
+        E2D_UNUSED(path, append);
+        return nullptr;
+    }
+
+    bool pack_file_source::trace(str_view path, filesystem::trace_func func) const {
+        str parent = make_utf8(path);
+        if ( !parent.empty() && parent.back() != '/' ) {
+            parent += '/';
+        }
+
+        const auto [first, last] = state_->toc.find_prefix(parent);
+        if ( !parent.empty() && first == last ) {
+            return false;
+        }
+
+        // packs store files only, directories are derived from their paths
+        str last_directory;
+        for ( std::size_t i = first; i < last; ++i ) {
+            const str& filename = state_->toc.entry_at(i).path;
+            for ( std::size_t sep = filename.find('/', parent.size());
+                sep != str::npos;
+                sep = filename.find('/', sep + 1u) )
+            {
+                const str_view directory(filename.data(), sep + 1u);
+                if ( !strings::starts_with(last_directory, directory) ) {
+                    func(directory, true);
                 }
             }
+            const std::size_t sep = filename.rfind('/');
+            last_directory = sep != str::npos
+                ? filename.substr(0u, sep + 1u)
+                : str();
+            func(filename, false);
         }
         return true;
     }
 
+    mapped_file_uptr pack_file_source::map(str_view path) const {
+        try {
+            const pack::entry* entry = state_->toc.find_entry(path);
+            if ( !entry ) {
+                return nullptr;
+            }
+            if ( entry->method == pack::compression::deflate ) {
+                return std::make_unique<buffered_mapped_file>(
+                    str(path),
+                    state_->inflate_entry(*entry));
+            }
+            if ( state_->data->mapped() ) {
+                return std::make_unique<pack_mapped_entry>(
+                    str(path),
+                    state_->data,
+                    state_->data->view(entry->offset, entry->size));
+            }
+        } catch (...) {
+            return nullptr;
+        }
+        return vfs::file_source::map(path);
+    }
+
     //
     // filesystem_file_source
     //
@@ -372,4 +1090,8 @@ namespace e2d
     bool filesystem_file_source::trace(str_view path, filesystem::trace_func func) const {
         return filesystem::trace_directory_recursive(path, func);
     }
+
+    mapped_file_uptr filesystem_file_source::map(str_view path) const {
+        return make_mapped_file(path);
+    }
 }
@@ -0,0 +1,70 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/high/asset.hpp>
+
+namespace
+{
+    using namespace e2d;
+
+    template < typename T >
+    std::size_t vector_memory_usage(const vector<T>& v) noexcept {
+        return v.size() * sizeof(T);
+    }
+}
+
+namespace e2d::impl
+{
+    std::size_t content_memory_usage(const str& content) noexcept {
+        return content.size();
+    }
+
+    std::size_t content_memory_usage(const buffer& content) noexcept {
+        return content.size();
+    }
+
+    std::size_t content_memory_usage(const image& content) noexcept {
+        return content.data().size();
+    }
+
+    std::size_t content_memory_usage(const mesh& content) noexcept {
+        std::size_t result =
+            vector_memory_usage(content.vertices()) +
+            vector_memory_usage(content.normals()) +
+            vector_memory_usage(content.tangents()) +
+            vector_memory_usage(content.bitangents());
+        for ( std::size_t i = 0; i < content.uvs_channel_count(); ++i ) {
+            result += vector_memory_usage(content.uvs(i));
+        }
+        for ( std::size_t i = 0; i < content.colors_channel_count(); ++i ) {
+            result += vector_memory_usage(content.colors(i));
+        }
+        for ( std::size_t i = 0; i < content.indices_submesh_count(); ++i ) {
+            result += vector_memory_usage(content.indices(i));
+        }
+        return result;
+    }
+
+    std::size_t content_memory_usage(const shape& content) noexcept {
+        std::size_t result = vector_memory_usage(content.vertices());
+        for ( std::size_t i = 0; i < content.uvs_channel_count(); ++i ) {
+            result += vector_memory_usage(content.uvs(i));
+        }
+        for ( std::size_t i = 0; i < content.colors_channel_count(); ++i ) {
+            result += vector_memory_usage(content.colors(i));
+        }
+        for ( std::size_t i = 0; i < content.indices_subshape_count(); ++i ) {
+            result += vector_memory_usage(content.indices(i));
+        }
+        return result;
+    }
+
+    std::size_t content_memory_usage(const texture_ptr& content) noexcept {
+        return content
+            ? content->decl().data_size_for_dimension(content->size())
+            : 0u;
+    }
+}
@@ -170,7 +170,7 @@ namespace e2d
     atlas_asset::load_async_result atlas_asset::load_async(
         const library& library, str_view address)
     {
-        return library.load_asset_async<json_asset>(address)
+        return library.load_asset_async<json_asset>(address, asset_cache_policy::transient)
         .then([
             &library,
             address = str(address),
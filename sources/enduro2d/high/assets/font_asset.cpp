@@ -25,7 +25,7 @@ namespace e2d
     font_asset::load_async_result font_asset::load_async(
         const library& library, str_view address)
     {
-        return library.load_asset_async<binary_asset>(address)
+        return library.load_asset_async<binary_asset>(address, asset_cache_policy::transient)
         .then([
             address = str(address)
         ](const binary_asset::load_result& font_data){
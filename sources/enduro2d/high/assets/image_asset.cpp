@@ -5,7 +5,6 @@
  ******************************************************************************/
 
 #include <enduro2d/high/assets/image_asset.hpp>
-#include <enduro2d/high/assets/binary_asset.hpp>
 
 namespace
 {
@@ -23,18 +22,19 @@ namespace e2d
     image_asset::load_async_result image_asset::load_async(
         const library& library, str_view address)
     {
-        return library.load_asset_async<binary_asset>(address)
-        .then([
-            address = str(address)
-        ](const binary_asset::load_result& image_data){
-            return the<deferrer>().do_in_worker_thread([
-                image_data,
-                address = std::move(address)
-            ](){
+        return the<vfs>().map_async(library.root() / address)
+        .then([](const mapped_file_sptr& image_data){
+            return the<deferrer>().do_in_worker_thread([image_data](){
                 image content;
-                if ( !images::try_load_image(content, image_data->content()) ) {
+                if ( !image_data || !images::try_load_image(content, image_data->content()) ) {
                     throw image_asset_loading_exception();
                 }
+                // compressed images keep the levels they are stored with
+                if ( content.mipmap_count() == 1u && !images::is_compressed_format(content.format()) ) {
+                    if ( !images::try_generate_mipmaps(content, content, image_mipmap_filter::box) ) {
+                        throw image_asset_loading_exception();
+                    }
+                }
                 return image_asset::create(std::move(content));
             });
         });
@@ -5,7 +5,6 @@
  ******************************************************************************/
 
 #include <enduro2d/high/assets/json_asset.hpp>
-#include <enduro2d/high/assets/text_asset.hpp>
 
 namespace
 {
@@ -23,16 +22,17 @@ namespace e2d
     json_asset::load_async_result json_asset::load_async(
         const library& library, str_view address)
     {
-        return library.load_asset_async<text_asset>(address)
-        .then([
-            address = str(address)
-        ](const text_asset::load_result& json_data){
-            return the<deferrer>().do_in_worker_thread([
-                json_data,
-                address = std::move(address)
-            ](){
+        return the<vfs>().map_async(library.root() / address)
+        .then([](const mapped_file_sptr& json_data){
+            return the<deferrer>().do_in_worker_thread([json_data](){
+                const buffer_view content = json_data
+                    ? json_data->content()
+                    : buffer_view();
+                if ( content.empty() ) {
+                    throw json_asset_loading_exception();
+                }
                 auto json = std::make_shared<rapidjson::Document>();
-                if ( json->Parse(json_data->content().c_str()).HasParseError() ) {
+                if ( json->Parse(static_cast<const char*>(content.data()), content.size()).HasParseError() ) {
                     throw json_asset_loading_exception();
                 }
                 return json_asset::create(std::move(json));
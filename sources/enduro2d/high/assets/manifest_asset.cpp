@@ -0,0 +1,131 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/high/assets/manifest_asset.hpp>
+
+#include <enduro2d/high/assets/json_asset.hpp>
+
+namespace
+{
+    using namespace e2d;
+
+    class manifest_asset_loading_exception final : public asset_loading_exception {
+        const char* what() const noexcept final {
+            return "manifest asset loading exception";
+        }
+    };
+
+    const char* manifest_asset_schema_source = R"json({
+        "type" : "object",
+        "required" : [ "assets" ],
+        "additionalProperties" : false,
+        "properties" : {
+            "assets" : {
+                "type" : "object",
+                "additionalProperties" : { "$ref": "#/definitions/dependencies" }
+            }
+        },
+        "definitions" : {
+            "dependencies" : {
+                "type" : "array",
+                "items" : { "$ref": "#/definitions/dependency" }
+            },
+            "dependency" : {
+                "type" : "object",
+                "required" : [ "type", "address" ],
+                "additionalProperties" : false,
+                "properties" : {
+                    "type" : { "$ref": "#/common_definitions/name" },
+                    "address" : { "$ref": "#/common_definitions/address" }
+                }
+            }
+        }
+    })json";
+
+    const rapidjson::SchemaDocument& manifest_asset_schema() {
+        static std::mutex mutex;
+        static std::unique_ptr<rapidjson::SchemaDocument> schema;
+
+        std::lock_guard<std::mutex> guard(mutex);
+        if ( !schema ) {
+            rapidjson::Document doc;
+            if ( doc.Parse(manifest_asset_schema_source).HasParseError() ) {
+                the<debug>().error("ASSETS: Failed to parse manifest asset schema");
+                throw manifest_asset_loading_exception();
+            }
+            json_utils::add_common_schema_definitions(doc);
+            schema = std::make_unique<rapidjson::SchemaDocument>(doc);
+        }
+
+        return *schema;
+    }
+
+    manifest parse_manifest(const rapidjson::Value& root) {
+        manifest content;
+
+        E2D_ASSERT(root.HasMember("assets") && root["assets"].IsObject());
+        const auto& assets_json = root["assets"];
+
+        for ( auto asset = assets_json.MemberBegin(); asset != assets_json.MemberEnd(); ++asset ) {
+            E2D_ASSERT(asset->value.IsArray());
+            const auto& dependencies_json = asset->value;
+
+            vector<manifest::dependency> dependencies;
+            dependencies.reserve(dependencies_json.Size());
+
+            for ( rapidjson::SizeType i = 0; i < dependencies_json.Size(); ++i ) {
+                const auto& dependency_json = dependencies_json[i];
+                E2D_ASSERT(dependency_json.HasMember("type") && dependency_json["type"].IsString());
+                E2D_ASSERT(dependency_json.HasMember("address") && dependency_json["address"].IsString());
+                dependencies.push_back({
+                    dependency_json["type"].GetString(),
+                    dependency_json["address"].GetString()});
+            }
+
+            content.set_dependencies(
+                asset->name.GetString(),
+                std::move(dependencies));
+        }
+
+        return content;
+    }
+}
+
+namespace e2d
+{
+    manifest_asset::load_async_result manifest_asset::load_async(
+        const library& library, str_view address)
+    {
+        return library.load_asset_async<json_asset>(address, asset_cache_policy::transient)
+        .then([
+            address = str(address)
+        ](const json_asset::load_result& manifest_data){
+            return the<deferrer>().do_in_worker_thread([address, manifest_data](){
+                const rapidjson::Document& doc = *manifest_data->content();
+                rapidjson::SchemaValidator validator(manifest_asset_schema());
+
+                if ( doc.Accept(validator) ) {
+                    return manifest_asset::create(parse_manifest(doc));
+                }
+
+                rapidjson::StringBuffer sb;
+                if ( validator.GetInvalidDocumentPointer().StringifyUriFragment(sb) ) {
+                    the<debug>().error("ASSET: Failed to validate asset json:\n"
+                        "--> Address: %0\n"
+                        "--> Invalid schema keyword: %1\n"
+                        "--> Invalid document pointer: %2",
+                        address,
+                        validator.GetInvalidSchemaKeyword(),
+                        sb.GetString());
+                } else {
+                    the<debug>().error("ASSET: Failed to validate asset json");
+                }
+
+                throw manifest_asset_loading_exception();
+            });
+        });
+    }
+}
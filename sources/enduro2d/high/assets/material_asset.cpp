@@ -190,7 +190,7 @@ namespace
                                 "type" : "object",
                                 "additionalProperties" : false,
                                 "properties" : {
-                                    "min" : { "$ref" : "#/definitions/sampler_filter" },
+                                    "min" : { "$ref" : "#/definitions/sampler_min_filter" },
                                     "mag" : { "$ref" : "#/definitions/sampler_filter" }
                                 }
                             }, {
@@ -328,6 +328,17 @@ namespace
                         "mirror"
                     ]
                 },
+                "sampler_min_filter" : {
+                    "type" : "string",
+                    "enum" : [
+                        "nearest",
+                        "linear",
+                        "nearest_mipmap_nearest",
+                        "linear_mipmap_nearest",
+                        "nearest_mipmap_linear",
+                        "linear_mipmap_linear"
+                    ]
+                },
                 "sampler_filter" : {
                     "type" : "string",
                     "enum" : [
@@ -1043,7 +1054,7 @@ namespace e2d
     material_asset::load_async_result material_asset::load_async(
         const library& library, str_view address)
     {
-        return library.load_asset_async<json_asset>(address)
+        return library.load_asset_async<json_asset>(address, asset_cache_policy::transient)
         .then([
             &library,
             address = str(address),
@@ -5,7 +5,6 @@
  ******************************************************************************/
 
 #include <enduro2d/high/assets/mesh_asset.hpp>
-#include <enduro2d/high/assets/binary_asset.hpp>
 
 namespace
 {
@@ -23,16 +22,11 @@ namespace e2d
     mesh_asset::load_async_result mesh_asset::load_async(
         const library& library, str_view address)
     {
-        return library.load_asset_async<binary_asset>(address)
-        .then([
-            address = str(address)
-        ](const binary_asset::load_result& mesh_data){
-            return the<deferrer>().do_in_worker_thread([
-                mesh_data,
-                address = std::move(address)
-            ](){
+        return the<vfs>().map_async(library.root() / address)
+        .then([](const mapped_file_sptr& mesh_data){
+            return the<deferrer>().do_in_worker_thread([mesh_data](){
                 mesh content;
-                if ( !meshes::try_load_mesh(content, mesh_data->content()) ) {
+                if ( !mesh_data || !meshes::try_load_mesh(content, mesh_data->content()) ) {
                     throw mesh_asset_loading_exception();
                 }
                 return mesh_asset::create(std::move(content));
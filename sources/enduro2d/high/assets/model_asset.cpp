@@ -72,7 +72,7 @@ namespace e2d
     model_asset::load_async_result model_asset::load_async(
         const library& library, str_view address)
     {
-        return library.load_asset_async<json_asset>(address)
+        return library.load_asset_async<json_asset>(address, asset_cache_policy::transient)
         .then([
             &library,
             address = str(address),
@@ -280,7 +280,7 @@ namespace e2d
     prefab_asset::load_async_result prefab_asset::load_async(
         const library& library, str_view address)
     {
-        return library.load_asset_async<json_asset>(address)
+        return library.load_asset_async<json_asset>(address, asset_cache_policy::transient)
         .then([
             &library,
             address = str(address),
@@ -320,3 +320,22 @@ namespace e2d
         });
     }
 }
+
+namespace e2d
+{
+    void prefab_asset::fill(prefab content) {
+        flat_prefab flat_content(content);
+        content_asset::fill(std::move(content));
+        flat_content_ = std::move(flat_content);
+    }
+
+    void prefab_asset::fill(prefab content, nested_content nested_content) {
+        flat_prefab flat_content(content);
+        content_asset::fill(std::move(content), std::move(nested_content));
+        flat_content_ = std::move(flat_content);
+    }
+
+    const flat_prefab& prefab_asset::flat_content() const noexcept {
+        return flat_content_;
+    }
+}
@@ -55,11 +55,13 @@ namespace
     {
         E2D_ASSERT(root.HasMember("vertex") && root["vertex"].IsString());
         auto vertex_a = path::combine(parent_address, root["vertex"].GetString());
-        auto vertex_p = library.load_asset_async<text_asset>(vertex_a);
+        auto vertex_p = library.load_asset_async<text_asset>(
+            vertex_a, asset_cache_policy::transient);
 
         E2D_ASSERT(root.HasMember("fragment") && root["fragment"].IsString());
         auto fragment_a = path::combine(parent_address, root["fragment"].GetString());
-        auto fragment_p = library.load_asset_async<text_asset>(fragment_a);
+        auto fragment_p = library.load_asset_async<text_asset>(
+            fragment_a, asset_cache_policy::transient);
 
         return stdex::make_tuple_promise(std::make_tuple(
             std::move(vertex_p),
@@ -93,7 +95,7 @@ namespace e2d
     shader_asset::load_async_result shader_asset::load_async(
         const library& library, str_view address)
     {
-        return library.load_asset_async<json_asset>(address)
+        return library.load_asset_async<json_asset>(address, asset_cache_policy::transient)
         .then([
             &library,
             address = str(address),
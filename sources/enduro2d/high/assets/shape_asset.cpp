@@ -5,7 +5,6 @@
  ******************************************************************************/
 
 #include <enduro2d/high/assets/shape_asset.hpp>
-#include <enduro2d/high/assets/binary_asset.hpp>
 
 namespace
 {
@@ -23,16 +22,11 @@ namespace e2d
     shape_asset::load_async_result shape_asset::load_async(
         const library& library, str_view address)
     {
-        return library.load_asset_async<binary_asset>(address)
-        .then([
-            address = str(address)
-        ](const binary_asset::load_result& shape_data){
-            return the<deferrer>().do_in_worker_thread([
-                shape_data,
-                address = std::move(address)
-            ](){
+        return the<vfs>().map_async(library.root() / address)
+        .then([](const mapped_file_sptr& shape_data){
+            return the<deferrer>().do_in_worker_thread([shape_data](){
                 shape content;
-                if ( !shapes::try_load_shape(content, shape_data->content()) ) {
+                if ( !shape_data || !shapes::try_load_shape(content, shape_data->content()) ) {
                     throw shape_asset_loading_exception();
                 }
                 return shape_asset::create(std::move(content));
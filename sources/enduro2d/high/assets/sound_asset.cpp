@@ -74,7 +74,8 @@ namespace
                 return content;
             });
         } else {
-            return library.load_asset_async<binary_asset>(sound_address)
+            return library.load_asset_async<binary_asset>(
+                sound_address, asset_cache_policy::transient)
             .then([](const binary_asset::load_result& sound_data){
                 return the<deferrer>().do_in_worker_thread([sound_data](){
                     sound_stream_ptr content = the<audio>().create_stream(
@@ -94,7 +95,7 @@ namespace e2d
     sound_asset::load_async_result sound_asset::load_async(
         const library& library, str_view address)
     {
-        return library.load_asset_async<json_asset>(address)
+        return library.load_asset_async<json_asset>(address, asset_cache_policy::transient)
         .then([
             &library,
             address = str(address),
@@ -23,7 +23,7 @@ namespace e2d
     texture_asset::load_async_result texture_asset::load_async(
         const library& library, str_view address)
     {
-        return library.load_asset_async<image_asset>(address)
+        return library.load_asset_async<image_asset>(address, asset_cache_policy::transient)
         .then([
             address = str(address)
         ](const image_asset::load_result& texture_data){
@@ -31,13 +31,22 @@ namespace e2d
                 texture_data,
                 address = std::move(address)
             ](){
-                const texture_ptr content = the<render>().create_texture(
-                    texture_data->content());
-                if ( !content ) {
+                // the upload shares the image with the asset instead of copying it
+                const render::texture_uploader::upload_ptr upload =
+                    the<render>().upload_texture(std::shared_ptr<const image>(
+                        &texture_data->content(),
+                        [texture_data](const image*) noexcept {}));
+                if ( !upload ) {
                     throw texture_asset_loading_exception();
                 }
-                return texture_asset::create(content);
+                return upload;
             });
+        })
+        .then([](const render::texture_uploader::upload_ptr& upload){
+            return upload->result();
+        })
+        .then([](const texture_ptr& content){
+            return texture_asset::create(content);
         });
     }
 }
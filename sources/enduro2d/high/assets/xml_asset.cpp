@@ -23,7 +23,7 @@ namespace e2d
     xml_asset::load_async_result xml_asset::load_async(
         const library& library, str_view address)
     {
-        return library.load_asset_async<text_asset>(address)
+        return library.load_asset_async<text_asset>(address, asset_cache_policy::transient)
         .then([
             address = str(address)
         ](const text_asset::load_result& xml_data){
@@ -180,6 +180,32 @@ namespace e2d
     }
 }
 
+namespace e2d
+{
+    const char* factory_loader<camera::statistics>::schema_source = R"json({
+        "type" : "object",
+        "required" : [],
+        "additionalProperties" : false,
+        "properties" : {}
+    })json";
+
+    bool factory_loader<camera::statistics>::operator()(
+        camera::statistics& component,
+        const fill_context& ctx) const
+    {
+        E2D_UNUSED(component, ctx);
+        return true;
+    }
+
+    bool factory_loader<camera::statistics>::operator()(
+        asset_dependencies& dependencies,
+        const collect_context& ctx) const
+    {
+        E2D_UNUSED(dependencies, ctx);
+        return true;
+    }
+}
+
 namespace e2d
 {
     const char* component_inspector<camera>::title = ICON_FA_VIDEO " camera";
@@ -207,6 +233,25 @@ namespace e2d
             }
         }
 
+        ImGui::SameLine();
+
+        if ( bool statistics = c.component<camera::statistics>().exists();
+            ImGui::Checkbox("statistics", &statistics) )
+        {
+            if ( statistics ) {
+                c.component<camera::statistics>().ensure();
+            } else {
+                c.component<camera::statistics>().remove();
+            }
+        }
+
+        if ( auto statistics = c.component<camera::statistics>() ) {
+            imgui_utils::show_formatted_text(
+                "drawn nodes: %0", statistics->drawn_nodes());
+            imgui_utils::show_formatted_text(
+                "culled nodes: %0", statistics->culled_nodes());
+        }
+
         if ( i32 depth = c->depth();
             ImGui::DragInt("depth", &depth, 1.f) )
         {
@@ -6,6 +6,24 @@
 
 #include <enduro2d/high/node.hpp>
 
+namespace
+{
+    using namespace e2d;
+
+    //
+    // world_version
+    //
+    // Source of world matrix versions, unique across all nodes so
+    // a (node, version) pair can't repeat when node memory is reused.
+    //
+
+    std::atomic<u32> last_world_version{0u};
+
+    u32 next_world_version() noexcept {
+        return last_world_version.fetch_add(1u, std::memory_order_relaxed) + 1u;
+    }
+}
+
 namespace e2d
 {
     node::node(gobject owner)
@@ -116,12 +134,20 @@ namespace e2d
     }
 
     const m4f& node::world_matrix() const noexcept {
-        if ( math::check_and_clear_any_flags(flags_, fm_dirty_world_matrix) ) {
-            update_world_matrix_();
-        }
+        update_world_matrix_();
         return world_matrix_;
     }
 
+    void node::update_world_matrix_recursive() const noexcept {
+        update_world_matrix_();
+        update_children_world_matrices_();
+    }
+
+    u32 node::world_version() const noexcept {
+        update_world_matrix_();
+        return world_version_;
+    }
+
     v4f node::local_to_world(const v4f& local) const noexcept {
         return local * world_matrix();
     }
@@ -495,15 +521,17 @@ namespace e2d
 namespace e2d
 {
     void node::mark_dirty_local_matrix_() noexcept {
-        if ( math::check_and_set_any_flags(flags_, fm_dirty_local_matrix) ) {
-            mark_dirty_world_matrix_();
-        }
+        math::set_flags_inplace(flags_, fm_dirty_local_matrix);
+        mark_dirty_world_matrix_();
     }
 
     void node::mark_dirty_world_matrix_() noexcept {
-        if ( math::check_and_set_any_flags(flags_, fm_dirty_world_matrix) ) {
-            for ( node& child : children_ ) {
-                child.mark_dirty_world_matrix_();
+        // descendants are not touched here: they notice the change by the
+        // parent world version, and the subtree flags lead the transform pass
+        math::set_flags_inplace(flags_, fm_dirty_world_matrix | fm_dirty_subtree);
+        for ( const node* n = parent_; n; n = n->parent_ ) {
+            if ( !math::check_and_set_any_flags(n->flags_, fm_dirty_subtree) ) {
+                break;
             }
         }
     }
@@ -513,9 +541,40 @@ namespace e2d
     }
 
     void node::update_world_matrix_() const noexcept {
-        world_matrix_ = parent_
-            ? local_matrix() * parent_->world_matrix()
-            : local_matrix();
+        if ( parent_ ) {
+            parent_->update_world_matrix_();
+        }
+        update_own_world_matrix_();
+    }
+
+    bool node::update_own_world_matrix_() const noexcept {
+        // the parent world matrix must be up to date here
+        const bool parent_changed = parent_
+            && parent_world_version_ != parent_->world_version_;
+        if ( !math::check_and_clear_any_flags(flags_, fm_dirty_world_matrix) && !parent_changed ) {
+            return false;
+        }
+
+        if ( parent_ ) {
+            world_matrix_ = local_matrix() * parent_->world_matrix_;
+            parent_world_version_ = parent_->world_version_;
+        } else {
+            world_matrix_ = local_matrix();
+        }
+        world_version_ = next_world_version();
+
+        // children have to be revisited by the next transform pass
+        math::set_flags_inplace(flags_, fm_dirty_subtree);
+        return true;
+    }
+
+    void node::update_children_world_matrices_() const noexcept {
+        if ( math::check_and_clear_any_flags(flags_, fm_dirty_subtree) ) {
+            for ( const node& child : children_ ) {
+                child.update_own_world_matrix_();
+                child.update_children_world_matrices_();
+            }
+        }
     }
 }
 
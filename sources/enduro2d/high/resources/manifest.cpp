@@ -0,0 +1,147 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/high/resources/manifest.hpp>
+
+#include <3rdparty/rapidjson/prettywriter.h>
+
+namespace e2d
+{
+    manifest::manifest(manifest&& other) noexcept {
+        assign(std::move(other));
+    }
+
+    manifest& manifest::operator=(manifest&& other) noexcept {
+        return assign(std::move(other));
+    }
+
+    manifest::manifest(const manifest& other) {
+        assign(other);
+    }
+
+    manifest& manifest::operator=(const manifest& other) {
+        return assign(other);
+    }
+
+    void manifest::clear() noexcept {
+        dependencies_.clear();
+    }
+
+    void manifest::swap(manifest& other) noexcept {
+        using std::swap;
+        swap(dependencies_, other.dependencies_);
+    }
+
+    manifest& manifest::assign(manifest&& other) noexcept {
+        if ( this != &other ) {
+            swap(other);
+            other.clear();
+        }
+        return *this;
+    }
+
+    manifest& manifest::assign(const manifest& other) {
+        if ( this != &other ) {
+            manifest s;
+            s.dependencies_ = other.dependencies_;
+            swap(s);
+        }
+        return *this;
+    }
+
+    manifest& manifest::add_dependency(str_view address, str_view type, str_view dependency) {
+        auto iter = dependencies_.find(address);
+        if ( iter == dependencies_.end() ) {
+            iter = dependencies_.emplace(address, vector<manifest::dependency>()).first;
+        }
+        iter->second.push_back({str(type), str(dependency)});
+        return *this;
+    }
+
+    manifest& manifest::set_dependencies(str_view address, vector<dependency> dependencies) {
+        auto iter = dependencies_.find(address);
+        if ( iter == dependencies_.end() ) {
+            dependencies_.emplace(address, std::move(dependencies));
+        } else {
+            iter->second = std::move(dependencies);
+        }
+        return *this;
+    }
+
+    const vector<manifest::dependency>* manifest::find_dependencies(str_view address) const noexcept {
+        const auto iter = dependencies_.find(address);
+        return iter != dependencies_.end()
+            ? &iter->second
+            : nullptr;
+    }
+
+    const flat_map<str, vector<manifest::dependency>>& manifest::dependencies() const noexcept {
+        return dependencies_;
+    }
+}
+
+namespace e2d
+{
+    void swap(manifest& l, manifest& r) noexcept {
+        l.swap(r);
+    }
+
+    bool operator==(const manifest& l, const manifest& r) noexcept {
+        return l.dependencies() == r.dependencies();
+    }
+
+    bool operator!=(const manifest& l, const manifest& r) noexcept {
+        return !(l == r);
+    }
+
+    bool operator==(const manifest::dependency& l, const manifest::dependency& r) noexcept {
+        return l.type == r.type
+            && l.address == r.address;
+    }
+
+    bool operator!=(const manifest::dependency& l, const manifest::dependency& r) noexcept {
+        return !(l == r);
+    }
+}
+
+namespace e2d::manifests
+{
+    bool try_save_manifest(
+        const manifest& src,
+        const output_stream_uptr& dst) noexcept
+    {
+        if ( !dst ) {
+            return false;
+        }
+        try {
+            rapidjson::StringBuffer sb;
+            rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(sb);
+            writer.StartObject();
+            writer.Key("assets");
+            writer.StartObject();
+            for ( const auto& [address, dependencies] : src.dependencies() ) {
+                writer.Key(address.c_str());
+                writer.StartArray();
+                for ( const manifest::dependency& d : dependencies ) {
+                    writer.StartObject();
+                    writer.Key("type");
+                    writer.String(d.type.c_str());
+                    writer.Key("address");
+                    writer.String(d.address.c_str());
+                    writer.EndObject();
+                }
+                writer.EndArray();
+            }
+            writer.EndObject();
+            writer.EndObject();
+            return output_sequence(*dst)
+                .write_all(str_view(sb.GetString(), sb.GetSize()))
+                .success();
+        } catch (...) {
+            return false;
+        }
+    }
+}
@@ -117,3 +117,103 @@ namespace e2d
         l.swap(r);
     }
 }
+
+namespace e2d
+{
+    flat_prefab::flat_prefab(const prefab& prefab) {
+        assign(prefab);
+    }
+
+    flat_prefab::flat_prefab(flat_prefab&& other) noexcept {
+        assign(std::move(other));
+    }
+
+    flat_prefab& flat_prefab::operator=(flat_prefab&& other) noexcept {
+        return assign(std::move(other));
+    }
+
+    flat_prefab::flat_prefab(const flat_prefab& other) {
+        assign(other);
+    }
+
+    flat_prefab& flat_prefab::operator=(const flat_prefab& other) {
+        return assign(other);
+    }
+
+    void flat_prefab::clear() noexcept {
+        parents_.clear();
+        prototypes_.clear();
+    }
+
+    void flat_prefab::swap(flat_prefab& other) noexcept {
+        using std::swap;
+        swap(parents_, other.parents_);
+        swap(prototypes_, other.prototypes_);
+    }
+
+    flat_prefab& flat_prefab::assign(flat_prefab&& other) noexcept {
+        if ( this != &other ) {
+            swap(other);
+            other.clear();
+        }
+        return *this;
+    }
+
+    flat_prefab& flat_prefab::assign(const flat_prefab& other) {
+        if ( this != &other ) {
+            flat_prefab s;
+            s.parents_ = other.parents_;
+            s.prototypes_ = other.prototypes_;
+            s.swap(*this);
+        }
+        return *this;
+    }
+
+    flat_prefab& flat_prefab::assign(const prefab& prefab) {
+        flat_prefab s;
+        vector<std::pair<const e2d::prefab*, std::size_t>> stack;
+        stack.emplace_back(&prefab, no_parent);
+
+        while ( !stack.empty() ) {
+            const auto [p, parent] = stack.back();
+            stack.pop_back();
+
+            const std::size_t index = s.prototypes_.size();
+            s.parents_.push_back(parent);
+            s.prototypes_.push_back(p->prototype());
+
+            const vector<e2d::prefab>& children = p->children();
+            for ( auto iter = children.rbegin(); iter != children.rend(); ++iter ) {
+                stack.emplace_back(&*iter, index);
+            }
+        }
+
+        s.swap(*this);
+        return *this;
+    }
+
+    bool flat_prefab::empty() const noexcept {
+        return prototypes_.empty();
+    }
+
+    std::size_t flat_prefab::size() const noexcept {
+        return prototypes_.size();
+    }
+
+    std::size_t flat_prefab::parent(std::size_t index) const noexcept {
+        E2D_ASSERT(index < parents_.size());
+        return parents_[index];
+    }
+
+    const ecs::prototype& flat_prefab::prototype(std::size_t index) const noexcept {
+        E2D_ASSERT(index < prototypes_.size());
+        return prototypes_[index];
+    }
+}
+
+namespace e2d
+{
+    void swap(flat_prefab& l, flat_prefab& r) noexcept {
+        l.swap(r);
+    }
+}
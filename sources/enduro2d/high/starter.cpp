@@ -12,6 +12,25 @@
 #include <enduro2d/high/library.hpp>
 #include <enduro2d/high/world.hpp>
 
+#include <enduro2d/high/assets/atlas_asset.hpp>
+#include <enduro2d/high/assets/binary_asset.hpp>
+#include <enduro2d/high/assets/flipbook_asset.hpp>
+#include <enduro2d/high/assets/font_asset.hpp>
+#include <enduro2d/high/assets/image_asset.hpp>
+#include <enduro2d/high/assets/json_asset.hpp>
+#include <enduro2d/high/assets/manifest_asset.hpp>
+#include <enduro2d/high/assets/material_asset.hpp>
+#include <enduro2d/high/assets/mesh_asset.hpp>
+#include <enduro2d/high/assets/model_asset.hpp>
+#include <enduro2d/high/assets/prefab_asset.hpp>
+#include <enduro2d/high/assets/shader_asset.hpp>
+#include <enduro2d/high/assets/shape_asset.hpp>
+#include <enduro2d/high/assets/sound_asset.hpp>
+#include <enduro2d/high/assets/sprite_asset.hpp>
+#include <enduro2d/high/assets/text_asset.hpp>
+#include <enduro2d/high/assets/texture_asset.hpp>
+#include <enduro2d/high/assets/xml_asset.hpp>
+
 #include <enduro2d/high/components/actor.hpp>
 #include <enduro2d/high/components/camera.hpp>
 #include <enduro2d/high/components/colliders.hpp>
@@ -88,6 +107,7 @@ namespace
         }
 
         bool frame_tick() final {
+            the<library>().process_loading_queue();
             the<world>().registry().process_event(systems::frame_update_event{});
             return !the<window>().should_close()
                 || (application_ && !application_->on_should_close());
@@ -135,6 +155,24 @@ namespace e2d
         return root_;
     }
 
+    starter::library_parameters& starter::library_parameters::memory_budget(std::size_t value) noexcept {
+        memory_budget_ = value;
+        return *this;
+    }
+
+    std::size_t starter::library_parameters::memory_budget() const noexcept {
+        return memory_budget_;
+    }
+
+    starter::library_parameters& starter::library_parameters::max_queued_loads(std::size_t value) noexcept {
+        max_queued_loads_ = value;
+        return *this;
+    }
+
+    std::size_t starter::library_parameters::max_queued_loads() const noexcept {
+        return max_queued_loads_;
+    }
+
     //
     // starter::parameters
     //
@@ -182,6 +220,7 @@ namespace e2d
             .register_component<camera>("camera")
             .register_component<camera::input>("camera.input")
             .register_component<camera::gizmos>("camera.gizmos")
+            .register_component<camera::statistics>("camera.statistics")
             .register_component<rect_collider>("rect_collider")
             .register_component<circle_collider>("circle_collider")
             .register_component<polygon_collider>("polygon_collider")
@@ -226,7 +265,26 @@ namespace e2d
             ;
 
         safe_module_initialize<library>(
-            params.library_params());
+            params.library_params())
+            .register_asset_type<atlas_asset>()
+            .register_asset_type<binary_asset>()
+            .register_asset_type<flipbook_asset>()
+            .register_asset_type<font_asset>()
+            .register_asset_type<image_asset>()
+            .register_asset_type<json_asset>()
+            .register_asset_type<manifest_asset>()
+            .register_asset_type<material_asset>()
+            .register_asset_type<mesh_asset>()
+            .register_asset_type<model_asset>()
+            .register_asset_type<prefab_asset>()
+            .register_asset_type<shader_asset>()
+            .register_asset_type<shape_asset>()
+            .register_asset_type<sound_asset>()
+            .register_asset_type<sprite_asset>()
+            .register_asset_type<text_asset>()
+            .register_asset_type<texture_asset>()
+            .register_asset_type<xml_asset>()
+            ;
 
         safe_module_initialize<world>();
         safe_module_initialize<editor>();
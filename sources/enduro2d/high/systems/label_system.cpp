@@ -17,6 +17,17 @@ namespace
 {
     using namespace e2d;
 
+    constexpr str_hash texture_sampler_hash = "u_texture"_hash;
+    constexpr str_hash glyph_dilate_property_hash = "u_glyph_dilate"_hash;
+    constexpr str_hash outline_width_property_hash = "u_outline_width"_hash;
+    constexpr str_hash outline_color_property_hash = "u_outline_color"_hash;
+
+    [[maybe_unused]] const bool hash_literals_registered =
+        str_hash::register_literal(texture_sampler_hash, "u_texture") &&
+        str_hash::register_literal(glyph_dilate_property_hash, "u_glyph_dilate") &&
+        str_hash::register_literal(outline_width_property_hash, "u_outline_width") &&
+        str_hash::register_literal(outline_color_property_hash, "u_outline_color");
+
     class geometry_builder {
     public:
         geometry_builder() = default;
@@ -180,13 +191,13 @@ namespace
         const v4f outline_color = make_vec4(color(l.outline_color()));
 
         r.properties(render::property_block()
-            .sampler("u_texture", render::sampler_state()
+            .sampler(texture_sampler_hash, render::sampler_state()
                 .texture(texture)
                 .min_filter(render::sampler_min_filter::linear)
                 .mag_filter(render::sampler_mag_filter::linear))
-            .property("u_glyph_dilate", glyph_dilate)
-            .property("u_outline_width", outline_width)
-            .property("u_outline_color", outline_color));
+            .property(glyph_dilate_property_hash, glyph_dilate)
+            .property(outline_width_property_hash, outline_width)
+            .property(outline_color_property_hash, outline_color));
     }
 
     void update_label_geometry(const label& l, model_renderer& mr, geometry_builder& gb) {
@@ -63,18 +63,23 @@ namespace e2d
     class render_system::internal_state final : private noncopyable {
     public:
         internal_state()
-        : drawer_(the<engine>(), the<debug>(), the<render>(), the<window>()) {}
+        : drawer_(the<engine>(), the<debug>(), the<deferrer>(), the<render>(), the<window>()) {}
         ~internal_state() noexcept = default;
 
         void process_render(const ecs::const_entity& cam_e, ecs::registry& owner) {
             if ( !cam_e.valid() || !cam_e.exists_component<camera>() ) {
                 return;
             }
-            drawer_.with(
+            const drawer::statistics stats = drawer_.with(
                 cam_e.get_component<camera>(),
                 [&owner](drawer::context& ctx){
                     for_all_scenes(ctx, owner);
                 });
+
+            if ( auto* s = owner.wrap_entity(cam_e).find_component<camera::statistics>() ) {
+                s->drawn_nodes(stats.drawn_nodes);
+                s->culled_nodes(stats.culled_nodes);
+            }
         }
     private:
         drawer drawer_;
@@ -27,15 +27,37 @@ namespace e2d::render_system_impl
 
         batcher(debug& debug, render& render);
 
+        // 'bounds' are the screen space bounds of the geometry, batches with
+        // disjoint bounds may be drawn out of order to group equal materials,
+        // geometry without bounds keeps its place relative to all other batches
         void batch(
             const material_asset::ptr& material,
             const render::property_block& properties,
             const index_type* indices, std::size_t index_count,
-            const vertex_type* vertices, std::size_t vertex_count);
+            const vertex_type* vertices, std::size_t vertex_count,
+            const std::optional<b2f>& bounds = std::nullopt);
+
+        // Reserves 'vertex_count' vertices without initializing them and returns
+        // the index of the first one. They must be filled through 'vertex_data'
+        // before the next flush, including the implicit one on overflow.
+        std::size_t reserve(
+            const material_asset::ptr& material,
+            const render::property_block& properties,
+            const index_type* indices, std::size_t index_count,
+            std::size_t vertex_count,
+            const std::optional<b2f>& bounds = std::nullopt);
+
+        bool has_room_for(std::size_t vertex_count) const noexcept;
+        vertex_type* vertex_data() noexcept;
+
+        // Retires the streaming buffer regions of old frames,
+        // does nothing when called again within the same frame.
+        void next_frame(u32 frame_index);
 
         render::property_block& flush();
         void clear(bool clear_internal_props) noexcept;
     private:
+        void sort_batches_();
         void update_buffers_();
         void render_buffers_();
         void update_index_buffer_();
@@ -46,30 +68,53 @@ namespace e2d::render_system_impl
             std::size_t count{0u};
             material_asset::ptr material;
             render::property_block properties;
+            std::optional<b2f> bounds;
+            std::size_t group{0u};
+            u64 sort_key{0u};
 
             batch_type(
                 std::size_t nstart,
                 const material_asset::ptr& nmaterial,
-                const render::property_block& nproperties)
+                const render::property_block& nproperties,
+                const std::optional<b2f>& nbounds)
             : start(nstart)
             , material(nmaterial)
-            , properties(nproperties) {}
+            , properties(nproperties)
+            , bounds(nbounds) {}
+        };
+
+        // batches with equal materials and properties share one group,
+        // so their draw commands can be merged by the command queue
+        struct group_type {
+            material_asset::ptr material;
+            render::property_block properties;
         };
     private:
         debug& debug_;
         render& render_;
         vector<batch_type> batches_;
+        vector<group_type> groups_;
+        std::size_t group_count_ = 0;
+        vector<u32> batch_levels_;
         vector<index_type> indices_;
+        vector<index_type> sorted_indices_;
         vector<vertex_type> vertices_;
         index_declaration index_decl_;
         vertex_declaration vertex_decl_;
         index_buffer_ptr index_buffer_;
         vertex_buffer_ptr vertex_buffer_;
-        render::property_block property_cache_;
+        render::ring_allocator index_ring_;
+        render::ring_allocator vertex_ring_;
+        std::size_t first_index_ = 0;
+        std::size_t first_vertex_ = 0;
+        std::optional<u32> frame_index_;
         render::property_block internal_properties_;
+        render::command_queue command_queue_;
     private:
+        static constexpr std::size_t frames_in_flight = 3u;
+        static constexpr std::size_t max_reorder_distance = 64u;
         static std::size_t calculate_new_buffer_size(
-            std::size_t esize, std::size_t osize, std::size_t nsize);
+            std::size_t esize, std::size_t osize, std::size_t nsize, std::size_t msize);
     };
 }
 
@@ -80,7 +125,9 @@ namespace e2d::render_system_impl
     : debug_(debug)
     , render_(render)
     , index_decl_(Index::decl())
-    , vertex_decl_(Vertex::decl()) {
+    , vertex_decl_(Vertex::decl())
+    , index_ring_(0u, frames_in_flight)
+    , vertex_ring_(0u, frames_in_flight) {
         E2D_ASSERT(sizeof(index_type) == index_decl_.bytes_per_index());
         E2D_ASSERT(sizeof(vertex_type) == vertex_decl_.bytes_per_vertex());
     }
@@ -90,11 +137,35 @@ namespace e2d::render_system_impl
         const material_asset::ptr& material,
         const render::property_block& properties,
         const index_type* indices, std::size_t index_count,
-        const vertex_type* vertices, std::size_t vertex_count)
+        const vertex_type* vertices, std::size_t vertex_count,
+        const std::optional<b2f>& bounds)
+    {
+        E2D_ASSERT(vertices || !vertex_count);
+
+        const std::size_t first_vertex = reserve(
+            material,
+            properties,
+            indices, index_count,
+            vertex_count,
+            bounds);
+
+        if ( vertices && vertex_count ) {
+            std::copy(
+                vertices, vertices + vertex_count,
+                vertices_.begin() + first_vertex);
+        }
+    }
+
+    template < typename Index, typename Vertex >
+    std::size_t batcher<Index, Vertex>::reserve(
+        const material_asset::ptr& material,
+        const render::property_block& properties,
+        const index_type* indices, std::size_t index_count,
+        std::size_t vertex_count,
+        const std::optional<b2f>& bounds)
     {
         E2D_ASSERT(material);
         E2D_ASSERT(indices || !index_count);
-        E2D_ASSERT(vertices || !vertex_count);
 
         const std::size_t max_vertex_count = std::numeric_limits<index_type>::max();
 
@@ -102,7 +173,7 @@ namespace e2d::render_system_impl
             throw bad_batcher_operation();
         }
 
-        if ( max_vertex_count - vertices_.size() < vertex_count ) {
+        if ( !has_room_for(vertex_count) ) {
             flush();
         }
 
@@ -112,6 +183,7 @@ namespace e2d::render_system_impl
 
         const bool batching_available =
             !batches_.empty() &&
+            batches_.back().properties.hash() == properties.hash() &&
             (batches_.back().material == material || batches_.back().material->content() == material->content()) &&
             batches_.back().properties == properties;
 
@@ -119,7 +191,11 @@ namespace e2d::render_system_impl
             const std::size_t start = batches_.empty()
                 ? 0u
                 : batches_.back().start + batches_.back().count;
-            batches_.emplace_back(start, material, properties);
+            batches_.emplace_back(start, material, properties, bounds);
+        } else if ( batches_.back().bounds && bounds ) {
+            batches_.back().bounds = math::merged(*batches_.back().bounds, *bounds);
+        } else {
+            batches_.back().bounds.reset();
         }
 
         if ( indices && index_count ) {
@@ -134,10 +210,28 @@ namespace e2d::render_system_impl
             batches_.back().count += index_count;
         }
 
-        if ( vertices && vertex_count ) {
-            vertices_.insert(
-                vertices_.end(),
-                vertices, vertices + vertex_count);
+        const std::size_t first_vertex = vertices_.size();
+        vertices_.resize(first_vertex + vertex_count);
+        return first_vertex;
+    }
+
+    template < typename Index, typename Vertex >
+    bool batcher<Index, Vertex>::has_room_for(std::size_t vertex_count) const noexcept {
+        const std::size_t max_vertex_count = std::numeric_limits<index_type>::max();
+        return vertex_count <= max_vertex_count - vertices_.size();
+    }
+
+    template < typename Index, typename Vertex >
+    typename batcher<Index, Vertex>::vertex_type* batcher<Index, Vertex>::vertex_data() noexcept {
+        return vertices_.data();
+    }
+
+    template < typename Index, typename Vertex >
+    void batcher<Index, Vertex>::next_frame(u32 frame_index) {
+        if ( frame_index_ != frame_index ) {
+            index_ring_.next_frame();
+            vertex_ring_.next_frame();
+            frame_index_ = frame_index;
         }
     }
 
@@ -147,6 +241,7 @@ namespace e2d::render_system_impl
             clear(false);
         });
 
+        sort_batches_();
         update_buffers_();
         render_buffers_();
 
@@ -156,17 +251,116 @@ namespace e2d::render_system_impl
     template < typename Index, typename Vertex >
     void batcher<Index, Vertex>::clear(bool clear_internal_props) noexcept {
         batches_.clear();
+        for ( std::size_t i = 0; i < group_count_; ++i ) {
+            groups_[i].material.reset();
+            groups_[i].properties.clear();
+        }
+        group_count_ = 0;
         indices_.clear();
         vertices_.clear();
+        command_queue_.clear();
         if ( clear_internal_props ) {
             internal_properties_.clear();
         }
     }
 
+    template < typename Index, typename Vertex >
+    void batcher<Index, Vertex>::sort_batches_() {
+        // a batch is drawn one level above the highest earlier batch it overlaps,
+        // so batches of the same level never overlap and may go in any order,
+        // batches too far back are conservatively treated as overlapping
+
+        batch_levels_.resize(batches_.size());
+        u32 floor_level = 0u;
+        bool reorderable = true;
+
+        for ( std::size_t i = 0; i < batches_.size() && reorderable; ++i ) {
+            const batch_type& batch = batches_[i];
+            const std::size_t first_near = i > max_reorder_distance
+                ? i - max_reorder_distance
+                : 0u;
+
+            if ( first_near > 0u ) {
+                floor_level = math::max(floor_level, batch_levels_[first_near - 1u] + 1u);
+            }
+
+            u32 level = floor_level;
+            for ( std::size_t j = first_near; j < i; ++j ) {
+                const batch_type& other = batches_[j];
+                const bool overlapped = !batch.bounds
+                    || !other.bounds
+                    || math::overlaps(*batch.bounds, *other.bounds);
+                if ( overlapped ) {
+                    level = math::max(level, batch_levels_[j] + 1u);
+                }
+            }
+
+            batch_levels_[i] = level;
+            reorderable = level <= std::numeric_limits<u16>::max();
+        }
+
+        for ( std::size_t i = 0; i < batches_.size(); ++i ) {
+            batch_type& batch = batches_[i];
+
+            const auto group_iter = std::find_if(
+                groups_.begin(), groups_.begin() + group_count_,
+                [&batch](const group_type& group){
+                    return group.properties.hash() == batch.properties.hash()
+                        && (group.material == batch.material || group.material->content() == batch.material->content())
+                        && group.properties == batch.properties;
+                });
+
+            if ( group_iter != groups_.begin() + group_count_ ) {
+                batch.group = static_cast<std::size_t>(group_iter - groups_.begin());
+            } else {
+                if ( group_count_ == groups_.size() ) {
+                    groups_.emplace_back();
+                }
+                group_type& group = groups_[group_count_];
+                group.material = batch.material;
+                group.properties = batch.properties;
+                batch.group = group_count_++;
+            }
+
+            batch.sort_key = render::command_queue::make_sort_key(
+                0u,
+                0u,
+                reorderable ? batch_levels_[i] : 0u,
+                reorderable ? static_cast<u32>(math::min(batch.group, std::size_t(0xFFF))) : 0u,
+                0u);
+        }
+
+        if ( !reorderable || batches_.size() < 2u ) {
+            return;
+        }
+
+        std::stable_sort(
+            batches_.begin(), batches_.end(),
+            [](const batch_type& l, const batch_type& r) noexcept {
+                return l.sort_key < r.sort_key;
+            });
+
+        // indices are laid out again in the sorted order,
+        // so draws of the same group become contiguous ranges
+
+        sorted_indices_.resize(indices_.size());
+        for ( std::size_t i = 0, start = 0; i < batches_.size(); ++i ) {
+            batch_type& batch = batches_[i];
+            std::copy(
+                indices_.begin() + batch.start,
+                indices_.begin() + batch.start + batch.count,
+                sorted_indices_.begin() + start);
+            batch.start = start;
+            start += batch.count;
+        }
+        indices_.swap(sorted_indices_);
+    }
+
     template < typename Index, typename Vertex >
     void batcher<Index, Vertex>::update_buffers_() {
-        update_index_buffer_();
+        // indices are rebased onto the vertex region, so vertices go first
         update_vertex_buffer_();
+        update_index_buffer_();
     }
 
     template < typename Index, typename Vertex >
@@ -179,38 +373,60 @@ namespace e2d::render_system_impl
             .indices(index_buffer_)
             .add_vertices(vertex_buffer_);
 
-        DEFER_HPP([this](){
-            property_cache_.clear();
-        });
+        // properties are merged once per group, and all draws of a group
+        // refer to the same material and properties, so the queue merges
+        // neighbouring draws of a group into one
+
+        for ( std::size_t i = 0; i < group_count_; ++i ) {
+            render::property_block& props = groups_[i].properties;
+            props = render::property_block()
+                .merge(internal_properties_)
+                .merge(props);
+        }
 
         for ( const batch_type& batch : batches_ ) {
-            const render::material& mat = batch.material->content();
-            render_.execute(render::draw_command(
-                mat,
+            const group_type& group = groups_[batch.group];
+            command_queue_.add_command(batch.sort_key, render::draw_command(
+                group.material->content(),
                 geo,
-                property_cache_
-                    .merge(internal_properties_)
-                    .merge(batch.properties)
-            ).index_range(batch.start, batch.count));
+                group.properties
+            ).index_range(first_index_ + batch.start, batch.count));
         }
+
+        // the streaming buffers may be orphaned by the next flush,
+        // so queued draws are submitted right away
+        render_.execute(command_queue_.sort());
     }
 
     template < typename Index, typename Vertex >
     void batcher<Index, Vertex>::update_index_buffer_() {
-        const std::size_t min_ib_size = indices_.size() * sizeof(indices_[0]);
-        if ( index_buffer_ && index_buffer_->buffer_size() >= min_ib_size ) {
-            render_.update_buffer(index_buffer_, indices_, 0u);
-        } else {
+        first_index_ = 0;
+        if ( indices_.empty() ) {
+            return;
+        }
+
+        if ( first_vertex_ ) {
+            std::transform(
+                indices_.begin(), indices_.end(), indices_.begin(),
+                [add = first_vertex_](index_type v) noexcept {
+                    return static_cast<index_type>(v + add);
+                });
+        }
+
+        const std::size_t min_ib_size = indices_.size() * sizeof(index_type);
+        auto region = index_buffer_
+            ? index_ring_.allocate(min_ib_size, sizeof(index_type))
+            : std::nullopt;
+
+        if ( !region ) {
             const std::size_t new_ib_size = calculate_new_buffer_size(
-                sizeof(Index),
+                sizeof(index_type),
                 index_buffer_ ? index_buffer_->buffer_size() : 0u,
-                min_ib_size);
-
-            buffer new_ib_data(new_ib_size);
-            std::memcpy(new_ib_data.data(), indices_.data(), min_ib_size);
+                min_ib_size,
+                std::size_t(-1));
 
             index_buffer_ = render_.create_index_buffer(
-                new_ib_data,
+                new_ib_size,
                 index_decl_,
                 index_buffer::usage::dynamic_draw);
 
@@ -218,26 +434,46 @@ namespace e2d::render_system_impl
                 debug_.error("BATCHER: Failed to create index buffer:\n"
                     "--> Size: %0",
                     new_ib_size);
+                return;
             }
+
+            region = index_ring_
+                .reset(new_ib_size)
+                .allocate(min_ib_size, sizeof(index_type));
+            E2D_ASSERT(region && !region->orphaned);
+        } else if ( region->orphaned ) {
+            render_.orphan_buffer(index_buffer_);
         }
+
+        first_index_ = region->offset / sizeof(index_type);
+        render_.update_buffer(index_buffer_, indices_, first_index_);
     }
 
     template < typename Index, typename Vertex >
     void batcher<Index, Vertex>::update_vertex_buffer_() {
-        const std::size_t min_vb_size = vertices_.size() * sizeof(vertices_[0]);
-        if ( vertex_buffer_ && vertex_buffer_->buffer_size() >= min_vb_size ) {
-            render_.update_buffer(vertex_buffer_, vertices_, 0u);
-        } else {
+        first_vertex_ = 0;
+        if ( vertices_.empty() ) {
+            return;
+        }
+
+        // rebased indices must still fit the index type
+        const std::size_t max_vb_size =
+            (std::size_t(std::numeric_limits<index_type>::max()) + 1u) * sizeof(vertex_type);
+
+        const std::size_t min_vb_size = vertices_.size() * sizeof(vertex_type);
+        auto region = vertex_buffer_
+            ? vertex_ring_.allocate(min_vb_size, sizeof(vertex_type))
+            : std::nullopt;
+
+        if ( !region ) {
             const std::size_t new_vb_size = calculate_new_buffer_size(
-                sizeof(Vertex),
+                sizeof(vertex_type),
                 vertex_buffer_ ? vertex_buffer_->buffer_size() : 0u,
-                min_vb_size);
-
-            buffer new_vb_data(new_vb_size);
-            std::memcpy(new_vb_data.data(), vertices_.data(), min_vb_size);
+                min_vb_size,
+                max_vb_size);
 
             vertex_buffer_ = render_.create_vertex_buffer(
-                new_vb_data,
+                new_vb_size,
                 vertex_decl_,
                 vertex_buffer::usage::dynamic_draw);
 
@@ -245,15 +481,26 @@ namespace e2d::render_system_impl
                 debug_.error("BATCHER: Failed to create vertex buffer:\n"
                     "--> Size: %0",
                     new_vb_size);
+                return;
             }
+
+            region = vertex_ring_
+                .reset(new_vb_size)
+                .allocate(min_vb_size, sizeof(vertex_type));
+            E2D_ASSERT(region && !region->orphaned);
+        } else if ( region->orphaned ) {
+            render_.orphan_buffer(vertex_buffer_);
         }
+
+        first_vertex_ = region->offset / sizeof(vertex_type);
+        render_.update_buffer(vertex_buffer_, vertices_, first_vertex_);
     }
 
     template < typename Index, typename Vertex >
     std::size_t batcher<Index, Vertex>::calculate_new_buffer_size(
-        std::size_t esize, std::size_t osize, std::size_t nsize)
+        std::size_t esize, std::size_t osize, std::size_t nsize, std::size_t msize)
     {
-        std::size_t msize = std::size_t(-1) / esize * esize;
+        msize = math::min(msize, std::size_t(-1) / esize * esize);
         if ( nsize > msize ) {
             throw bad_batcher_operation();
         }
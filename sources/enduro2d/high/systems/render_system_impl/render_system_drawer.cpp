@@ -15,20 +15,72 @@ namespace
 {
     using namespace e2d;
 
-    const str_hash screen_s_property_hash = "u_screen_s";
+    constexpr str_hash screen_s_property_hash = "u_screen_s"_hash;
+
+    constexpr str_hash matrix_m_property_hash = "u_matrix_m"_hash;
+    constexpr str_hash matrix_v_property_hash = "u_matrix_v"_hash;
+    constexpr str_hash matrix_p_property_hash = "u_matrix_p"_hash;
+    constexpr str_hash matrix_vp_property_hash = "u_matrix_vp"_hash;
+
+    constexpr str_hash time_property_hash = "u_time"_hash;
+    constexpr str_hash texture_sampler_hash = "u_texture"_hash;
+
+    constexpr str_hash normal_material_hash = "normal"_hash;
+    constexpr str_hash additive_material_hash = "additive"_hash;
+    constexpr str_hash multiply_material_hash = "multiply"_hash;
+    constexpr str_hash screen_material_hash = "screen"_hash;
+
+    [[maybe_unused]] const bool hash_literals_registered =
+        str_hash::register_literal(screen_s_property_hash, "u_screen_s") &&
+        str_hash::register_literal(matrix_m_property_hash, "u_matrix_m") &&
+        str_hash::register_literal(matrix_v_property_hash, "u_matrix_v") &&
+        str_hash::register_literal(matrix_p_property_hash, "u_matrix_p") &&
+        str_hash::register_literal(matrix_vp_property_hash, "u_matrix_vp") &&
+        str_hash::register_literal(time_property_hash, "u_time") &&
+        str_hash::register_literal(texture_sampler_hash, "u_texture") &&
+        str_hash::register_literal(normal_material_hash, "normal") &&
+        str_hash::register_literal(additive_material_hash, "additive") &&
+        str_hash::register_literal(multiply_material_hash, "multiply") &&
+        str_hash::register_literal(screen_material_hash, "screen");
+
+    const std::size_t max_sprite_job_chunks = 8u;
+    const std::size_t min_sprite_jobs_per_chunk = 256u;
+
+    using render_system_impl::drawer;
+
+    void generate_sprite_vertices(
+        const drawer::sprite_job* jobs,
+        std::size_t job_count,
+        drawer::batcher_type::vertex_type* vertices) noexcept
+    {
+        // v4f{x, y, 0, 1} * model_m == x * axis_x + y * axis_y + origin,
+        // so a grid of positions is the sum of precomputed columns and rows
 
-    const str_hash matrix_m_property_hash = "u_matrix_m";
-    const str_hash matrix_v_property_hash = "u_matrix_v";
-    const str_hash matrix_p_property_hash = "u_matrix_p";
-    const str_hash matrix_vp_property_hash = "u_matrix_vp";
+        for ( std::size_t i = 0; i < job_count; ++i ) {
+            const drawer::sprite_job& job = jobs[i];
+            const std::size_t grid_size = job.grid_size;
 
-    const str_hash time_property_hash = "u_time";
-    const str_hash texture_sampler_hash = "u_texture";
+            v3f columns[4];
+            for ( std::size_t x = 0; x < grid_size; ++x ) {
+                columns[x] = job.axis_x * job.pos_xs[x] + job.origin;
+            }
 
-    const str_hash normal_material_hash = "normal";
-    const str_hash additive_material_hash = "additive";
-    const str_hash multiply_material_hash = "multiply";
-    const str_hash screen_material_hash = "screen";
+            v3f rows[4];
+            for ( std::size_t y = 0; y < grid_size; ++y ) {
+                rows[y] = job.axis_y * job.pos_ys[y];
+            }
+
+            drawer::batcher_type::vertex_type* dst = vertices + job.first_vertex;
+            for ( std::size_t y = 0; y < grid_size; ++y ) {
+                for ( std::size_t x = 0; x < grid_size; ++x ) {
+                    dst->v = columns[x] + rows[y];
+                    dst->t = v2f{job.tex_xs[x], job.tex_ys[y]};
+                    dst->c = job.tint;
+                    ++dst;
+                }
+            }
+        }
+    }
 }
 
 namespace e2d::render_system_impl
@@ -40,22 +92,28 @@ namespace e2d::render_system_impl
     drawer::context::context(
         const camera& cam,
         engine& engine,
+        deferrer& deferrer,
         render& render,
         window& window,
-        batcher_type& batcher)
-    : render_(render)
+        batcher_type& batcher,
+        vector<sprite_job>& sprite_jobs)
+    : deferrer_(deferrer)
+    , render_(render)
     , batcher_(batcher)
+    , sprite_jobs_(sprite_jobs)
+    , view_proj_(cam.view() * cam.projection())
     {
         const m4f& m_v = cam.view();
         const m4f& m_p = cam.projection();
 
+        batcher_.next_frame(engine.frame_count());
         batcher_.flush()
             .property(screen_s_property_hash, cam.target()
                 ? cam.target()->size().cast_to<f32>()
                 : window.framebuffer_size().cast_to<f32>())
             .property(matrix_v_property_hash, m_v)
             .property(matrix_p_property_hash, m_p)
-            .property(matrix_vp_property_hash, m_v * m_p)
+            .property(matrix_vp_property_hash, view_proj_)
             .property(time_property_hash, engine.time());
 
         const v2u target_size = cam.target()
@@ -77,6 +135,7 @@ namespace e2d::render_system_impl
     }
 
     drawer::context::~context() noexcept {
+        sprite_jobs_.clear();
         batcher_.clear(true);
     }
 
@@ -92,23 +151,44 @@ namespace e2d::render_system_impl
             return;
         }
 
+        const gcomponent<model_renderer> mdl_r{owner};
+        const gcomponent<sprite_renderer> spr_r{owner};
+
+        if ( !mdl_r && !spr_r ) {
+            return;
+        }
+
         const m4f& model_m =
             math::make_trs_matrix4(node_r->transform()) *
             node->world_matrix();
 
-        if ( auto mdl_r = gcomponent<model_renderer>{owner} ) {
+        // models have no precomputed bounds, so only sprites are culled
+        std::optional<b2f> bounds;
+        if ( !mdl_r && !is_visible(model_m, *spr_r, bounds) ) {
+            ++stats_.culled_nodes;
+            return;
+        }
+
+        ++stats_.drawn_nodes;
+
+        if ( mdl_r ) {
             draw(model_m, *node_r, *mdl_r);
         }
 
-        if ( auto spr_r = gcomponent<sprite_renderer>{owner} ) {
-            draw(model_m, *node_r, *spr_r);
+        if ( spr_r ) {
+            draw(model_m, *node_r, *spr_r, bounds);
         }
     }
 
     void drawer::context::flush() {
+        complete_sprite_jobs();
         batcher_.flush();
     }
 
+    const drawer::statistics& drawer::context::stats() const noexcept {
+        return stats_;
+    }
+
     void drawer::context::draw(
         const m4f& model_m,
         const renderer& node_r,
@@ -125,6 +205,8 @@ namespace e2d::render_system_impl
             property_cache_.clear();
         });
 
+        complete_sprite_jobs();
+
         property_cache_
             .merge(batcher_.flush())
             .property(matrix_m_property_hash, model_m)
@@ -151,7 +233,8 @@ namespace e2d::render_system_impl
     void drawer::context::draw(
         const m4f& model_m,
         const renderer& node_r,
-        const sprite_renderer& spr_r)
+        const sprite_renderer& spr_r,
+        const std::optional<b2f>& bounds)
     {
         if ( !spr_r.sprite() ) {
             return;
@@ -207,6 +290,15 @@ namespace e2d::render_system_impl
                 .filter(tex_min_f, tex_mag_f))
             .merge(node_r.properties());
 
+        // vertex positions depend only on the 2D affine part of the model matrix,
+        // because all sprite corners lie in the z=0 plane of the node
+
+        sprite_job job;
+        job.axis_x = v3f(model_m.rows[0]);
+        job.axis_y = v3f(model_m.rows[1]);
+        job.origin = v3f(model_m.rows[3]);
+        job.tint = spr_r.tint();
+
         if ( spr_r.mode() == sprite_renderer::modes::simple ) {
 
             // 2 -------- 3
@@ -220,38 +312,31 @@ namespace e2d::render_system_impl
 
             const v2f size = outer_r.size * spr_r.scale();
 
-            const v2f pos_xs = v2f{
-                0.f, size.x};
+            job.grid_size = 2u;
+
+            job.pos_xs = v4f{
+                0.f, size.x, 0.f, 0.f};
 
-            const v2f pos_ys = v2f{
-                0.f, size.y};
+            job.pos_ys = v4f{
+                0.f, size.y, 0.f, 0.f};
 
-            const v2f tex_xs = v2f{
+            job.tex_xs = v4f{
                 outer_r.position.x,
-                outer_r.position.x + outer_r.size.x} / tex_s.x;
+                outer_r.position.x + outer_r.size.x, 0.f, 0.f} / tex_s.x;
 
-            const v2f tex_ys = v2f{
+            job.tex_ys = v4f{
                 outer_r.position.y,
-                outer_r.position.y + outer_r.size.y} / tex_s.y;
-
-            const color32& tc = spr_r.tint();
+                outer_r.position.y + outer_r.size.y, 0.f, 0.f} / tex_s.y;
 
             const batcher_type::index_type indices[] = {
                 0, 1, 3, 3, 2, 0,
             };
 
-            const batcher_type::vertex_type vertices[] = {
-                { v3f{v4f{pos_xs[0], pos_ys[0], 0.f, 1.f} * model_m}, v2f{tex_xs[0], tex_ys[0]}, tc },
-                { v3f{v4f{pos_xs[1], pos_ys[0], 0.f, 1.f} * model_m}, v2f{tex_xs[1], tex_ys[0]}, tc },
-                { v3f{v4f{pos_xs[0], pos_ys[1], 0.f, 1.f} * model_m}, v2f{tex_xs[0], tex_ys[1]}, tc },
-                { v3f{v4f{pos_xs[1], pos_ys[1], 0.f, 1.f} * model_m}, v2f{tex_xs[1], tex_ys[1]}, tc },
-            };
-
-            batcher_.batch(
+            batch(
                 mat_a,
-                property_cache_,
                 indices, std::size(indices),
-                vertices, std::size(vertices));
+                job,
+                bounds);
         } else if ( spr_r.mode() == sprite_renderer::modes::sliced ) {
 
             // 12 13 ********* 14 15
@@ -286,32 +371,32 @@ namespace e2d::render_system_impl
             const f32 adj_bottom = math::min(bottom, max_bottom);
             const f32 adj_top = math::min(top, max_top);
 
-            const v4f pos_xs = v4f{
+            job.grid_size = 4u;
+
+            job.pos_xs = v4f{
                 0.f,
                 adj_left,
                 size.x - adj_right,
                 size.x};
 
-            const v4f pos_ys = v4f{
+            job.pos_ys = v4f{
                 0.f,
                 adj_bottom,
                 size.y - adj_top,
                 size.y};
 
-            const v4f tex_xs = v4f{
+            job.tex_xs = v4f{
                 outer_r.position.x,
                 outer_r.position.x + adj_left,
                 outer_r.position.x + outer_r.size.x - adj_right,
                 outer_r.position.x + outer_r.size.x} / tex_s.x;
 
-            const v4f tex_ys = v4f{
+            job.tex_ys = v4f{
                 outer_r.position.y,
                 outer_r.position.y + adj_bottom,
                 outer_r.position.y + outer_r.size.y - adj_top,
                 outer_r.position.y + outer_r.size.y} / tex_s.y;
 
-            const color32& tc = spr_r.tint();
-
             const batcher_type::index_type indices[] = {
                 0, 1, 5, 5, 4, 0,
                 1, 2, 6, 6, 5, 1,
@@ -326,44 +411,159 @@ namespace e2d::render_system_impl
                 10, 11, 15, 15, 14, 10,
             };
 
-            const batcher_type::vertex_type vertices[] = {
-                { v3f{v4f{pos_xs[0], pos_ys[0], 0.f, 1.f} * model_m}, v2f{tex_xs[0], tex_ys[0]}, tc },
-                { v3f{v4f{pos_xs[1], pos_ys[0], 0.f, 1.f} * model_m}, v2f{tex_xs[1], tex_ys[0]}, tc },
-                { v3f{v4f{pos_xs[2], pos_ys[0], 0.f, 1.f} * model_m}, v2f{tex_xs[2], tex_ys[0]}, tc },
-                { v3f{v4f{pos_xs[3], pos_ys[0], 0.f, 1.f} * model_m}, v2f{tex_xs[3], tex_ys[0]}, tc },
-
-                { v3f{v4f{pos_xs[0], pos_ys[1], 0.f, 1.f} * model_m}, v2f{tex_xs[0], tex_ys[1]}, tc },
-                { v3f{v4f{pos_xs[1], pos_ys[1], 0.f, 1.f} * model_m}, v2f{tex_xs[1], tex_ys[1]}, tc },
-                { v3f{v4f{pos_xs[2], pos_ys[1], 0.f, 1.f} * model_m}, v2f{tex_xs[2], tex_ys[1]}, tc },
-                { v3f{v4f{pos_xs[3], pos_ys[1], 0.f, 1.f} * model_m}, v2f{tex_xs[3], tex_ys[1]}, tc },
-
-                { v3f{v4f{pos_xs[0], pos_ys[2], 0.f, 1.f} * model_m}, v2f{tex_xs[0], tex_ys[2]}, tc },
-                { v3f{v4f{pos_xs[1], pos_ys[2], 0.f, 1.f} * model_m}, v2f{tex_xs[1], tex_ys[2]}, tc },
-                { v3f{v4f{pos_xs[2], pos_ys[2], 0.f, 1.f} * model_m}, v2f{tex_xs[2], tex_ys[2]}, tc },
-                { v3f{v4f{pos_xs[3], pos_ys[2], 0.f, 1.f} * model_m}, v2f{tex_xs[3], tex_ys[2]}, tc },
-
-                { v3f{v4f{pos_xs[0], pos_ys[3], 0.f, 1.f} * model_m}, v2f{tex_xs[0], tex_ys[3]}, tc },
-                { v3f{v4f{pos_xs[1], pos_ys[3], 0.f, 1.f} * model_m}, v2f{tex_xs[1], tex_ys[3]}, tc },
-                { v3f{v4f{pos_xs[2], pos_ys[3], 0.f, 1.f} * model_m}, v2f{tex_xs[2], tex_ys[3]}, tc },
-                { v3f{v4f{pos_xs[3], pos_ys[3], 0.f, 1.f} * model_m}, v2f{tex_xs[3], tex_ys[3]}, tc },
-            };
-
-            batcher_.batch(
+            batch(
                 mat_a,
-                property_cache_,
                 indices, std::size(indices),
-                vertices, std::size(vertices));
+                job,
+                bounds);
         } else {
             E2D_ASSERT_MSG(false, "unexpected sprite mode");
         }
     }
 
+    void drawer::context::batch(
+        const material_asset::ptr& material,
+        const batcher_type::index_type* indices,
+        std::size_t index_count,
+        sprite_job& job,
+        const std::optional<b2f>& bounds)
+    {
+        const std::size_t vertex_count = job.grid_size * job.grid_size;
+
+        // the batcher flushes when it runs out of indices,
+        // so all reserved vertices must be filled before that
+        if ( !batcher_.has_room_for(vertex_count) ) {
+            complete_sprite_jobs();
+        }
+
+        job.first_vertex = batcher_.reserve(
+            material,
+            property_cache_,
+            indices, index_count,
+            vertex_count,
+            bounds);
+
+        sprite_jobs_.push_back(job);
+    }
+
+    void drawer::context::complete_sprite_jobs() {
+        if ( sprite_jobs_.empty() ) {
+            return;
+        }
+
+        DEFER_HPP([this](){
+            sprite_jobs_.clear();
+        });
+
+        batcher_type::vertex_type* vertices = batcher_.vertex_data();
+        const std::size_t chunk_count = math::min(
+            max_sprite_job_chunks,
+            (sprite_jobs_.size() + min_sprite_jobs_per_chunk - 1u) / min_sprite_jobs_per_chunk);
+
+        if ( chunk_count < 2u ) {
+            generate_sprite_vertices(sprite_jobs_.data(), sprite_jobs_.size(), vertices);
+            return;
+        }
+
+        // chunks are claimed by the main thread and the workers alike,
+        // so busy workers never stall the frame: the main thread just
+        // processes all unclaimed chunks itself
+
+        struct shared_state {
+            std::atomic<std::size_t> next_chunk{0u};
+            std::atomic<std::size_t> done_chunks{0u};
+            std::size_t chunk_count{0u};
+            std::size_t job_count{0u};
+            const sprite_job* jobs{nullptr};
+            batcher_type::vertex_type* vertices{nullptr};
+        };
+
+        auto state = std::make_shared<shared_state>();
+        state->chunk_count = chunk_count;
+        state->job_count = sprite_jobs_.size();
+        state->jobs = sprite_jobs_.data();
+        state->vertices = vertices;
+
+        const auto process_chunks = [](shared_state& st) noexcept {
+            for ( std::size_t chunk = st.next_chunk++; chunk < st.chunk_count; chunk = st.next_chunk++ ) {
+                const std::size_t first = st.job_count * chunk / st.chunk_count;
+                const std::size_t last = st.job_count * (chunk + 1u) / st.chunk_count;
+                generate_sprite_vertices(st.jobs + first, last - first, st.vertices);
+                ++st.done_chunks;
+            }
+        };
+
+        for ( std::size_t i = 1; i < chunk_count; ++i ) {
+            deferrer_.do_in_worker_thread([state, process_chunks](){
+                process_chunks(*state);
+            });
+        }
+
+        process_chunks(*state);
+
+        while ( state->done_chunks < chunk_count ) {
+            std::this_thread::yield();
+        }
+    }
+
+    bool drawer::context::is_visible(
+        const m4f& model_m,
+        const sprite_renderer& spr_r,
+        std::optional<b2f>& bounds) const noexcept
+    {
+        if ( !spr_r.sprite() ) {
+            return true;
+        }
+
+        const b2f& outer_r = spr_r.sprite()->content().outer_texrect();
+        const v2f size = outer_r.size * spr_r.scale();
+        const m4f model_vp = model_m * view_proj_;
+
+        const v4f corners[] = {
+            v4f{0.f, 0.f, 0.f, 1.f} * model_vp,
+            v4f{size.x, 0.f, 0.f, 1.f} * model_vp,
+            v4f{0.f, size.y, 0.f, 1.f} * model_vp,
+            v4f{size.x, size.y, 0.f, 1.f} * model_vp,
+        };
+
+        const auto all_corners = [&corners](auto&& pred) noexcept {
+            return std::all_of(std::begin(corners), std::end(corners), pred);
+        };
+
+        // the sprite is invisible only when all its corners
+        // lie outside of the same clipping plane
+
+        const bool visible =
+            !all_corners([](const v4f& c) noexcept { return c.x < -c.w; }) &&
+            !all_corners([](const v4f& c) noexcept { return c.x > c.w; }) &&
+            !all_corners([](const v4f& c) noexcept { return c.y < -c.w; }) &&
+            !all_corners([](const v4f& c) noexcept { return c.y > c.w; });
+
+        // screen bounds are known only when the sprite is fully in front of the camera,
+        // the batcher keeps the order of sprites without bounds
+
+        bounds.reset();
+        if ( visible && all_corners([](const v4f& c) noexcept { return c.w > 0.f; }) ) {
+            v2f min = v2f(corners[0]) / corners[0].w;
+            v2f max = min;
+            for ( const v4f& c : corners ) {
+                const v2f p = v2f(c) / c.w;
+                min = math::minimized(min, p);
+                max = math::maximized(max, p);
+            }
+            bounds = make_minmax_rect(min, max);
+        }
+
+        return visible;
+    }
+
     //
     // drawer
     //
 
-    drawer::drawer(engine& e, debug& d, render& r, window& w)
+    drawer::drawer(engine& e, debug& d, deferrer& df, render& r, window& w)
     : engine_(e)
+    , deferrer_(df)
     , render_(r)
     , window_(w)
     , batcher_(d, r) {}
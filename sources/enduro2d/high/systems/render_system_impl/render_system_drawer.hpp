@@ -29,18 +29,40 @@ namespace e2d::render_system_impl
             index_u16,
             vertex_v3f_t2f_c32b>;
 
+        struct statistics {
+            std::size_t drawn_nodes{0u};
+            std::size_t culled_nodes{0u};
+        };
+
+        struct sprite_job {
+            std::size_t first_vertex{0u};
+            std::size_t grid_size{0u};
+            v3f axis_x;
+            v3f axis_y;
+            v3f origin;
+            v4f pos_xs;
+            v4f pos_ys;
+            v4f tex_xs;
+            v4f tex_ys;
+            color32 tint;
+        };
+
         class context : noncopyable {
         public:
             context(
                 const camera& cam,
                 engine& engine,
+                deferrer& deferrer,
                 render& render,
                 window& window,
-                batcher_type& batcher);
+                batcher_type& batcher,
+                vector<sprite_job>& sprite_jobs);
             ~context() noexcept;
 
             void draw(const const_node_iptr& node);
             void flush();
+
+            const statistics& stats() const noexcept;
         private:
             void draw(
                 const m4f& model_m,
@@ -50,31 +72,53 @@ namespace e2d::render_system_impl
             void draw(
                 const m4f& model_m,
                 const renderer& node_r,
-                const sprite_renderer& spr_r);
+                const sprite_renderer& spr_r,
+                const std::optional<b2f>& bounds);
+
+            bool is_visible(
+                const m4f& model_m,
+                const sprite_renderer& spr_r,
+                std::optional<b2f>& bounds) const noexcept;
+
+            void batch(
+                const material_asset::ptr& material,
+                const batcher_type::index_type* indices,
+                std::size_t index_count,
+                sprite_job& job,
+                const std::optional<b2f>& bounds);
+
+            void complete_sprite_jobs();
         private:
+            deferrer& deferrer_;
             render& render_;
             batcher_type& batcher_;
+            vector<sprite_job>& sprite_jobs_;
             render::property_block property_cache_;
+            m4f view_proj_;
+            statistics stats_;
         };
     public:
-        drawer(engine& e, debug& d, render& r, window& w);
+        drawer(engine& e, debug& d, deferrer& df, render& r, window& w);
 
         template < typename F >
-        void with(const camera& cam, F&& f);
+        statistics with(const camera& cam, F&& f);
     private:
         engine& engine_;
+        deferrer& deferrer_;
         render& render_;
         window& window_;
         batcher_type batcher_;
+        vector<sprite_job> sprite_jobs_;
     };
 }
 
 namespace e2d::render_system_impl
 {
     template < typename F >
-    void drawer::with(const camera& cam, F&& f) {
-        context ctx{cam, engine_, render_, window_, batcher_};
+    drawer::statistics drawer::with(const camera& cam, F&& f) {
+        context ctx{cam, engine_, deferrer_, render_, window_, batcher_, sprite_jobs_};
         std::forward<F>(f)(ctx);
         ctx.flush();
+        return ctx.stats();
     }
 }
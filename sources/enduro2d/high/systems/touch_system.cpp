@@ -34,14 +34,17 @@ namespace e2d
         }
 
         void process_update(ecs::registry& owner) {
-            update_world_space_colliders(owner);
-            update_world_space_colliders_under_mouse(input_, window_, owner);
+            ++update_stamp_;
+            update_world_space_colliders(owner, collider_tree_, update_stamp_);
+            update_world_space_colliders_under_mouse(input_, window_, owner, collider_tree_);
             dispatcher_.dispatch_all_events(owner);
         }
     private:
         input& input_;
         window& window_;
         dispatcher& dispatcher_;
+        collider_tree collider_tree_;
+        u32 update_stamp_{0u};
     };
 
     //
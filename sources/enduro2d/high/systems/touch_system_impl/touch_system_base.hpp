@@ -16,23 +16,37 @@
 #include <enduro2d/high/components/scene.hpp>
 #include <enduro2d/high/components/touchable.hpp>
 
+#include "touch_system_tree.hpp"
+
 namespace e2d::touch_system_impl
 {
     class touchable_under_mouse final {
     };
 
+    // world space colliders are recalculated only when the world matrix
+    // version of the node or the local space collider has been changed
+
     struct world_space_rect_collider final {
         using local_space_collider_t = rect_collider;
         std::array<v3f, 4> points{};
+        rect_collider source{};
+        u32 world_version{0u};
+        u32 proxy{collider_tree::null_proxy};
     };
 
     struct world_space_circle_collider final {
         using local_space_collider_t = circle_collider;
         std::array<v3f, 12> points{};
+        circle_collider source{};
+        u32 world_version{0u};
+        u32 proxy{collider_tree::null_proxy};
     };
 
     struct world_space_polygon_collider final {
         using local_space_collider_t = polygon_collider;
         vector<v3f> points{};
+        polygon_collider source{};
+        u32 world_version{0u};
+        u32 proxy{collider_tree::null_proxy};
     };
 }
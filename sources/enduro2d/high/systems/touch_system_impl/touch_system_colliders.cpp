@@ -69,6 +69,33 @@ namespace e2d::touch_system_impl::impl
     }
 }
 
+namespace e2d::touch_system_impl::impl
+{
+    bool is_same_local_space_collider(
+        const rect_collider& l,
+        const rect_collider& r) noexcept
+    {
+        return l.offset() == r.offset()
+            && l.size() == r.size();
+    }
+
+    bool is_same_local_space_collider(
+        const circle_collider& l,
+        const circle_collider& r) noexcept
+    {
+        return l.offset() == r.offset()
+            && l.radius() == r.radius();
+    }
+
+    bool is_same_local_space_collider(
+        const polygon_collider& l,
+        const polygon_collider& r) noexcept
+    {
+        return l.offset() == r.offset()
+            && l.points() == r.points();
+    }
+}
+
 namespace e2d::touch_system_impl::impl
 {
     bool is_world_space_collider_under_mouse(
@@ -148,15 +175,25 @@ namespace e2d::touch_system_impl::impl
 
 namespace e2d::touch_system_impl
 {
-    void update_world_space_colliders(ecs::registry& owner) {
-        impl::update_world_space_colliders<world_space_rect_collider>(owner);
-        impl::update_world_space_colliders<world_space_circle_collider>(owner);
-        impl::update_world_space_colliders<world_space_polygon_collider>(owner);
+    void update_world_space_colliders(
+        ecs::registry& owner,
+        collider_tree& tree,
+        u32 stamp)
+    {
+        impl::update_world_space_colliders<world_space_rect_collider>(owner, tree, stamp);
+        impl::update_world_space_colliders<world_space_circle_collider>(owner, tree, stamp);
+        impl::update_world_space_colliders<world_space_polygon_collider>(owner, tree, stamp);
+        tree.destroy_untouched_proxies(stamp);
     }
 
-    void update_world_space_colliders_under_mouse(input& input, window& window, ecs::registry& owner) {
+    void update_world_space_colliders_under_mouse(
+        input& input,
+        window& window,
+        ecs::registry& owner,
+        const collider_tree& tree)
+    {
         owner.remove_all_components<touchable_under_mouse>();
-        owner.for_joined_components<camera::input, camera>([&input, &window, &owner](
+        owner.for_joined_components<camera::input, camera>([&input, &window, &tree](
             const ecs::const_entity&,
             const camera::input&,
             const camera& camera)
@@ -182,23 +219,37 @@ namespace e2d::touch_system_impl
                 return;
             }
 
-            impl::update_world_space_colliders_under_mouse<world_space_rect_collider>(
-                owner,
-                mouse_p,
-                camera_vp,
-                camera_viewport);
-
-            impl::update_world_space_colliders_under_mouse<world_space_circle_collider>(
-                owner,
-                mouse_p,
-                camera_vp,
-                camera_viewport);
-
-            impl::update_world_space_colliders_under_mouse<world_space_polygon_collider>(
-                owner,
-                mouse_p,
-                camera_vp,
-                camera_viewport);
+            const auto [inv_camera_vp, inv_camera_vp_success] = math::inversed(camera_vp);
+            if ( !inv_camera_vp_success ) {
+                return;
+            }
+
+            // the mouse ray between the near and far planes, colliders
+            // under the mouse intersect it, so their bounds overlap its ones
+            const auto [ray_near, ray_near_success] = math::unproject(
+                v3f(mouse_p, 0.f), inv_camera_vp, camera_viewport);
+            const auto [ray_far, ray_far_success] = math::unproject(
+                v3f(mouse_p, 1.f), inv_camera_vp, camera_viewport);
+            if ( !ray_near_success || !ray_far_success ) {
+                return;
+            }
+
+            tree.query(math::make_minmax_rect(v2f(ray_near), v2f(ray_far)), [
+                &mouse_p,
+                &camera_vp,
+                &camera_viewport
+            ](gobject owner){
+                const bool under_mouse =
+                    impl::is_owner_collider_under_mouse<world_space_rect_collider>(
+                        owner, mouse_p, camera_vp, camera_viewport) ||
+                    impl::is_owner_collider_under_mouse<world_space_circle_collider>(
+                        owner, mouse_p, camera_vp, camera_viewport) ||
+                    impl::is_owner_collider_under_mouse<world_space_polygon_collider>(
+                        owner, mouse_p, camera_vp, camera_viewport);
+                if ( under_mouse ) {
+                    owner.component<touchable_under_mouse>().ensure();
+                }
+            });
         }, !ecs::exists_any<
             disabled<actor>,
             disabled<camera>>());
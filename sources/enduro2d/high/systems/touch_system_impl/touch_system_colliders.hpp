@@ -27,14 +27,47 @@ namespace e2d::touch_system_impl
             const polygon_collider& src,
             const m4f& local_to_world);
 
+        bool is_same_local_space_collider(
+            const rect_collider& l,
+            const rect_collider& r) noexcept;
+
+        bool is_same_local_space_collider(
+            const circle_collider& l,
+            const circle_collider& r) noexcept;
+
+        bool is_same_local_space_collider(
+            const polygon_collider& l,
+            const polygon_collider& r) noexcept;
+
+        template < typename Points >
+        b2f world_space_collider_bounds(const Points& points) noexcept {
+            if ( points.empty() ) {
+                return b2f::zero();
+            }
+            v2f min = v2f(points.front());
+            v2f max = v2f(points.front());
+            for ( const v3f& p : points ) {
+                min = math::minimized(min, v2f(p));
+                max = math::maximized(max, v2f(p));
+            }
+            return b2f(min, max - min);
+        }
+
         template < typename WorldSpaceCollider >
-        void update_world_space_colliders(ecs::registry& owner) {
+        void update_world_space_colliders(
+            ecs::registry& owner,
+            collider_tree& tree,
+            u32 stamp)
+        {
             using world_space_collider_t = WorldSpaceCollider;
             using local_space_collider_t = typename WorldSpaceCollider::local_space_collider_t;
 
+            // must be the exact complement of the update filter below, a world space
+            // collider that is left out keeps a proxy destroyed by the sweep
             ecsex::remove_all_components<world_space_collider_t>(
                 owner,
                 !ecs::exists_all<
+                    actor,
                     touchable,
                     local_space_collider_t>() ||
                 ecs::exists_any<
@@ -43,16 +76,38 @@ namespace e2d::touch_system_impl
                     disabled<world_space_collider_t>,
                     disabled<local_space_collider_t>>());
 
-            owner.for_joined_components<local_space_collider_t, touchable, actor>([](
+            owner.for_joined_components<local_space_collider_t, touchable, actor>([&tree, stamp](
                 ecs::entity e,
                 const local_space_collider_t& src,
                 const touchable&,
                 const actor& a)
             {
-                update_world_space_collider(
-                    e.ensure_component<world_space_collider_t>(),
-                    src,
-                    a.node() ? a.node()->world_matrix() : m4f::identity());
+                const const_node_iptr n = a.node();
+                const u32 world_version = n ? n->world_version() : 0u;
+
+                world_space_collider_t& dst = e.ensure_component<world_space_collider_t>();
+                const bool changed =
+                    dst.proxy == collider_tree::null_proxy ||
+                    dst.world_version != world_version ||
+                    !is_same_local_space_collider(dst.source, src);
+
+                if ( changed ) {
+                    update_world_space_collider(
+                        dst,
+                        src,
+                        n ? n->world_matrix() : m4f::identity());
+                    dst.source = src;
+                    dst.world_version = world_version;
+
+                    const b2f bounds = world_space_collider_bounds(dst.points);
+                    if ( dst.proxy == collider_tree::null_proxy ) {
+                        dst.proxy = tree.create_proxy(bounds, n ? n->owner() : gobject());
+                    } else {
+                        tree.move_proxy(dst.proxy, bounds);
+                    }
+                }
+
+                tree.touch_proxy(dst.proxy, stamp);
             }, !ecs::exists_any<
                 disabled<actor>,
                 disabled<touchable>,
@@ -82,30 +137,28 @@ namespace e2d::touch_system_impl
             const b2f& camera_viewport);
 
         template < typename WorldSpaceCollider >
-        void update_world_space_colliders_under_mouse(
-            ecs::registry& owner,
+        bool is_owner_collider_under_mouse(
+            const gobject& owner,
             const v2f& mouse_p,
             const m4f& camera_vp,
             const b2f& camera_viewport)
         {
-            using world_space_collider_t = WorldSpaceCollider;
-            using local_space_collider_t = typename WorldSpaceCollider::local_space_collider_t;
-
-            owner.for_joined_components<touchable, world_space_collider_t>([
-                &mouse_p,
-                &camera_vp,
-                &camera_viewport
-            ](ecs::entity e, const touchable&, const world_space_collider_t& c){
-                if ( is_world_space_collider_under_mouse(c, mouse_p, camera_vp, camera_viewport) ) {
-                    e.ensure_component<touchable_under_mouse>();
-                }
-            }, !ecs::exists_any<
-                disabled<touchable>,
-                disabled<world_space_collider_t>,
-                disabled<local_space_collider_t>>());
+            const_gcomponent<WorldSpaceCollider> c = owner.component<WorldSpaceCollider>();
+            return c && is_world_space_collider_under_mouse(*c, mouse_p, camera_vp, camera_viewport);
         }
     }
 
-    void update_world_space_colliders(ecs::registry& owner);
-    void update_world_space_colliders_under_mouse(input& input, window& window, ecs::registry& owner);
+    // updates world space colliders and their proxies in the tree,
+    // proxies of removed colliders are destroyed
+    void update_world_space_colliders(
+        ecs::registry& owner,
+        collider_tree& tree,
+        u32 stamp);
+
+    // only candidates from the tree under the mouse ray are tested
+    void update_world_space_colliders_under_mouse(
+        input& input,
+        window& window,
+        ecs::registry& owner,
+        const collider_tree& tree);
 }
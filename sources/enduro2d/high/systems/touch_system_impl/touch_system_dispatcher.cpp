@@ -11,37 +11,110 @@ namespace
     using namespace e2d;
     using namespace e2d::touch_system_impl;
 
-    gobject find_event_target(const ecs::registry& owner) {
-        static thread_local vector<std::tuple<
-            ecs::const_entity,
-            scene,
-            actor>> scenes;
-
-        DEFER_HPP([](){ scenes.clear(); });
-        ecsex::extract_components<scene, actor>(
-            owner,
-            std::back_inserter(scenes),
-            !ecs::exists_any<
+    // the highest depth of enabled scenes the node belongs to
+    std::optional<i32> find_scene_depth(const const_node_iptr& n) {
+        std::optional<i32> depth;
+        for ( const_node_iptr p = n; p; p = p->parent() ) {
+            const gobject owner = p->owner();
+            if ( !owner ) {
+                continue;
+            }
+            const_gcomponent<scene> owner_scene = owner.component<scene>();
+            if ( !owner_scene ) {
+                continue;
+            }
+            const bool scene_disabled = ecs::exists_any<
                 disabled<scene>,
-                disabled<actor>>());
+                disabled<actor>
+            >()(owner.raw_entity());
+            if ( !scene_disabled ) {
+                depth = depth
+                    ? math::max(*depth, owner_scene->depth())
+                    : owner_scene->depth();
+            }
+        }
+        return depth;
+    }
 
-        std::sort(scenes.begin(), scenes.end(), [](const auto& l, const auto& r){
-            return std::get<scene>(l).depth() >= std::get<scene>(r).depth();
-        });
+    // nodes are drawn in the pre-order of the hierarchy,
+    // nodes from different hierarchies are not ordered
+    bool is_drawn_after(const const_node_iptr& l, const const_node_iptr& r) {
+        static thread_local vector<const_node_iptr> l_path;
+        static thread_local vector<const_node_iptr> r_path;
+        DEFER_HPP([](){ l_path.clear(); r_path.clear(); });
 
-        for ( const auto& t : scenes ) {
-            gobject target = nodes::find_component_from_children<touchable_under_mouse>(
-                std::get<actor>(t).node(),
-                nodes::options()
-                    .reversed(true)
-                    .recursive(true)
-                    .include_root(true)).owner();
-            if ( target ) {
-                return target;
-            }
+        for ( const_node_iptr p = l; p; p = p->parent() ) {
+            l_path.push_back(p);
+        }
+
+        for ( const_node_iptr p = r; p; p = p->parent() ) {
+            r_path.push_back(p);
+        }
+
+        auto l_iter = l_path.rbegin();
+        auto r_iter = r_path.rbegin();
+        if ( *l_iter != *r_iter ) {
+            return false;
+        }
+
+        while ( l_iter != l_path.rend() && r_iter != r_path.rend() && *l_iter == *r_iter ) {
+            ++l_iter;
+            ++r_iter;
         }
 
-        return gobject();
+        if ( l_iter == l_path.rend() ) {
+            // l is an ancestor of r or the same node
+            return false;
+        }
+
+        if ( r_iter == r_path.rend() ) {
+            // r is an ancestor of l
+            return true;
+        }
+
+        const const_node_iptr& parent = *std::prev(l_iter);
+        return parent->child_index(*l_iter).first > parent->child_index(*r_iter).first;
+    }
+
+    gobject find_event_target(const ecs::registry& owner) {
+        struct candidate {
+            gobject target;
+            const_node_iptr node;
+            i32 scene_depth{0};
+        };
+
+        std::optional<candidate> best;
+
+        // only touchables under the mouse are ranked: by the depth of
+        // their scene and then by the draw order inside the scene
+        owner.for_joined_components<touchable_under_mouse, actor>([&best](
+            const ecs::const_entity&,
+            const touchable_under_mouse&,
+            const actor& a)
+        {
+            const const_node_iptr n = a.node();
+            if ( !n ) {
+                return;
+            }
+
+            const std::optional<i32> scene_depth = find_scene_depth(n);
+            if ( !scene_depth ) {
+                return;
+            }
+
+            const bool better = !best
+                || *scene_depth > best->scene_depth
+                || (*scene_depth == best->scene_depth && is_drawn_after(n, best->node));
+
+            if ( better ) {
+                best = candidate{n->owner(), n, *scene_depth};
+            }
+        }, !ecs::exists_any<
+            disabled<actor>>());
+
+        return best
+            ? best->target
+            : gobject();
     }
 
     template < typename E >
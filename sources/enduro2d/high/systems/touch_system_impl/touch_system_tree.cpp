@@ -0,0 +1,335 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "touch_system_tree.hpp"
+
+namespace
+{
+    using namespace e2d;
+
+    // relative to the collider size, so the tree works the same
+    // for pixel sized UI and for unit sized world objects
+    const f32 fat_bounds_margin = 0.125f;
+    const f32 max_fat_bounds_margin = 0.5f;
+}
+
+namespace e2d::touch_system_impl
+{
+    //
+    // collider_tree
+    //
+    // Inspired by:
+    // https://github.com/erincatto/box2d/blob/master/src/collision/b2_dynamic_tree.cpp
+    //
+
+    u32 collider_tree::create_proxy(const b2f& bounds, gobject owner) {
+        const u32 proxy = allocate_node_();
+        node& n = nodes_[proxy];
+        n.bounds = fattened_(make_aabb_(bounds), fat_bounds_margin);
+        n.owner = std::move(owner);
+        n.height = 0;
+        insert_leaf_(proxy);
+        ++proxy_count_;
+        return proxy;
+    }
+
+    void collider_tree::destroy_proxy(u32 proxy) noexcept {
+        E2D_ASSERT(proxy < nodes_.size() && is_leaf_(proxy));
+        remove_leaf_(proxy);
+        free_node_(proxy);
+        --proxy_count_;
+    }
+
+    bool collider_tree::move_proxy(u32 proxy, const b2f& bounds) {
+        E2D_ASSERT(proxy < nodes_.size() && is_leaf_(proxy));
+        const aabb tight_bounds = make_aabb_(bounds);
+        const aabb& fat_bounds = nodes_[proxy].bounds;
+        if ( contains_(fat_bounds, tight_bounds)
+            && contains_(fattened_(tight_bounds, max_fat_bounds_margin), fat_bounds) )
+        {
+            return false;
+        }
+        remove_leaf_(proxy);
+        nodes_[proxy].bounds = fattened_(tight_bounds, fat_bounds_margin);
+        insert_leaf_(proxy);
+        return true;
+    }
+
+    void collider_tree::touch_proxy(u32 proxy, u32 stamp) noexcept {
+        E2D_ASSERT(proxy < nodes_.size() && is_leaf_(proxy));
+        nodes_[proxy].stamp = stamp;
+    }
+
+    std::size_t collider_tree::destroy_untouched_proxies(u32 stamp) noexcept {
+        std::size_t count = 0u;
+        for ( std::size_t i = 0, e = nodes_.size(); i < e; ++i ) {
+            const u32 index = math::numeric_cast<u32>(i);
+            if ( is_leaf_(index) && nodes_[index].stamp != stamp ) {
+                destroy_proxy(index);
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    std::size_t collider_tree::proxy_count() const noexcept {
+        return proxy_count_;
+    }
+
+    collider_tree::aabb collider_tree::make_aabb_(const b2f& bounds) noexcept {
+        return {math::minimum(bounds), math::maximum(bounds)};
+    }
+
+    collider_tree::aabb collider_tree::fattened_(const aabb& bounds, f32 margin) noexcept {
+        const v2f d = (bounds.max - bounds.min) * margin;
+        return {bounds.min - d, bounds.max + d};
+    }
+
+    collider_tree::aabb collider_tree::merged_(const aabb& l, const aabb& r) noexcept {
+        return {math::minimized(l.min, r.min), math::maximized(l.max, r.max)};
+    }
+
+    bool collider_tree::contains_(const aabb& outer, const aabb& inner) noexcept {
+        return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y
+            && outer.max.x >= inner.max.x && outer.max.y >= inner.max.y;
+    }
+
+    bool collider_tree::overlaps_(const aabb& l, const aabb& r) noexcept {
+        return l.min.x <= r.max.x && l.max.x >= r.min.x
+            && l.min.y <= r.max.y && l.max.y >= r.min.y;
+    }
+
+    f32 collider_tree::perimeter_(const aabb& bounds) noexcept {
+        return 2.f * ((bounds.max.x - bounds.min.x) + (bounds.max.y - bounds.min.y));
+    }
+
+    bool collider_tree::is_leaf_(u32 index) const noexcept {
+        return nodes_[index].height == 0;
+    }
+
+    u32 collider_tree::allocate_node_() {
+        if ( free_list_ == null_proxy ) {
+            nodes_.emplace_back();
+            return math::numeric_cast<u32>(nodes_.size() - 1u);
+        }
+        const u32 index = free_list_;
+        free_list_ = nodes_[index].child1;
+        nodes_[index] = node();
+        return index;
+    }
+
+    void collider_tree::free_node_(u32 index) noexcept {
+        node& n = nodes_[index];
+        n.owner = gobject();
+        n.parent = null_proxy;
+        n.child1 = free_list_;
+        n.child2 = null_proxy;
+        n.height = -1;
+        free_list_ = index;
+    }
+
+    void collider_tree::insert_leaf_(u32 leaf) {
+        if ( root_ == null_proxy ) {
+            root_ = leaf;
+            nodes_[leaf].parent = null_proxy;
+            return;
+        }
+
+        // find the best sibling by the surface area heuristic
+
+        const aabb leaf_bounds = nodes_[leaf].bounds;
+        u32 index = root_;
+        while ( !is_leaf_(index) ) {
+            const node& n = nodes_[index];
+
+            const f32 area = perimeter_(n.bounds);
+            const f32 combined_area = perimeter_(merged_(n.bounds, leaf_bounds));
+
+            const f32 cost = 2.f * combined_area;
+            const f32 inheritance_cost = 2.f * (combined_area - area);
+
+            const auto child_cost = [this, &leaf_bounds, inheritance_cost](u32 child){
+                const aabb& child_bounds = nodes_[child].bounds;
+                const f32 merged_area = perimeter_(merged_(leaf_bounds, child_bounds));
+                return is_leaf_(child)
+                    ? merged_area + inheritance_cost
+                    : merged_area - perimeter_(child_bounds) + inheritance_cost;
+            };
+
+            const f32 cost1 = child_cost(n.child1);
+            const f32 cost2 = child_cost(n.child2);
+
+            if ( cost < cost1 && cost < cost2 ) {
+                break;
+            }
+
+            index = cost1 < cost2 ? n.child1 : n.child2;
+        }
+
+        // replace the sibling with a new parent of both
+
+        const u32 sibling = index;
+        const u32 old_parent = nodes_[sibling].parent;
+        const u32 new_parent = allocate_node_();
+
+        nodes_[new_parent].parent = old_parent;
+        nodes_[new_parent].bounds = merged_(leaf_bounds, nodes_[sibling].bounds);
+        nodes_[new_parent].height = nodes_[sibling].height + 1;
+        nodes_[new_parent].child1 = sibling;
+        nodes_[new_parent].child2 = leaf;
+
+        if ( old_parent != null_proxy ) {
+            if ( nodes_[old_parent].child1 == sibling ) {
+                nodes_[old_parent].child1 = new_parent;
+            } else {
+                nodes_[old_parent].child2 = new_parent;
+            }
+        } else {
+            root_ = new_parent;
+        }
+
+        nodes_[sibling].parent = new_parent;
+        nodes_[leaf].parent = new_parent;
+
+        refit_from_(new_parent);
+    }
+
+    void collider_tree::remove_leaf_(u32 leaf) noexcept {
+        if ( leaf == root_ ) {
+            root_ = null_proxy;
+            return;
+        }
+
+        const u32 parent = nodes_[leaf].parent;
+        const u32 grand_parent = nodes_[parent].parent;
+        const u32 sibling = nodes_[parent].child1 == leaf
+            ? nodes_[parent].child2
+            : nodes_[parent].child1;
+
+        nodes_[leaf].parent = null_proxy;
+        free_node_(parent);
+
+        if ( grand_parent != null_proxy ) {
+            if ( nodes_[grand_parent].child1 == parent ) {
+                nodes_[grand_parent].child1 = sibling;
+            } else {
+                nodes_[grand_parent].child2 = sibling;
+            }
+            nodes_[sibling].parent = grand_parent;
+            refit_from_(grand_parent);
+        } else {
+            root_ = sibling;
+            nodes_[sibling].parent = null_proxy;
+        }
+    }
+
+    void collider_tree::refit_from_(u32 index) noexcept {
+        while ( index != null_proxy ) {
+            index = balance_(index);
+
+            node& n = nodes_[index];
+            const node& child1 = nodes_[n.child1];
+            const node& child2 = nodes_[n.child2];
+
+            n.height = 1 + math::max(child1.height, child2.height);
+            n.bounds = merged_(child1.bounds, child2.bounds);
+
+            index = n.parent;
+        }
+    }
+
+    u32 collider_tree::balance_(u32 ia) noexcept {
+        node& a = nodes_[ia];
+        if ( is_leaf_(ia) || a.height < 2 ) {
+            return ia;
+        }
+
+        const u32 ib = a.child1;
+        const u32 ic = a.child2;
+        node& b = nodes_[ib];
+        node& c = nodes_[ic];
+
+        const i32 balance = c.height - b.height;
+
+        const auto replace_in_parent = [this, ia](u32 parent, u32 child){
+            if ( parent == null_proxy ) {
+                root_ = child;
+            } else if ( nodes_[parent].child1 == ia ) {
+                nodes_[parent].child1 = child;
+            } else {
+                nodes_[parent].child2 = child;
+            }
+        };
+
+        // rotate c up
+        if ( balance > 1 ) {
+            const u32 i_f = c.child1;
+            const u32 i_g = c.child2;
+            node& f = nodes_[i_f];
+            node& g = nodes_[i_g];
+
+            c.child1 = ia;
+            c.parent = a.parent;
+            a.parent = ic;
+            replace_in_parent(c.parent, ic);
+
+            if ( f.height > g.height ) {
+                c.child2 = i_f;
+                a.child2 = i_g;
+                g.parent = ia;
+                a.bounds = merged_(b.bounds, g.bounds);
+                c.bounds = merged_(a.bounds, f.bounds);
+                a.height = 1 + math::max(b.height, g.height);
+                c.height = 1 + math::max(a.height, f.height);
+            } else {
+                c.child2 = i_g;
+                a.child2 = i_f;
+                f.parent = ia;
+                a.bounds = merged_(b.bounds, f.bounds);
+                c.bounds = merged_(a.bounds, g.bounds);
+                a.height = 1 + math::max(b.height, f.height);
+                c.height = 1 + math::max(a.height, g.height);
+            }
+
+            return ic;
+        }
+
+        // rotate b up
+        if ( balance < -1 ) {
+            const u32 i_d = b.child1;
+            const u32 i_e = b.child2;
+            node& d = nodes_[i_d];
+            node& e = nodes_[i_e];
+
+            b.child1 = ia;
+            b.parent = a.parent;
+            a.parent = ib;
+            replace_in_parent(b.parent, ib);
+
+            if ( d.height > e.height ) {
+                b.child2 = i_d;
+                a.child1 = i_e;
+                e.parent = ia;
+                a.bounds = merged_(c.bounds, e.bounds);
+                b.bounds = merged_(a.bounds, d.bounds);
+                a.height = 1 + math::max(c.height, e.height);
+                b.height = 1 + math::max(a.height, d.height);
+            } else {
+                b.child2 = i_e;
+                a.child1 = i_d;
+                d.parent = ia;
+                a.bounds = merged_(c.bounds, d.bounds);
+                b.bounds = merged_(a.bounds, e.bounds);
+                a.height = 1 + math::max(c.height, d.height);
+                b.height = 1 + math::max(a.height, e.height);
+            }
+
+            return ib;
+        }
+
+        return ia;
+    }
+}
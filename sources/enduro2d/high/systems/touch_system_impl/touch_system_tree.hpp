@@ -0,0 +1,113 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include <enduro2d/high/_high.hpp>
+#include <enduro2d/high/gobject.hpp>
+
+namespace e2d::touch_system_impl
+{
+    //
+    // collider_tree
+    //
+    // Dynamic AABB tree of world space collider bounds in the XY plane.
+    // Leaves keep fattened bounds, so colliders that move a little
+    // don't touch the tree at all.
+    //
+
+    class collider_tree final : private noncopyable {
+    public:
+        static constexpr u32 null_proxy = ~u32(0);
+    public:
+        collider_tree() = default;
+        ~collider_tree() noexcept = default;
+
+        u32 create_proxy(const b2f& bounds, gobject owner);
+        void destroy_proxy(u32 proxy) noexcept;
+
+        // reinserts the proxy only when the bounds leave its fattened ones
+        bool move_proxy(u32 proxy, const b2f& bounds);
+
+        // proxies that are not touched with the current stamp belong
+        // to removed colliders and are destroyed by the sweep
+        void touch_proxy(u32 proxy, u32 stamp) noexcept;
+        std::size_t destroy_untouched_proxies(u32 stamp) noexcept;
+
+        std::size_t proxy_count() const noexcept;
+
+        template < typename F >
+        void query(const b2f& bounds, F&& f) const;
+    private:
+        struct aabb final {
+            v2f min;
+            v2f max;
+        };
+
+        struct node final {
+            aabb bounds;
+            gobject owner;
+            u32 parent{null_proxy};
+            u32 child1{null_proxy};
+            u32 child2{null_proxy};
+            u32 stamp{0u};
+            i32 height{-1};
+        };
+    private:
+        static aabb make_aabb_(const b2f& bounds) noexcept;
+        static aabb fattened_(const aabb& bounds, f32 margin) noexcept;
+        static aabb merged_(const aabb& l, const aabb& r) noexcept;
+        static bool contains_(const aabb& outer, const aabb& inner) noexcept;
+        static bool overlaps_(const aabb& l, const aabb& r) noexcept;
+        static f32 perimeter_(const aabb& bounds) noexcept;
+
+        bool is_leaf_(u32 index) const noexcept;
+        u32 allocate_node_();
+        void free_node_(u32 index) noexcept;
+        void insert_leaf_(u32 leaf);
+        void remove_leaf_(u32 leaf) noexcept;
+        void refit_from_(u32 index) noexcept;
+        u32 balance_(u32 index) noexcept;
+    private:
+        vector<node> nodes_;
+        u32 root_{null_proxy};
+        u32 free_list_{null_proxy};
+        std::size_t proxy_count_{0u};
+    };
+}
+
+namespace e2d::touch_system_impl
+{
+    template < typename F >
+    void collider_tree::query(const b2f& bounds, F&& f) const {
+        if ( root_ == null_proxy ) {
+            return;
+        }
+
+        static thread_local vector<u32> stack;
+        DEFER_HPP([](){ stack.clear(); });
+
+        const aabb query_bounds = make_aabb_(bounds);
+        stack.push_back(root_);
+
+        while ( !stack.empty() ) {
+            const u32 index = stack.back();
+            stack.pop_back();
+
+            const node& n = nodes_[index];
+            if ( !overlaps_(n.bounds, query_bounds) ) {
+                continue;
+            }
+
+            if ( is_leaf_(index) ) {
+                f(n.owner);
+            } else {
+                stack.push_back(n.child1);
+                stack.push_back(n.child2);
+            }
+        }
+    }
+}
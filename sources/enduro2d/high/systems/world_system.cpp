@@ -8,6 +8,25 @@
 
 #include <enduro2d/high/world.hpp>
 
+#include <enduro2d/high/components/actor.hpp>
+
+namespace
+{
+    using namespace e2d;
+
+    void update_world_matrices(ecs::registry& owner) {
+        owner.for_each_component<actor>([](
+            const ecs::const_entity&,
+            const actor& a)
+        {
+            const const_node_iptr n = a.node();
+            if ( n && !n->has_parent() ) {
+                n->update_world_matrix_recursive();
+            }
+        });
+    }
+}
+
 namespace e2d
 {
     //
@@ -20,6 +39,15 @@ namespace e2d
         : world_(w) {}
         ~internal_state() noexcept = default;
 
+        void process_pre_update(ecs::registry& owner) {
+            E2D_UNUSED(owner);
+            world_.process_async_instances();
+        }
+
+        void process_post_update(ecs::registry& owner) {
+            update_world_matrices(owner);
+        }
+
         void process_frame_finalize(ecs::registry& owner) {
             E2D_UNUSED(owner);
             world_.finalize_instances();
@@ -36,6 +64,22 @@ namespace e2d
     : state_(new internal_state(the<world>())) {}
     world_system::~world_system() noexcept = default;
 
+    void world_system::process(
+        ecs::registry& owner,
+        const ecs::after<systems::pre_update_event>& trigger)
+    {
+        E2D_UNUSED(trigger);
+        state_->process_pre_update(owner);
+    }
+
+    void world_system::process(
+        ecs::registry& owner,
+        const ecs::after<systems::post_update_event>& trigger)
+    {
+        E2D_UNUSED(trigger);
+        state_->process_post_update(owner);
+    }
+
     void world_system::process(
         ecs::registry& owner,
         const ecs::after<systems::frame_finalize_event>& trigger)
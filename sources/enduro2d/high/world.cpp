@@ -13,7 +13,9 @@ namespace
 {
     using namespace e2d;
 
-    class gobject_state final : public gobject::state {
+    class gobject_state final
+        : public gobject::state
+        , public pooled_object<gobject_state> {
     private:
         enum flag_masks : u32 {
             fm_destroyed = 1u << 0,
@@ -84,28 +86,37 @@ namespace
         }
     }
 
-    gobject new_instance(world& world, const prefab& root_prefab) {
-        ecs::entity ent = world.registry().create_entity(root_prefab.prototype());
+    gobject new_entity_instance(world& world, const ecs::prototype& prototype) {
+        ecs::entity ent = world.registry().create_entity(prototype);
         auto ent_defer = defer_hpp::make_error_defer([&ent](){
             ent.destroy();
         });
 
-        gobject root_i(make_intrusive<gobject_state>(world, ent));
-        ERROR_DEFER_HPP([&root_i](){
-            delete_instance(root_i);
+        gobject inst(make_intrusive<gobject_state>(world, ent));
+        ERROR_DEFER_HPP([&inst](){
+            delete_instance(inst);
         });
 
         ent_defer.dismiss();
 
         {
-            gcomponent<actor> root_a{root_i};
-            node_iptr new_root_node = node::create(root_i);
-            if ( root_a && root_a->node() ) {
-                new_root_node->transform(root_a->node()->transform());
+            gcomponent<actor> inst_a{inst};
+            node_iptr new_node = node::create(inst);
+            if ( inst_a && inst_a->node() ) {
+                new_node->transform(inst_a->node()->transform());
             }
-            root_a.ensure().node(new_root_node);
+            inst_a.ensure().node(new_node);
         }
 
+        return inst;
+    }
+
+    gobject new_instance(world& world, const prefab& root_prefab) {
+        gobject root_i = new_entity_instance(world, root_prefab.prototype());
+        ERROR_DEFER_HPP([&root_i](){
+            delete_instance(root_i);
+        });
+
         for ( const prefab& child_prefab : root_prefab.children() ) {
             gobject child_i = new_instance(world, child_prefab);
             ERROR_DEFER_HPP([&child_i](){
@@ -118,11 +129,205 @@ namespace
 
         return root_i;
     }
+
+    void attach_instance(
+        const gobject& inst,
+        const t2f* transform,
+        const node_iptr& parent) noexcept
+    {
+        if ( const node_iptr& node = inst.component<actor>()->node() ) {
+            if ( transform ) {
+                node->transform(*transform);
+            }
+
+            if ( parent ) {
+                parent->add_child(node);
+            }
+        }
+    }
+
+    // gobject states and nodes of all requested instances are allocated
+    // from their pools as one chunk instead of growing them chunk by chunk
+
+    void reserve_instances(const flat_prefab& prefab, std::size_t count) {
+        const std::size_t entity_count = count * math::max(prefab.size(), std::size_t(1u));
+        gobject_state::reserve_pool(entity_count);
+        node::reserve_pool(entity_count);
+    }
+
+    //
+    // flat_instance_builder
+    //
+    // Creates one instance of a flattened prefab entity by entity. Every new
+    // entity is linked to its parent right away, so destroying the root
+    // rolls back an unfinished instance.
+    //
+
+    class flat_instance_builder final : private noncopyable {
+    public:
+        flat_instance_builder(world& w, const flat_prefab& prefab)
+        : world_(w)
+        , prefab_(prefab) {
+            instances_.reserve(math::max(prefab_.size(), std::size_t(1u)));
+        }
+
+        ~flat_instance_builder() noexcept {
+            if ( !instances_.empty() ) {
+                delete_instance(instances_.front());
+            }
+        }
+
+        bool done() const noexcept {
+            return instances_.size() == math::max(prefab_.size(), std::size_t(1u));
+        }
+
+        void step() {
+            E2D_ASSERT(!done());
+
+            if ( prefab_.empty() ) {
+                instances_.push_back(new_entity_instance(world_, ecs::prototype()));
+                return;
+            }
+
+            const std::size_t index = instances_.size();
+            gobject inst = new_entity_instance(world_, prefab_.prototype(index));
+
+            if ( const std::size_t parent = prefab_.parent(index); parent != flat_prefab::no_parent ) {
+                E2D_ASSERT(parent < index);
+                gcomponent<actor> parent_a{instances_[parent]};
+                gcomponent<actor> inst_a{inst};
+                parent_a->node()->add_child(inst_a->node());
+            }
+
+            instances_.push_back(std::move(inst));
+        }
+
+        gobject release() noexcept {
+            E2D_ASSERT(done());
+            gobject root = instances_.front();
+            instances_.clear();
+            return root;
+        }
+    private:
+        world& world_;
+        const flat_prefab& prefab_;
+        vector<gobject> instances_;
+    };
+
+    vector<gobject> new_instances(
+        world& world,
+        const flat_prefab& prefab,
+        std::size_t count,
+        const t2f* transforms,
+        const node_iptr& parent)
+    {
+        vector<gobject> insts;
+        insts.reserve(count);
+        reserve_instances(prefab, count);
+
+        ERROR_DEFER_HPP([&insts](){
+            for ( const gobject& inst : insts ) {
+                delete_instance(inst);
+            }
+        });
+
+        for ( std::size_t i = 0; i < count; ++i ) {
+            flat_instance_builder builder(world, prefab);
+            while ( !builder.done() ) {
+                builder.step();
+            }
+            insts.push_back(builder.release());
+            attach_instance(insts.back(), transforms ? &transforms[i] : nullptr, parent);
+        }
+
+        return insts;
+    }
 }
 
 namespace e2d
 {
-    world::~world() noexcept = default;
+    //
+    // world::async_batch
+    //
+
+    class world::async_batch final : private noncopyable {
+    public:
+        async_batch(
+            flat_prefab prefab,
+            std::size_t count,
+            vector<t2f> transforms,
+            node_iptr parent)
+        : prefab_(std::move(prefab))
+        , count_(count)
+        , transforms_(std::move(transforms))
+        , parent_(std::move(parent)) {
+            E2D_ASSERT(transforms_.empty() || transforms_.size() == count_);
+            instances_.reserve(count_);
+            reserve_instances(prefab_, count_);
+        }
+
+        ~async_batch() noexcept {
+            builder_.reset();
+            for ( const gobject& inst : instances_ ) {
+                delete_instance(inst);
+            }
+        }
+
+        const stdex::promise<vector<gobject>>& promise() const noexcept {
+            return promise_;
+        }
+
+        // returns true when all instances are created
+        bool step(world& w) {
+            if ( instances_.size() == count_ ) {
+                return true;
+            }
+
+            if ( !builder_ ) {
+                builder_.emplace(w, prefab_);
+            }
+
+            builder_->step();
+
+            if ( builder_->done() ) {
+                const std::size_t index = instances_.size();
+                instances_.push_back(builder_->release());
+                builder_.reset();
+                attach_instance(
+                    instances_.back(),
+                    transforms_.empty() ? nullptr : &transforms_[index],
+                    parent_);
+            }
+
+            return instances_.size() == count_;
+        }
+
+        void resolve() {
+            vector<gobject> instances;
+            instances.swap(instances_);
+            promise_.resolve(std::move(instances));
+        }
+
+        void reject(std::exception_ptr e) noexcept {
+            promise_.reject(e);
+        }
+    private:
+        flat_prefab prefab_;
+        std::size_t count_{0u};
+        vector<t2f> transforms_;
+        node_iptr parent_;
+        vector<gobject> instances_;
+        std::optional<flat_instance_builder> builder_;
+        stdex::promise<vector<gobject>> promise_;
+    };
+
+    //
+    // world
+    //
+
+    world::~world() noexcept {
+        cancel_async_instances();
+    }
 
     ecs::registry& world::registry() noexcept {
         return registry_;
@@ -188,6 +393,94 @@ namespace e2d
         return inst;
     }
 
+    vector<gobject> world::instantiate_batch(const flat_prefab& prefab, std::size_t count) {
+        return new_instances(*this, prefab, count, nullptr, nullptr);
+    }
+
+    vector<gobject> world::instantiate_batch(const flat_prefab& prefab, const vector<t2f>& transforms) {
+        return new_instances(*this, prefab, transforms.size(), transforms.data(), nullptr);
+    }
+
+    vector<gobject> world::instantiate_batch(const flat_prefab& prefab, std::size_t count, const node_iptr& parent) {
+        return new_instances(*this, prefab, count, nullptr, parent);
+    }
+
+    vector<gobject> world::instantiate_batch(const flat_prefab& prefab, const vector<t2f>& transforms, const node_iptr& parent) {
+        return new_instances(*this, prefab, transforms.size(), transforms.data(), parent);
+    }
+
+    stdex::promise<vector<gobject>> world::instantiate_batch_async(flat_prefab prefab, std::size_t count) {
+        return instantiate_batch_async(std::move(prefab), count, nullptr);
+    }
+
+    stdex::promise<vector<gobject>> world::instantiate_batch_async(flat_prefab prefab, vector<t2f> transforms) {
+        return instantiate_batch_async(std::move(prefab), std::move(transforms), nullptr);
+    }
+
+    stdex::promise<vector<gobject>> world::instantiate_batch_async(flat_prefab prefab, std::size_t count, node_iptr parent) {
+        async_batches_.push_back(std::make_unique<async_batch>(
+            std::move(prefab), count, vector<t2f>(), std::move(parent)));
+        return async_batches_.back()->promise();
+    }
+
+    stdex::promise<vector<gobject>> world::instantiate_batch_async(flat_prefab prefab, vector<t2f> transforms, node_iptr parent) {
+        const std::size_t count = transforms.size();
+        async_batches_.push_back(std::make_unique<async_batch>(
+            std::move(prefab), count, std::move(transforms), std::move(parent)));
+        return async_batches_.back()->promise();
+    }
+
+    world& world::async_instances_budget(microseconds<u64> budget) noexcept {
+        async_instances_budget_ = budget;
+        return *this;
+    }
+
+    microseconds<u64> world::async_instances_budget() const noexcept {
+        return async_instances_budget_;
+    }
+
+    void world::process_async_instances() {
+        const microseconds<u64> start_time = time::now_us<u64>();
+
+        // at least one entity is created per call, so every batch
+        // makes progress even with a zero budget
+        while ( !async_batches_.empty() ) {
+            async_batch_uptr& batch = async_batches_.front();
+
+            try {
+                if ( batch->step(*this) ) {
+                    async_batch_uptr done = std::move(batch);
+                    async_batches_.erase(async_batches_.begin());
+                    done->resolve();
+                }
+            } catch (...) {
+                async_batch_uptr failed = std::move(batch);
+                async_batches_.erase(async_batches_.begin());
+                failed->reject(std::current_exception());
+            }
+
+            if ( time::now_us<u64>() - start_time >= async_instances_budget_ ) {
+                break;
+            }
+        }
+    }
+
+    void world::cancel_async_instances() noexcept {
+        vector<async_batch_uptr> batches;
+        batches.swap(async_batches_);
+        for ( const async_batch_uptr& batch : batches ) {
+            batch->reject(std::make_exception_ptr(world_cancelled_exception()));
+        }
+    }
+
+    object_pool::statistics world::state_pool_statistics() noexcept {
+        return gobject_state::pool_statistics();
+    }
+
+    object_pool::statistics world::node_pool_statistics() noexcept {
+        return node::pool_statistics();
+    }
+
     void world::destroy_instance(gobject inst) noexcept {
         auto gstate = inst
             ? dynamic_pointer_cast<gobject_state>(inst.internal_state())
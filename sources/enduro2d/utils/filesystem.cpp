@@ -16,6 +16,10 @@ namespace e2d
     write_file_uptr make_write_file(str_view path, bool append) noexcept {
         return impl::make_write_file(path, append);
     }
+
+    mapped_file_uptr make_mapped_file(str_view path) noexcept {
+        return impl::make_mapped_file(path);
+    }
 }
 
 namespace e2d::filesystem
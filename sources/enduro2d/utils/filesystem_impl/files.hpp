@@ -14,4 +14,5 @@ namespace e2d::impl
 {
     read_file_uptr make_read_file(str_view path) noexcept;
     write_file_uptr make_write_file(str_view path, bool append) noexcept;
+    mapped_file_uptr make_mapped_file(str_view path) noexcept;
 }
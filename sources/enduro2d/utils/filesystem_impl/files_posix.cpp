@@ -10,6 +10,8 @@
 
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 namespace
 {
@@ -140,6 +142,11 @@ namespace
         }
 
         void flush() const final {
+            // writes go straight to the system, there is nothing to flush
+            E2D_ASSERT(is_opened_());
+        }
+
+        void sync() const final {
             E2D_ASSERT(is_opened_());
             if ( 0 != ::fsync(handle_) ) {
                 throw bad_stream_operation();
@@ -181,6 +188,66 @@ namespace
         str path_;
         int handle_ = -1;
     };
+
+    class mapped_file_posix final : public mapped_file {
+    public:
+        mapped_file_posix(str path)
+        : path_(std::move(path))
+        {
+            if ( !open_() ) {
+                throw bad_stream_operation();
+            }
+        }
+
+        ~mapped_file_posix() noexcept final {
+            close_();
+        }
+    public:
+        buffer_view content() const noexcept final {
+            return data_
+                ? buffer_view(data_, length_)
+                : buffer_view();
+        }
+
+        const str& path() const noexcept final {
+            return path_;
+        }
+    private:
+        bool open_() noexcept {
+            // the mapping stays valid after the descriptor is closed
+            const int handle = ::open(path_.c_str(), O_RDONLY);
+            if ( handle < 0 ) {
+                return false;
+            }
+            struct stat st{};
+            if ( 0 != ::fstat(handle, &st) || !S_ISREG(st.st_mode) ) {
+                ::close(handle);
+                return false;
+            }
+            length_ = math::numeric_cast<std::size_t>(st.st_size);
+            if ( length_ > 0u ) {
+                void* data = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, handle, 0);
+                if ( MAP_FAILED == data ) {
+                    ::close(handle);
+                    return false;
+                }
+                data_ = data;
+            }
+            ::close(handle);
+            return true;
+        }
+
+        void close_() noexcept {
+            if ( data_ ) {
+                ::munmap(data_, length_);
+                data_ = nullptr;
+            }
+        }
+    private:
+        str path_;
+        std::size_t length_ = 0;
+        void* data_ = nullptr;
+    };
 }
 
 namespace e2d::impl
@@ -200,6 +267,14 @@ namespace e2d::impl
             return nullptr;
         }
     }
+
+    mapped_file_uptr make_mapped_file(str_view path) noexcept {
+        try {
+            return std::make_unique<mapped_file_posix>(str(path));
+        } catch (...) {
+            return nullptr;
+        }
+    }
 }
 
 #endif
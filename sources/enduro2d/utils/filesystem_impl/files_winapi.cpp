@@ -169,6 +169,11 @@ namespace
         }
 
         void flush() const final {
+            // writes go straight to the system, there is nothing to flush
+            E2D_ASSERT(is_opened_());
+        }
+
+        void sync() const final {
             E2D_ASSERT(is_opened_());
             if ( FALSE == ::FlushFileBuffers(handle_) ) {
                 throw bad_stream_operation();
@@ -220,6 +225,80 @@ namespace
         str path_;
         HANDLE handle_ = INVALID_HANDLE_VALUE;
     };
+
+    class mapped_file_winapi final : public mapped_file {
+    public:
+        mapped_file_winapi(str path)
+        : path_(std::move(path))
+        {
+            if ( !open_() ) {
+                throw bad_stream_operation();
+            }
+        }
+
+        ~mapped_file_winapi() noexcept final {
+            close_();
+        }
+    public:
+        buffer_view content() const noexcept final {
+            return data_
+                ? buffer_view(data_, length_)
+                : buffer_view();
+        }
+
+        const str& path() const noexcept final {
+            return path_;
+        }
+    private:
+        bool open_() {
+            // the view stays valid after the file and mapping handles are closed
+            const wstr wide_path = make_wide(path_);
+            const HANDLE file = ::CreateFileW(
+                wide_path.c_str(),
+                GENERIC_READ,
+                FILE_SHARE_READ,
+                NULL,
+                OPEN_EXISTING,
+                FILE_ATTRIBUTE_READONLY,
+                NULL);
+            if ( INVALID_HANDLE_VALUE == file ) {
+                return false;
+            }
+            const DWORD file_size = ::GetFileSize(file, NULL);
+            if ( INVALID_FILE_SIZE == file_size ) {
+                ::CloseHandle(file);
+                return false;
+            }
+            length_ = math::numeric_cast<std::size_t>(file_size);
+            if ( length_ > 0u ) {
+                const HANDLE mapping = ::CreateFileMappingW(
+                    file, NULL, PAGE_READONLY, 0, 0, NULL);
+                if ( NULL == mapping ) {
+                    ::CloseHandle(file);
+                    return false;
+                }
+                data_ = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                ::CloseHandle(mapping);
+                if ( NULL == data_ ) {
+                    ::CloseHandle(file);
+                    return false;
+                }
+            }
+            ::CloseHandle(file);
+            return true;
+        }
+
+        void close_() noexcept {
+            if ( data_ ) {
+                ::UnmapViewOfFile(data_);
+                data_ = nullptr;
+            }
+        }
+    private:
+        str path_;
+        std::size_t length_ = 0;
+        LPVOID data_ = nullptr;
+    };
 }
 
 namespace e2d::impl
@@ -239,6 +318,14 @@ namespace e2d::impl
             return nullptr;
         }
     }
+
+    mapped_file_uptr make_mapped_file(str_view path) noexcept {
+        try {
+            return std::make_unique<mapped_file_winapi>(str(path));
+        } catch (...) {
+            return nullptr;
+        }
+    }
 }
 
 #endif
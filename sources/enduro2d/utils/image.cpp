@@ -14,38 +14,40 @@ namespace
         u32 uncompressed_bytes_per_pixel;
         image_data_format format;
         bool compressed;
+        u32 bytes_per_block;
+        v2u block_size;
     };
 
     const data_format_description data_format_descriptions[] = {
-        {1, image_data_format::a8,             false},
-        {1, image_data_format::l8,             false},
-        {2, image_data_format::la8,            false},
-        {3, image_data_format::rgb8,           false},
-        {4, image_data_format::rgba8,          false},
-
-        {0, image_data_format::rgba_dxt1,      true},
-        {0, image_data_format::rgba_dxt3,      true},
-        {0, image_data_format::rgba_dxt5,      true},
-
-        {0, image_data_format::rgb_etc1,       true},
-        {0, image_data_format::rgb_etc2,       true},
-        {0, image_data_format::rgba_etc2,      true},
-        {0, image_data_format::rgb_a1_etc2,    true},
-
-        {0, image_data_format::rgba_astc4x4,   true},
-        {0, image_data_format::rgba_astc5x5,   true},
-        {0, image_data_format::rgba_astc6x6,   true},
-        {0, image_data_format::rgba_astc8x8,   true},
-        {0, image_data_format::rgba_astc10x10, true},
-        {0, image_data_format::rgba_astc12x12, true},
-
-        {0, image_data_format::rgb_pvrtc2,     true},
-        {0, image_data_format::rgb_pvrtc4,     true},
-        {0, image_data_format::rgba_pvrtc2,    true},
-        {0, image_data_format::rgba_pvrtc4,    true},
-
-        {0, image_data_format::rgba_pvrtc2_v2, true},
-        {0, image_data_format::rgba_pvrtc4_v2, true}
+        {1, image_data_format::a8,             false, 1,  v2u(1,1)},
+        {1, image_data_format::l8,             false, 1,  v2u(1,1)},
+        {2, image_data_format::la8,            false, 2,  v2u(1,1)},
+        {3, image_data_format::rgb8,           false, 3,  v2u(1,1)},
+        {4, image_data_format::rgba8,          false, 4,  v2u(1,1)},
+
+        {0, image_data_format::rgba_dxt1,      true,  8,  v2u(4,4)},
+        {0, image_data_format::rgba_dxt3,      true,  16, v2u(4,4)},
+        {0, image_data_format::rgba_dxt5,      true,  16, v2u(4,4)},
+
+        {0, image_data_format::rgb_etc1,       true,  8,  v2u(4,4)},
+        {0, image_data_format::rgb_etc2,       true,  8,  v2u(4,4)},
+        {0, image_data_format::rgba_etc2,      true,  16, v2u(4,4)},
+        {0, image_data_format::rgb_a1_etc2,    true,  8,  v2u(4,4)},
+
+        {0, image_data_format::rgba_astc4x4,   true,  16, v2u(4,4)},
+        {0, image_data_format::rgba_astc5x5,   true,  16, v2u(5,5)},
+        {0, image_data_format::rgba_astc6x6,   true,  16, v2u(6,6)},
+        {0, image_data_format::rgba_astc8x8,   true,  16, v2u(8,8)},
+        {0, image_data_format::rgba_astc10x10, true,  16, v2u(10,10)},
+        {0, image_data_format::rgba_astc12x12, true,  16, v2u(12,12)},
+
+        {0, image_data_format::rgb_pvrtc2,     true,  8,  v2u(8,4)},
+        {0, image_data_format::rgb_pvrtc4,     true,  8,  v2u(4,4)},
+        {0, image_data_format::rgba_pvrtc2,    true,  8,  v2u(8,4)},
+        {0, image_data_format::rgba_pvrtc4,    true,  8,  v2u(4,4)},
+
+        {0, image_data_format::rgba_pvrtc2_v2, true,  8,  v2u(8,4)},
+        {0, image_data_format::rgba_pvrtc4_v2, true,  8,  v2u(4,4)}
     };
 
     const data_format_description& get_data_format_description(image_data_format format) noexcept {
@@ -75,12 +77,12 @@ namespace e2d
         return assign(other);
     }
 
-    image::image(const v2u& size, image_data_format format, buffer&& data) noexcept {
-        assign(size, format, std::move(data));
+    image::image(const v2u& size, image_data_format format, buffer&& data, u32 mipmap_count) noexcept {
+        assign(size, format, std::move(data), mipmap_count);
     }
 
-    image::image(const v2u& size, image_data_format format, const buffer& data) {
-        assign(size, format, data);
+    image::image(const v2u& size, image_data_format format, const buffer& data, u32 mipmap_count) {
+        assign(size, format, data, mipmap_count);
     }
 
     image& image::assign(image&& other) noexcept {
@@ -96,21 +98,28 @@ namespace e2d
             data_.assign(other.data_);
             size_ = other.size_;
             format_ = other.format_;
+            mipmap_count_ = other.mipmap_count_;
         }
         return *this;
     }
 
-    image& image::assign(const v2u& size, image_data_format format, buffer&& data) noexcept {
+    image& image::assign(const v2u& size, image_data_format format, buffer&& data, u32 mipmap_count) noexcept {
+        E2D_ASSERT(mipmap_count > 0u && mipmap_count <= images::max_mipmap_count(size));
+        E2D_ASSERT(mipmap_count == 1u || data.size() == images::data_size_for_mipmaps(format, size, mipmap_count));
         data_.assign(std::move(data));
         size_ = size;
         format_ = format;
+        mipmap_count_ = mipmap_count;
         return *this;
     }
 
-    image& image::assign(const v2u& size, image_data_format format, const buffer& data) {
+    image& image::assign(const v2u& size, image_data_format format, const buffer& data, u32 mipmap_count) {
+        E2D_ASSERT(mipmap_count > 0u && mipmap_count <= images::max_mipmap_count(size));
+        E2D_ASSERT(mipmap_count == 1u || data.size() == images::data_size_for_mipmaps(format, size, mipmap_count));
         data_.assign(data);
         size_ = size;
         format_ = format;
+        mipmap_count_ = mipmap_count;
         return *this;
     }
 
@@ -119,12 +128,14 @@ namespace e2d
         swap(data_, other.data_);
         swap(size_, other.size_);
         swap(format_, other.format_);
+        swap(mipmap_count_, other.mipmap_count_);
     }
 
     void image::clear() noexcept {
         data_.clear();
         size_ = v2u::zero();
         format_ = image_data_format::rgba8;
+        mipmap_count_ = 0u;
     }
 
     bool image::empty() const noexcept {
@@ -183,6 +194,26 @@ namespace e2d
     const buffer& image::data() const noexcept {
         return data_;
     }
+
+    u32 image::mipmap_count() const noexcept {
+        return mipmap_count_;
+    }
+
+    v2u image::mipmap_size(u32 level) const noexcept {
+        E2D_ASSERT(level < mipmap_count_);
+        return images::mipmap_size(size_, level);
+    }
+
+    buffer_view image::mipmap_data(u32 level) const noexcept {
+        E2D_ASSERT(level < mipmap_count_);
+        if ( mipmap_count_ == 1u ) {
+            return data_;
+        }
+        const std::size_t offset = images::data_size_for_mipmaps(format_, size_, level);
+        const std::size_t size = images::data_size_for_dimension(format_, mipmap_size(level));
+        E2D_ASSERT(offset + size <= data_.size());
+        return buffer_view(data_.data() + offset, size);
+    }
 }
 
 namespace e2d
@@ -194,6 +225,7 @@ namespace e2d
     bool operator==(const image& l, const image& r) noexcept {
         return l.format() == r.format()
             && l.size() == r.size()
+            && l.mipmap_count() == r.mipmap_count()
             && l.data() == r.data();
     }
 
@@ -282,4 +314,79 @@ namespace e2d::images
                 return false;
         }
     }
+    bool is_compressed_format(
+        image_data_format format) noexcept
+    {
+        return get_data_format_description(format).compressed;
+    }
+
+    std::size_t data_size_for_dimension(
+        image_data_format format,
+        const v2u& size) noexcept
+    {
+        const data_format_description& format_desc =
+            get_data_format_description(format);
+        const v2u& bs = format_desc.block_size;
+        return format_desc.bytes_per_block
+            * ((size.x + bs.x - 1u) / bs.x)
+            * ((size.y + bs.y - 1u) / bs.y);
+    }
+
+    std::size_t data_size_for_mipmaps(
+        image_data_format format,
+        const v2u& size,
+        u32 mipmap_count) noexcept
+    {
+        std::size_t result = 0u;
+        for ( u32 level = 0; level < mipmap_count; ++level ) {
+            result += data_size_for_dimension(format, mipmap_size(size, level));
+        }
+        return result;
+    }
+
+    u32 max_mipmap_count(const v2u& size) noexcept {
+        u32 result = 1u;
+        for ( u32 max_size = math::maximum(size); max_size > 1u; max_size >>= 1u ) {
+            ++result;
+        }
+        return result;
+    }
+
+    v2u mipmap_size(const v2u& size, u32 level) noexcept {
+        return level < 32u
+            ? v2u(math::max(size.x >> level, 1u), math::max(size.y >> level, 1u))
+            : v2u(1u, 1u);
+    }
+
+    bool try_generate_mipmaps(
+        image& dst,
+        const image& src,
+        image_mipmap_filter filter) noexcept
+    {
+        try {
+            return impl::generate_mipmaps(dst, src, filter);
+        } catch (...) {
+            return false;
+        }
+    }
+
+    bool try_compress(
+        image& dst,
+        const image& src,
+        image_data_format format,
+        image_compression_quality quality) noexcept
+    {
+        try {
+            return impl::compress_image(dst, src, format, quality);
+        } catch (...) {
+            return false;
+        }
+    }
+
+    bool check_compress_support(
+        const image& src,
+        image_data_format format) noexcept
+    {
+        return impl::check_compress_image(src, format);
+    }
 }
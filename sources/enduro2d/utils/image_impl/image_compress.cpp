@@ -0,0 +1,938 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "image_impl.hpp"
+
+namespace
+{
+    using namespace e2d;
+
+    //
+    // block
+    //
+    // 4x4 rgba texels, row by row. Texels outside of the image
+    // repeat the edge ones, so partial blocks don't pull the
+    // endpoints towards black.
+    //
+
+    struct block final {
+        u8 texels[16][4];
+    };
+
+    void fetch_block(
+        block& dst,
+        const u8* src, const v2u& size, image_data_format format,
+        u32 block_x, u32 block_y) noexcept
+    {
+        for ( u32 y = 0; y < 4u; ++y ) {
+            for ( u32 x = 0; x < 4u; ++x ) {
+                const u32 sx = math::min(block_x * 4u + x, size.x - 1u);
+                const u32 sy = math::min(block_y * 4u + y, size.y - 1u);
+                const std::size_t i = std::size_t(sy) * size.x + sx;
+                u8* t = dst.texels[y * 4u + x];
+                switch ( format ) {
+                    case image_data_format::a8:
+                        t[0] = t[1] = t[2] = 0u;
+                        t[3] = src[i];
+                        break;
+                    case image_data_format::l8:
+                        t[0] = t[1] = t[2] = src[i];
+                        t[3] = 255u;
+                        break;
+                    case image_data_format::la8:
+                        t[0] = t[1] = t[2] = src[i * 2u + 0u];
+                        t[3] = src[i * 2u + 1u];
+                        break;
+                    case image_data_format::rgb8:
+                        t[0] = src[i * 3u + 0u];
+                        t[1] = src[i * 3u + 1u];
+                        t[2] = src[i * 3u + 2u];
+                        t[3] = 255u;
+                        break;
+                    case image_data_format::rgba8:
+                        t[0] = src[i * 4u + 0u];
+                        t[1] = src[i * 4u + 1u];
+                        t[2] = src[i * 4u + 2u];
+                        t[3] = src[i * 4u + 3u];
+                        break;
+                    default:
+                        E2D_ASSERT_MSG(false, "unexpected image data format");
+                        break;
+                }
+            }
+        }
+    }
+
+    i32 square(i32 v) noexcept {
+        return v * v;
+    }
+
+    u32 color_error(const u8* l, const u8* r) noexcept {
+        return static_cast<u32>(
+            square(i32(l[0]) - i32(r[0])) +
+            square(i32(l[1]) - i32(r[1])) +
+            square(i32(l[2]) - i32(r[2])));
+    }
+
+    void write_u16_le(u8* dst, u16 v) noexcept {
+        dst[0] = static_cast<u8>(v & 0xFFu);
+        dst[1] = static_cast<u8>(v >> 8u);
+    }
+
+    //
+    // bc1 color
+    //
+    // Endpoints lie on the principal axis of the block colors
+    // and are refined by least squares over the chosen indices.
+    // The fast quality takes the inset bounding box instead.
+    //
+
+    u16 pack_565(const f32 c[3]) noexcept {
+        // extrapolated endpoints may leave the color range,
+        // and negative floats can't be converted to unsigned
+        const u32 r = u32(math::clamp(c[0], 0.f, 255.f) * 31.f / 255.f + 0.5f);
+        const u32 g = u32(math::clamp(c[1], 0.f, 255.f) * 63.f / 255.f + 0.5f);
+        const u32 b = u32(math::clamp(c[2], 0.f, 255.f) * 31.f / 255.f + 0.5f);
+        return static_cast<u16>((r << 11u) | (g << 5u) | b);
+    }
+
+    void unpack_565(u16 c, u8 dst[3]) noexcept {
+        const u32 r = (c >> 11u) & 31u;
+        const u32 g = (c >> 5u) & 63u;
+        const u32 b = c & 31u;
+        dst[0] = static_cast<u8>((r << 3u) | (r >> 2u));
+        dst[1] = static_cast<u8>((g << 2u) | (g >> 4u));
+        dst[2] = static_cast<u8>((b << 3u) | (b >> 2u));
+    }
+
+    struct bc1_result final {
+        u16 color0 = 0u;
+        u16 color1 = 0u;
+        u32 indices = 0u;
+        u32 error = std::numeric_limits<u32>::max();
+    };
+
+    void build_bc1_palette(u16 c0, u16 c1, bool three_colors, u8 palette[4][3]) noexcept {
+        unpack_565(c0, palette[0]);
+        unpack_565(c1, palette[1]);
+        for ( std::size_t i = 0; i < 3; ++i ) {
+            const u32 a = palette[0][i];
+            const u32 b = palette[1][i];
+            if ( three_colors ) {
+                palette[2][i] = static_cast<u8>((a + b) / 2u);
+                palette[3][i] = 0u;
+            } else {
+                palette[2][i] = static_cast<u8>((2u * a + b) / 3u);
+                palette[3][i] = static_cast<u8>((a + 2u * b) / 3u);
+            }
+        }
+    }
+
+    // transparent texels get the fourth entry of the three color palette
+    bc1_result fit_bc1_indices(
+        const block& b, u16 c0, u16 c1,
+        bool three_colors, const bool transparent[16]) noexcept
+    {
+        u8 palette[4][3];
+        build_bc1_palette(c0, c1, three_colors, palette);
+
+        bc1_result result;
+        result.color0 = c0;
+        result.color1 = c1;
+        result.error = 0u;
+
+        const u32 entries = three_colors ? 3u : 4u;
+        for ( u32 i = 0; i < 16u; ++i ) {
+            u32 index = 3u;
+            if ( !transparent || !transparent[i] ) {
+                u32 best = std::numeric_limits<u32>::max();
+                for ( u32 e = 0; e < entries; ++e ) {
+                    const u32 err = color_error(b.texels[i], palette[e]);
+                    if ( err < best ) {
+                        best = err;
+                        index = e;
+                    }
+                }
+                result.error += best;
+            }
+            result.indices |= index << (i * 2u);
+        }
+
+        return result;
+    }
+
+    void principal_endpoints(
+        const block& b, const bool transparent[16],
+        f32 max_color[3], f32 min_color[3]) noexcept
+    {
+        f32 mean[3] = {0.f, 0.f, 0.f};
+        u32 count = 0u;
+        for ( u32 i = 0; i < 16u; ++i ) {
+            if ( transparent && transparent[i] ) {
+                continue;
+            }
+            for ( std::size_t c = 0; c < 3; ++c ) {
+                mean[c] += b.texels[i][c];
+            }
+            ++count;
+        }
+        if ( !count ) {
+            for ( std::size_t c = 0; c < 3; ++c ) {
+                max_color[c] = min_color[c] = 0.f;
+            }
+            return;
+        }
+        for ( f32& m : mean ) {
+            m /= static_cast<f32>(count);
+        }
+
+        f32 cov[6] = {0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+        for ( u32 i = 0; i < 16u; ++i ) {
+            if ( transparent && transparent[i] ) {
+                continue;
+            }
+            const f32 r = b.texels[i][0] - mean[0];
+            const f32 g = b.texels[i][1] - mean[1];
+            const f32 bl = b.texels[i][2] - mean[2];
+            cov[0] += r * r; cov[1] += r * g; cov[2] += r * bl;
+            cov[3] += g * g; cov[4] += g * bl; cov[5] += bl * bl;
+        }
+
+        // power iteration, the block colors usually have one dominant axis
+        f32 axis[3] = {1.f, 1.f, 1.f};
+        for ( u32 iter = 0; iter < 8u; ++iter ) {
+            const f32 x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+            const f32 y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+            const f32 z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+            const f32 len = math::max(math::abs(x), math::max(math::abs(y), math::abs(z)));
+            if ( len < 1e-6f ) {
+                break;
+            }
+            axis[0] = x / len;
+            axis[1] = y / len;
+            axis[2] = z / len;
+        }
+
+        f32 tmin = std::numeric_limits<f32>::max();
+        f32 tmax = std::numeric_limits<f32>::lowest();
+        const f32 axis_len2 = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+        for ( u32 i = 0; i < 16u; ++i ) {
+            if ( transparent && transparent[i] ) {
+                continue;
+            }
+            const f32 t =
+                (b.texels[i][0] - mean[0]) * axis[0] +
+                (b.texels[i][1] - mean[1]) * axis[1] +
+                (b.texels[i][2] - mean[2]) * axis[2];
+            tmin = math::min(tmin, t);
+            tmax = math::max(tmax, t);
+        }
+
+        for ( std::size_t c = 0; c < 3; ++c ) {
+            max_color[c] = mean[c] + axis[c] * tmax / axis_len2;
+            min_color[c] = mean[c] + axis[c] * tmin / axis_len2;
+        }
+    }
+
+    void inset_bbox_endpoints(
+        const block& b, const bool transparent[16],
+        f32 max_color[3], f32 min_color[3]) noexcept
+    {
+        for ( std::size_t c = 0; c < 3; ++c ) {
+            max_color[c] = 0.f;
+            min_color[c] = 255.f;
+        }
+        for ( u32 i = 0; i < 16u; ++i ) {
+            if ( transparent && transparent[i] ) {
+                continue;
+            }
+            for ( std::size_t c = 0; c < 3; ++c ) {
+                max_color[c] = math::max(max_color[c], f32(b.texels[i][c]));
+                min_color[c] = math::min(min_color[c], f32(b.texels[i][c]));
+            }
+        }
+        for ( std::size_t c = 0; c < 3; ++c ) {
+            const f32 inset = math::max(max_color[c] - min_color[c], 0.f) / 16.f;
+            max_color[c] -= inset;
+            min_color[c] += inset;
+        }
+    }
+
+    // solves for the endpoints that reproduce the texels best
+    // with the current indices of the four color palette
+    bool refine_bc1_endpoints(
+        const block& b, u32 indices,
+        f32 max_color[3], f32 min_color[3]) noexcept
+    {
+        const f32 weights[4] = {1.f, 0.f, 2.f / 3.f, 1.f / 3.f};
+        f32 aa = 0.f, bb = 0.f, ab = 0.f;
+        f32 ap[3] = {0.f, 0.f, 0.f};
+        f32 bp[3] = {0.f, 0.f, 0.f};
+        for ( u32 i = 0; i < 16u; ++i ) {
+            const f32 a = weights[(indices >> (i * 2u)) & 3u];
+            const f32 w = 1.f - a;
+            aa += a * a;
+            bb += w * w;
+            ab += a * w;
+            for ( std::size_t c = 0; c < 3; ++c ) {
+                ap[c] += a * b.texels[i][c];
+                bp[c] += w * b.texels[i][c];
+            }
+        }
+        const f32 det = aa * bb - ab * ab;
+        if ( math::abs(det) < 1e-6f ) {
+            return false;
+        }
+        for ( std::size_t c = 0; c < 3; ++c ) {
+            max_color[c] = math::clamp((ap[c] * bb - bp[c] * ab) / det, 0.f, 255.f);
+            min_color[c] = math::clamp((bp[c] * aa - ap[c] * ab) / det, 0.f, 255.f);
+        }
+        return true;
+    }
+
+    bc1_result fit_bc1_four_colors(const block& b, const f32 max_color[3], const f32 min_color[3]) noexcept {
+        u16 c0 = pack_565(max_color);
+        u16 c1 = pack_565(min_color);
+        // equal endpoints switch decoders to the three color mode,
+        // but all the texels take the first entry anyway
+        if ( c0 < c1 ) {
+            std::swap(c0, c1);
+        }
+        return fit_bc1_indices(b, c0, c1, false, nullptr);
+    }
+
+    void encode_bc1_color(
+        u8* dst, const block& b,
+        image_compression_quality quality,
+        bool allow_transparency) noexcept
+    {
+        bool transparent[16] = {};
+        bool has_transparent = false;
+        if ( allow_transparency ) {
+            for ( u32 i = 0; i < 16u; ++i ) {
+                transparent[i] = b.texels[i][3] < 128u;
+                has_transparent = has_transparent || transparent[i];
+            }
+        }
+
+        f32 max_color[3];
+        f32 min_color[3];
+        bc1_result result;
+
+        if ( has_transparent ) {
+            principal_endpoints(b, transparent, max_color, min_color);
+            u16 c0 = pack_565(min_color);
+            u16 c1 = pack_565(max_color);
+            if ( c0 > c1 ) {
+                std::swap(c0, c1);
+            }
+            result = fit_bc1_indices(b, c0, c1, true, transparent);
+        } else if ( quality == image_compression_quality::fast ) {
+            inset_bbox_endpoints(b, nullptr, max_color, min_color);
+            result = fit_bc1_four_colors(b, max_color, min_color);
+        } else {
+            principal_endpoints(b, nullptr, max_color, min_color);
+            result = fit_bc1_four_colors(b, max_color, min_color);
+
+            const u32 iterations = quality == image_compression_quality::best ? 4u : 1u;
+            for ( u32 iter = 0; iter < iterations && result.error > 0u; ++iter ) {
+                if ( !refine_bc1_endpoints(b, result.indices, max_color, min_color) ) {
+                    break;
+                }
+                const bc1_result refined = fit_bc1_four_colors(b, max_color, min_color);
+                if ( refined.error >= result.error ) {
+                    break;
+                }
+                result = refined;
+            }
+        }
+
+        write_u16_le(dst + 0, result.color0);
+        write_u16_le(dst + 2, result.color1);
+        dst[4] = static_cast<u8>(result.indices & 0xFFu);
+        dst[5] = static_cast<u8>((result.indices >> 8u) & 0xFFu);
+        dst[6] = static_cast<u8>((result.indices >> 16u) & 0xFFu);
+        dst[7] = static_cast<u8>((result.indices >> 24u) & 0xFFu);
+    }
+
+    //
+    // bc2/bc3 alpha
+    //
+
+    void encode_bc2_alpha(u8* dst, const block& b) noexcept {
+        for ( u32 i = 0; i < 8u; ++i ) {
+            const u32 a0 = (u32(b.texels[i * 2u + 0u][3]) * 15u + 127u) / 255u;
+            const u32 a1 = (u32(b.texels[i * 2u + 1u][3]) * 15u + 127u) / 255u;
+            dst[i] = static_cast<u8>(a0 | (a1 << 4u));
+        }
+    }
+
+    u32 fit_bc3_alpha_indices(
+        const block& b, const u8 palette[8], u64& indices) noexcept
+    {
+        u32 error = 0u;
+        indices = 0u;
+        for ( u32 i = 0; i < 16u; ++i ) {
+            u32 best = std::numeric_limits<u32>::max();
+            u32 index = 0u;
+            for ( u32 e = 0; e < 8u; ++e ) {
+                const u32 err = static_cast<u32>(square(i32(b.texels[i][3]) - i32(palette[e])));
+                if ( err < best ) {
+                    best = err;
+                    index = e;
+                }
+            }
+            error += best;
+            indices |= u64(index) << (i * 3u);
+        }
+        return error;
+    }
+
+    void encode_bc3_alpha(u8* dst, const block& b, image_compression_quality quality) noexcept {
+        u32 amin = 255u;
+        u32 amax = 0u;
+        u32 inner_min = 255u;
+        u32 inner_max = 0u;
+        for ( u32 i = 0; i < 16u; ++i ) {
+            const u32 a = b.texels[i][3];
+            amin = math::min(amin, a);
+            amax = math::max(amax, a);
+            if ( a != 0u && a != 255u ) {
+                inner_min = math::min(inner_min, a);
+                inner_max = math::max(inner_max, a);
+            }
+        }
+
+        // eight interpolated values between the extremes
+        u8 palette[8];
+        palette[0] = static_cast<u8>(amax);
+        palette[1] = static_cast<u8>(amin);
+        for ( u32 k = 2; k < 8u; ++k ) {
+            palette[k] = static_cast<u8>(((8u - k) * amax + (k - 1u) * amin) / 7u);
+        }
+
+        u64 indices = 0u;
+        u32 error = fit_bc3_alpha_indices(b, palette, indices);
+        u8 a0 = palette[0];
+        u8 a1 = palette[1];
+
+        // six interpolated values plus exact 0 and 255,
+        // good for blocks with fully opaque and transparent texels
+        if ( quality == image_compression_quality::best && error > 0u && inner_min <= inner_max ) {
+            u8 palette6[8];
+            palette6[0] = static_cast<u8>(inner_min);
+            palette6[1] = static_cast<u8>(inner_max);
+            for ( u32 k = 2; k < 6u; ++k ) {
+                palette6[k] = static_cast<u8>(((6u - k) * inner_min + (k - 1u) * inner_max) / 5u);
+            }
+            palette6[6] = 0u;
+            palette6[7] = 255u;
+
+            u64 indices6 = 0u;
+            const u32 error6 = fit_bc3_alpha_indices(b, palette6, indices6);
+            if ( error6 < error ) {
+                error = error6;
+                indices = indices6;
+                a0 = palette6[0];
+                a1 = palette6[1];
+            }
+        }
+
+        dst[0] = a0;
+        dst[1] = a1;
+        for ( u32 i = 0; i < 6u; ++i ) {
+            dst[2u + i] = static_cast<u8>((indices >> (i * 8u)) & 0xFFu);
+        }
+    }
+
+    //
+    // etc1
+    //
+    // Tries both sub block orientations and both base color modes,
+    // the best quality also searches the neighbours of the average
+    // base colors. The blocks are valid ETC2 blocks as well, they
+    // never use the T, H and planar modes.
+    //
+
+    const i32 etc1_modifier_table[8][2] = {
+        {2, 8}, {5, 17}, {9, 29}, {13, 42},
+        {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+
+    // texel indices of the sub blocks for both flip bits
+    const u32 etc1_sub_blocks[2][2][8] = {
+        // side by side
+        {{0, 1, 4, 5, 8, 9, 12, 13},
+         {2, 3, 6, 7, 10, 11, 14, 15}},
+        // one above the other
+        {{0, 1, 2, 3, 4, 5, 6, 7},
+         {8, 9, 10, 11, 12, 13, 14, 15}}};
+
+    // ETC blocks store texel bits column by column
+    u32 texel_index_column_major(u32 row_major_index) noexcept {
+        return (row_major_index % 4u) * 4u + row_major_index / 4u;
+    }
+
+    struct etc1_sub_fit final {
+        u32 error = std::numeric_limits<u32>::max();
+        u32 table = 0u;
+        u32 modifiers[8] = {};
+    };
+
+    etc1_sub_fit fit_etc1_sub_block(
+        const block& b, const u32 texels[8], const u8 base[3]) noexcept
+    {
+        etc1_sub_fit best;
+        for ( u32 t = 0; t < 8u; ++t ) {
+            const i32 m[4] = {
+                etc1_modifier_table[t][0], etc1_modifier_table[t][1],
+                -etc1_modifier_table[t][0], -etc1_modifier_table[t][1]};
+
+            u8 candidates[4][3];
+            for ( u32 k = 0; k < 4u; ++k ) {
+                for ( std::size_t c = 0; c < 3; ++c ) {
+                    candidates[k][c] = static_cast<u8>(math::clamp(i32(base[c]) + m[k], 0, 255));
+                }
+            }
+
+            etc1_sub_fit fit;
+            fit.error = 0u;
+            fit.table = t;
+            for ( u32 i = 0; i < 8u && fit.error < best.error; ++i ) {
+                u32 texel_best = std::numeric_limits<u32>::max();
+                for ( u32 k = 0; k < 4u; ++k ) {
+                    const u32 err = color_error(b.texels[texels[i]], candidates[k]);
+                    if ( err < texel_best ) {
+                        texel_best = err;
+                        fit.modifiers[i] = k;
+                    }
+                }
+                fit.error += texel_best;
+            }
+
+            if ( fit.error < best.error ) {
+                best = fit;
+            }
+        }
+        return best;
+    }
+
+    u8 expand_4(u32 c) noexcept {
+        return static_cast<u8>((c << 4u) | c);
+    }
+
+    u8 expand_5(u32 c) noexcept {
+        return static_cast<u8>((c << 3u) | (c >> 2u));
+    }
+
+    struct etc1_candidate final {
+        u32 color[3];
+        etc1_sub_fit fit;
+    };
+
+    struct etc1_candidates final {
+        std::array<etc1_candidate, 27> items;
+        std::size_t count = 0u;
+
+        const etc1_candidate* begin() const noexcept { return items.data(); }
+        const etc1_candidate* end() const noexcept { return items.data() + count; }
+    };
+
+    void collect_etc1_candidates(
+        etc1_candidates& dst,
+        const block& b, const u32 texels[8],
+        u32 bits, i32 radius) noexcept
+    {
+        E2D_ASSERT(radius >= 0 && radius <= 1);
+        f32 mean[3] = {0.f, 0.f, 0.f};
+        for ( u32 i = 0; i < 8u; ++i ) {
+            for ( std::size_t c = 0; c < 3; ++c ) {
+                mean[c] += b.texels[texels[i]][c];
+            }
+        }
+
+        const i32 max_value = (1 << bits) - 1;
+        i32 center[3];
+        for ( std::size_t c = 0; c < 3; ++c ) {
+            center[c] = i32(mean[c] / 8.f * f32(max_value) / 255.f + 0.5f);
+        }
+
+        dst.count = 0u;
+        for ( i32 dr = -radius; dr <= radius; ++dr ) {
+            for ( i32 dg = -radius; dg <= radius; ++dg ) {
+                for ( i32 db = -radius; db <= radius; ++db ) {
+                    const i32 q[3] = {center[0] + dr, center[1] + dg, center[2] + db};
+                    if ( q[0] < 0 || q[1] < 0 || q[2] < 0
+                        || q[0] > max_value || q[1] > max_value || q[2] > max_value )
+                    {
+                        continue;
+                    }
+                    etc1_candidate& candidate = dst.items[dst.count++];
+                    u8 base[3];
+                    for ( std::size_t c = 0; c < 3; ++c ) {
+                        candidate.color[c] = static_cast<u32>(q[c]);
+                        base[c] = bits == 4u ? expand_4(candidate.color[c]) : expand_5(candidate.color[c]);
+                    }
+                    candidate.fit = fit_etc1_sub_block(b, texels, base);
+                }
+            }
+        }
+    }
+
+    void encode_etc1(u8* dst, const block& b, image_compression_quality quality) noexcept {
+        etc1_candidates candidates[2];
+
+        const i32 radius = quality == image_compression_quality::best ? 1 : 0;
+        const u32 flips = quality == image_compression_quality::fast ? 1u : 2u;
+
+        u32 best_error = std::numeric_limits<u32>::max();
+        u8 best_block[8] = {};
+
+        for ( u32 flip = 0; flip < flips; ++flip ) {
+            const u32 (&subs)[2][8] = etc1_sub_blocks[flip];
+
+            // individual mode, 4 bits per channel for both sub blocks
+
+            const etc1_candidate* individual[2] = {};
+            for ( u32 s = 0; s < 2u; ++s ) {
+                collect_etc1_candidates(candidates[s], b, subs[s], 4u, radius);
+                for ( const etc1_candidate& c : candidates[s] ) {
+                    if ( !individual[s] || c.fit.error < individual[s]->fit.error ) {
+                        individual[s] = &c;
+                    }
+                }
+            }
+
+            const auto pack_block = [flip, &subs](
+                u8* out, bool differential,
+                const etc1_candidate& c0, const etc1_candidate& c1) noexcept
+            {
+                for ( std::size_t c = 0; c < 3; ++c ) {
+                    out[c] = differential
+                        ? static_cast<u8>((c0.color[c] << 3u) | ((c1.color[c] - c0.color[c]) & 7u))
+                        : static_cast<u8>((c0.color[c] << 4u) | c1.color[c]);
+                }
+                out[3] = static_cast<u8>(
+                    (c0.fit.table << 5u) | (c1.fit.table << 2u) |
+                    ((differential ? 1u : 0u) << 1u) | flip);
+
+                u32 msb = 0u;
+                u32 lsb = 0u;
+                for ( u32 s = 0; s < 2u; ++s ) {
+                    const etc1_sub_fit& fit = s == 0 ? c0.fit : c1.fit;
+                    for ( u32 i = 0; i < 8u; ++i ) {
+                        const u32 j = texel_index_column_major(subs[s][i]);
+                        msb |= ((fit.modifiers[i] >> 1u) & 1u) << j;
+                        lsb |= (fit.modifiers[i] & 1u) << j;
+                    }
+                }
+                out[4] = static_cast<u8>(msb >> 8u);
+                out[5] = static_cast<u8>(msb & 0xFFu);
+                out[6] = static_cast<u8>(lsb >> 8u);
+                out[7] = static_cast<u8>(lsb & 0xFFu);
+            };
+
+            if ( individual[0] && individual[1] ) {
+                const u32 error = individual[0]->fit.error + individual[1]->fit.error;
+                if ( error < best_error ) {
+                    best_error = error;
+                    pack_block(best_block, false, *individual[0], *individual[1]);
+                }
+            }
+
+            // differential mode, 5 bits for the first base color
+            // and a 3 bit signed delta for the second one
+
+            for ( u32 s = 0; s < 2u; ++s ) {
+                collect_etc1_candidates(candidates[s], b, subs[s], 5u, radius);
+            }
+            for ( const etc1_candidate& c0 : candidates[0] ) {
+                if ( c0.fit.error >= best_error ) {
+                    continue;
+                }
+                for ( const etc1_candidate& c1 : candidates[1] ) {
+                    bool valid = true;
+                    for ( std::size_t c = 0; c < 3; ++c ) {
+                        const i32 delta = i32(c1.color[c]) - i32(c0.color[c]);
+                        valid = valid && delta >= -4 && delta <= 3;
+                    }
+                    const u32 error = c0.fit.error + c1.fit.error;
+                    if ( valid && error < best_error ) {
+                        best_error = error;
+                        pack_block(best_block, true, c0, c1);
+                    }
+                }
+            }
+        }
+
+        std::memcpy(dst, best_block, sizeof(best_block));
+    }
+
+    //
+    // eac alpha
+    //
+
+    const i32 eac_modifier_table[16][8] = {
+        {-3, -6, -9, -15, 2, 5, 8, 14},
+        {-3, -7, -10, -13, 2, 6, 9, 12},
+        {-2, -5, -8, -13, 1, 4, 7, 12},
+        {-2, -4, -6, -13, 1, 3, 5, 12},
+        {-3, -6, -8, -12, 2, 5, 7, 11},
+        {-3, -7, -9, -11, 2, 6, 8, 10},
+        {-4, -7, -8, -11, 3, 6, 7, 10},
+        {-3, -5, -8, -11, 2, 4, 7, 10},
+        {-2, -6, -8, -10, 1, 5, 7, 9},
+        {-2, -5, -8, -10, 1, 4, 7, 9},
+        {-2, -4, -8, -10, 1, 3, 7, 9},
+        {-2, -5, -7, -10, 1, 4, 6, 9},
+        {-3, -4, -7, -10, 2, 3, 6, 9},
+        {-1, -2, -3, -10, 0, 1, 2, 9},
+        {-4, -6, -8, -9, 3, 5, 7, 8},
+        {-3, -5, -7, -9, 2, 4, 6, 8}};
+
+    u32 fit_eac_indices(
+        const block& b, i32 base, i32 multiplier, u32 table,
+        u64& indices, u32 error_limit) noexcept
+    {
+        u32 error = 0u;
+        indices = 0u;
+        for ( u32 i = 0; i < 16u && error < error_limit; ++i ) {
+            const i32 a = b.texels[i][3];
+            u32 best = std::numeric_limits<u32>::max();
+            u32 index = 0u;
+            for ( u32 e = 0; e < 8u; ++e ) {
+                const i32 v = math::clamp(base + eac_modifier_table[table][e] * multiplier, 0, 255);
+                const u32 err = static_cast<u32>(square(a - v));
+                if ( err < best ) {
+                    best = err;
+                    index = e;
+                }
+            }
+            error += best;
+            indices |= u64(index) << (45u - texel_index_column_major(i) * 3u);
+        }
+        return error;
+    }
+
+    void encode_eac_alpha(u8* dst, const block& b, image_compression_quality quality) noexcept {
+        i32 amin = 255;
+        i32 amax = 0;
+        for ( u32 i = 0; i < 16u; ++i ) {
+            amin = math::min(amin, i32(b.texels[i][3]));
+            amax = math::max(amax, i32(b.texels[i][3]));
+        }
+
+        const i32 search = quality == image_compression_quality::best ? 2
+            : quality == image_compression_quality::normal ? 1
+            : 0;
+
+        u32 best_error = std::numeric_limits<u32>::max();
+        i32 best_base = amin;
+        i32 best_multiplier = 1;
+        u32 best_table = 0u;
+        u64 best_indices = 0u;
+
+        for ( u32 t = 0; t < 16u && best_error > 0u; ++t ) {
+            const i32 mmin = eac_modifier_table[t][3];
+            const i32 mmax = eac_modifier_table[t][7];
+            const i32 multiplier = math::clamp(
+                (amax - amin + (mmax - mmin) / 2) / (mmax - mmin), 1, 15);
+            const i32 base = math::clamp(
+                (amin + amax) / 2 - (mmin + mmax) * multiplier / 2, 0, 255);
+
+            for ( i32 dm = -search; dm <= search; ++dm ) {
+                const i32 m = multiplier + dm;
+                if ( m < 1 || m > 15 ) {
+                    continue;
+                }
+                for ( i32 db = -search; db <= search; ++db ) {
+                    const i32 bs = base + db;
+                    if ( bs < 0 || bs > 255 ) {
+                        continue;
+                    }
+                    u64 indices = 0u;
+                    const u32 error = fit_eac_indices(b, bs, m, t, indices, best_error);
+                    if ( error < best_error ) {
+                        best_error = error;
+                        best_base = bs;
+                        best_multiplier = m;
+                        best_table = t;
+                        best_indices = indices;
+                    }
+                }
+            }
+        }
+
+        dst[0] = static_cast<u8>(best_base);
+        dst[1] = static_cast<u8>((u32(best_multiplier) << 4u) | best_table);
+        for ( u32 i = 0; i < 6u; ++i ) {
+            dst[2u + i] = static_cast<u8>((best_indices >> (40u - i * 8u)) & 0xFFu);
+        }
+    }
+
+    //
+    // compress
+    //
+
+    void compress_block(
+        u8* dst, const block& b,
+        image_data_format format,
+        image_compression_quality quality) noexcept
+    {
+        switch ( format ) {
+            case image_data_format::rgba_dxt1:
+                encode_bc1_color(dst, b, quality, true);
+                break;
+            case image_data_format::rgba_dxt3:
+                encode_bc2_alpha(dst, b);
+                encode_bc1_color(dst + 8, b, quality, false);
+                break;
+            case image_data_format::rgba_dxt5:
+                encode_bc3_alpha(dst, b, quality);
+                encode_bc1_color(dst + 8, b, quality, false);
+                break;
+            case image_data_format::rgb_etc1:
+            case image_data_format::rgb_etc2:
+                encode_etc1(dst, b, quality);
+                break;
+            case image_data_format::rgba_etc2:
+                encode_eac_alpha(dst, b, quality);
+                encode_etc1(dst + 8, b, quality);
+                break;
+            default:
+                E2D_ASSERT_MSG(false, "unexpected image data format");
+                break;
+        }
+    }
+
+    void compress_block_rows(
+        u8* dst, const u8* src, const v2u& size,
+        image_data_format src_format,
+        image_data_format dst_format,
+        image_compression_quality quality,
+        u32 first_row, u32 last_row) noexcept
+    {
+        const u32 blocks_x = (size.x + 3u) / 4u;
+        const std::size_t block_size = images::data_size_for_dimension(dst_format, v2u(4u, 4u));
+        block b;
+        for ( u32 by = first_row; by < last_row; ++by ) {
+            for ( u32 bx = 0; bx < blocks_x; ++bx ) {
+                fetch_block(b, src, size, src_format, bx, by);
+                compress_block(
+                    dst + (std::size_t(by) * blocks_x + bx) * block_size,
+                    b, dst_format, quality);
+            }
+        }
+    }
+
+    // splits the block rows between threads when there are enough
+    // blocks to pay for starting them
+    void compress_level(
+        u8* dst, const u8* src, const v2u& size,
+        image_data_format src_format,
+        image_data_format dst_format,
+        image_compression_quality quality)
+    {
+        const u32 blocks_x = (size.x + 3u) / 4u;
+        const u32 blocks_y = (size.y + 3u) / 4u;
+        const u32 min_blocks_per_thread = 1024u;
+
+        const u32 thread_count = math::clamp(
+            math::min(std::thread::hardware_concurrency(), blocks_x * blocks_y / min_blocks_per_thread),
+            1u, 8u);
+
+        if ( thread_count == 1u ) {
+            compress_block_rows(dst, src, size, src_format, dst_format, quality, 0u, blocks_y);
+            return;
+        }
+
+        const u32 rows_per_thread = (blocks_y + thread_count - 1u) / thread_count;
+
+        vector<std::thread> threads;
+        threads.reserve(thread_count - 1u);
+        DEFER_HPP([&threads](){
+            for ( std::thread& t : threads ) {
+                t.join();
+            }
+        });
+
+        for ( u32 i = 1; i < thread_count; ++i ) {
+            const u32 first_row = math::min(i * rows_per_thread, blocks_y);
+            const u32 last_row = math::min(first_row + rows_per_thread, blocks_y);
+            threads.emplace_back([=](){
+                compress_block_rows(dst, src, size, src_format, dst_format, quality, first_row, last_row);
+            });
+        }
+
+        compress_block_rows(dst, src, size, src_format, dst_format, quality,
+            0u, math::min(rows_per_thread, blocks_y));
+    }
+}
+
+namespace e2d::images::impl
+{
+    bool check_compress_image(const image& src, image_data_format format) noexcept {
+        switch ( src.format() ) {
+            case image_data_format::a8:
+            case image_data_format::l8:
+            case image_data_format::la8:
+            case image_data_format::rgb8:
+            case image_data_format::rgba8:
+                break;
+            default:
+                return false;
+        }
+        switch ( format ) {
+            case image_data_format::rgba_dxt1:
+            case image_data_format::rgba_dxt3:
+            case image_data_format::rgba_dxt5:
+            case image_data_format::rgb_etc1:
+            case image_data_format::rgb_etc2:
+            case image_data_format::rgba_etc2:
+                return !src.empty();
+            default:
+                return false;
+        }
+    }
+
+    bool compress_image(
+        image& dst,
+        const image& src,
+        image_data_format format,
+        image_compression_quality quality)
+    {
+        if ( !check_compress_image(src, format) ) {
+            return false;
+        }
+
+        const v2u size = src.size();
+        const u32 mipmap_count = src.mipmap_count();
+
+        for ( u32 level = 0; level < mipmap_count; ++level ) {
+            const buffer_view level_data = src.mipmap_data(level);
+            if ( level_data.size() != data_size_for_dimension(src.format(), src.mipmap_size(level)) ) {
+                return false;
+            }
+        }
+
+        buffer data(data_size_for_mipmaps(format, size, mipmap_count));
+
+        std::size_t offset = 0u;
+        for ( u32 level = 0; level < mipmap_count; ++level ) {
+            const v2u level_size = src.mipmap_size(level);
+            compress_level(
+                data.data() + offset,
+                static_cast<const u8*>(src.mipmap_data(level).data()),
+                level_size,
+                src.format(),
+                format,
+                quality);
+            offset += data_size_for_dimension(format, level_size);
+        }
+
+        dst.assign(size, format, std::move(data), mipmap_count);
+        return true;
+    }
+}
@@ -27,6 +27,11 @@ namespace e2d::images::impl
     bool check_save_image_png(const image& src) noexcept;
     bool check_save_image_pvr(const image& src) noexcept;
     bool check_save_image_tga(const image& src) noexcept;
+
+    bool generate_mipmaps(image& dst, const image& src, image_mipmap_filter filter);
+
+    bool compress_image(image& dst, const image& src, image_data_format format, image_compression_quality quality);
+    bool check_compress_image(const image& src, image_data_format format) noexcept;
 }
 
 namespace e2d::images::impl
@@ -0,0 +1,219 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "image_impl.hpp"
+
+namespace
+{
+    using namespace e2d;
+
+    //
+    // box
+    //
+    // Loops over interleaved channels with the channel count known
+    // at compile time, so compilers turn them into vector code.
+    //
+
+    template < std::size_t Channels >
+    void downsample_box(
+        u8* dst, const v2u& dst_size,
+        const u8* src, const v2u& src_size) noexcept
+    {
+        const std::size_t src_stride = std::size_t(src_size.x) * Channels;
+        const std::size_t dst_stride = std::size_t(dst_size.x) * Channels;
+
+        // the last column of odd widths has no pair
+        const u32 paired_columns = math::min(dst_size.x, src_size.x / 2u);
+
+        for ( u32 y = 0; y < dst_size.y; ++y ) {
+            const u8* row0 = src + math::min(y * 2u, src_size.y - 1u) * src_stride;
+            const u8* row1 = src + math::min(y * 2u + 1u, src_size.y - 1u) * src_stride;
+            u8* out = dst + y * dst_stride;
+
+            for ( std::size_t x = 0; x < paired_columns; ++x ) {
+                const std::size_t s = x * 2u * Channels;
+                for ( std::size_t c = 0; c < Channels; ++c ) {
+                    const u32 sum =
+                        u32(row0[s + c]) + u32(row0[s + Channels + c]) +
+                        u32(row1[s + c]) + u32(row1[s + Channels + c]);
+                    out[x * Channels + c] = static_cast<u8>((sum + 2u) >> 2u);
+                }
+            }
+
+            for ( std::size_t x = paired_columns; x < dst_size.x; ++x ) {
+                const std::size_t s = math::min(x * 2u, std::size_t(src_size.x - 1u)) * Channels;
+                for ( std::size_t c = 0; c < Channels; ++c ) {
+                    const u32 sum = u32(row0[s + c]) + u32(row1[s + c]);
+                    out[x * Channels + c] = static_cast<u8>((sum + 1u) >> 1u);
+                }
+            }
+        }
+    }
+
+    //
+    // kaiser
+    //
+    // Kaiser windowed sinc, separable. Halving takes six source texels
+    // per target texel, three target texels wide.
+    //
+
+    const f32 kaiser_alpha = 4.f;
+    const f32 kaiser_half_width = 1.5f;
+    constexpr std::size_t kaiser_taps = 6u;
+
+    f32 bessel_i0(f32 x) noexcept {
+        f32 sum = 1.f;
+        f32 term = 1.f;
+        const f32 half_x = x * 0.5f;
+        for ( u32 k = 1; k < 32u && term > sum * 1e-7f; ++k ) {
+            const f32 f = half_x / static_cast<f32>(k);
+            term *= f * f;
+            sum += term;
+        }
+        return sum;
+    }
+
+    f32 sinc(f32 x) noexcept {
+        if ( math::approximately(x, 0.f) ) {
+            return 1.f;
+        }
+        const f32 px = math::pi<f32>().value * x;
+        return std::sin(px) / px;
+    }
+
+    std::array<f32, kaiser_taps> make_kaiser_weights() noexcept {
+        std::array<f32, kaiser_taps> weights{};
+        f32 total = 0.f;
+        for ( std::size_t i = 0; i < kaiser_taps; ++i ) {
+            // tap offsets in target texels: -1.25, -0.75, ... 1.25
+            const f32 t = (static_cast<f32>(i) - 2.5f) * 0.5f;
+            const f32 r = t / kaiser_half_width;
+            const f32 window = bessel_i0(kaiser_alpha * std::sqrt(math::max(1.f - r * r, 0.f)))
+                / bessel_i0(kaiser_alpha);
+            weights[i] = sinc(t) * window;
+            total += weights[i];
+        }
+        for ( f32& w : weights ) {
+            w /= total;
+        }
+        return weights;
+    }
+
+    template < std::size_t Channels >
+    void downsample_kaiser(
+        u8* dst, const v2u& dst_size,
+        const u8* src, const v2u& src_size)
+    {
+        static const std::array<f32, kaiser_taps> weights = make_kaiser_weights();
+
+        const std::size_t src_stride = std::size_t(src_size.x) * Channels;
+        const std::size_t dst_stride = std::size_t(dst_size.x) * Channels;
+        vector<f32> horizontal(std::size_t(src_size.y) * dst_stride);
+
+        const auto clamp_index = [](i64 i, u32 size) noexcept {
+            return static_cast<std::size_t>(math::clamp(i, i64(0), i64(size) - 1));
+        };
+
+        for ( u32 y = 0; y < src_size.y; ++y ) {
+            const u8* row = src + y * src_stride;
+            f32* out = horizontal.data() + y * dst_stride;
+            for ( u32 x = 0; x < dst_size.x; ++x ) {
+                f32 sums[Channels] = {};
+                for ( std::size_t t = 0; t < kaiser_taps; ++t ) {
+                    const std::size_t s = clamp_index(i64(x) * 2 - 2 + i64(t), src_size.x) * Channels;
+                    for ( std::size_t c = 0; c < Channels; ++c ) {
+                        sums[c] += weights[t] * static_cast<f32>(row[s + c]);
+                    }
+                }
+                for ( std::size_t c = 0; c < Channels; ++c ) {
+                    out[x * Channels + c] = sums[c];
+                }
+            }
+        }
+
+        for ( u32 y = 0; y < dst_size.y; ++y ) {
+            const f32* rows[kaiser_taps];
+            for ( std::size_t t = 0; t < kaiser_taps; ++t ) {
+                rows[t] = horizontal.data()
+                    + clamp_index(i64(y) * 2 - 2 + i64(t), src_size.y) * dst_stride;
+            }
+            u8* out = dst + y * dst_stride;
+            for ( std::size_t i = 0; i < dst_stride; ++i ) {
+                f32 sum = 0.f;
+                for ( std::size_t t = 0; t < kaiser_taps; ++t ) {
+                    sum += weights[t] * rows[t][i];
+                }
+                out[i] = static_cast<u8>(math::clamp(sum + 0.5f, 0.f, 255.f));
+            }
+        }
+    }
+
+    template < std::size_t Channels >
+    void downsample(
+        image_mipmap_filter filter,
+        u8* dst, const v2u& dst_size,
+        const u8* src, const v2u& src_size)
+    {
+        switch ( filter ) {
+            case image_mipmap_filter::box:
+                downsample_box<Channels>(dst, dst_size, src, src_size);
+                break;
+            case image_mipmap_filter::kaiser:
+                downsample_kaiser<Channels>(dst, dst_size, src, src_size);
+                break;
+            default:
+                E2D_ASSERT_MSG(false, "unexpected image mipmap filter");
+                break;
+        }
+    }
+}
+
+namespace e2d::images::impl
+{
+    bool generate_mipmaps(image& dst, const image& src, image_mipmap_filter filter) {
+        if ( src.empty() || is_compressed_format(src.format()) ) {
+            return false;
+        }
+
+        const v2u size = src.size();
+        const image_data_format format = src.format();
+        const u32 mipmap_count = max_mipmap_count(size);
+        const std::size_t channels = data_size_for_dimension(format, v2u(1u, 1u));
+
+        const buffer_view top_level = src.mipmap_data(0);
+        if ( top_level.size() != data_size_for_dimension(format, size) ) {
+            return false;
+        }
+
+        buffer data(data_size_for_mipmaps(format, size, mipmap_count));
+        std::memcpy(data.data(), top_level.data(), top_level.size());
+
+        std::size_t src_offset = 0u;
+        for ( u32 level = 1; level < mipmap_count; ++level ) {
+            const v2u src_size = mipmap_size(size, level - 1u);
+            const v2u dst_size = mipmap_size(size, level);
+            const std::size_t dst_offset = src_offset + data_size_for_dimension(format, src_size);
+
+            const u8* src_level = data.data() + src_offset;
+            u8* dst_level = data.data() + dst_offset;
+
+            switch ( channels ) {
+                case 1: downsample<1>(filter, dst_level, dst_size, src_level, src_size); break;
+                case 2: downsample<2>(filter, dst_level, dst_size, src_level, src_size); break;
+                case 3: downsample<3>(filter, dst_level, dst_size, src_level, src_size); break;
+                case 4: downsample<4>(filter, dst_level, dst_size, src_level, src_size); break;
+                default:
+                    E2D_ASSERT_MSG(false, "unexpected image data format");
+                    return false;
+            }
+
+            src_offset = dst_offset;
+        }
+
+        dst.assign(size, format, std::move(data), mipmap_count);
+        return true;
+    }
+}
@@ -229,14 +229,20 @@ namespace e2d::images::impl
             return false;
         }
 
-        if ( hdr.mipmap_count > 1 ||
-             hdr.num_surfaces > 1 ||
+        if ( hdr.num_surfaces > 1 ||
              hdr.num_faces > 1 ||
              hdr.depth > 1 )
         {
             return false;
         }
 
+        const v2u dimension = v2u(hdr.width, hdr.height);
+        const u32 mipmap_count = math::max(hdr.mipmap_count, 1u);
+
+        if ( mipmap_count > max_mipmap_count(dimension) ) {
+            return false;
+        }
+
         image_info info = extract_image_info(hdr, {
             static_cast<const u8*>(src.data()) + sizeof(pvr_header) + hdr.meta_data_size,
             src.size() - sizeof(pvr_header) - hdr.meta_data_size});
@@ -245,16 +251,19 @@ namespace e2d::images::impl
             return false;
         }
 
-        const v2u dimension = v2u(hdr.width, hdr.height);
-        const std::size_t expected_image_data_size = info.bytes_per_block *
-            ((dimension.x + info.block_size.x - 1) / info.block_size.x) *
-            ((dimension.y + info.block_size.y - 1) / info.block_size.y);
+        std::size_t expected_image_data_size = 0u;
+        for ( u32 level = 0; level < mipmap_count; ++level ) {
+            const v2u level_dimension = mipmap_size(dimension, level);
+            expected_image_data_size += info.bytes_per_block *
+                ((level_dimension.x + info.block_size.x - 1) / info.block_size.x) *
+                ((level_dimension.y + info.block_size.y - 1) / info.block_size.y);
+        }
 
         if ( info.data.size() != expected_image_data_size ) {
             return false;
         }
 
-        dst = image(dimension, info.format, std::move(info.data));
+        dst = image(dimension, info.format, std::move(info.data), mipmap_count);
         return true;
     }
 }
@@ -49,12 +49,19 @@ namespace e2d::images::impl
 
         hdr.width = src.size().x;
         hdr.height = src.size().y;
-        hdr.pitch_or_linear_size = math::numeric_cast<u32>(src.data().size());
+        hdr.pitch_or_linear_size = math::numeric_cast<u32>(
+            data_size_for_dimension(src.format(), src.size()));
         hdr.depth = 0;
         hdr.mipmap_count = 0;
         hdr.caps = dds_caps_texture;
         hdr.caps2 = 0;
 
+        if ( src.mipmap_count() > 1u ) {
+            hdr.flags |= dds_hf_mipmap_count;
+            hdr.mipmap_count = src.mipmap_count();
+            hdr.caps |= dds_caps_complex | dds_caps_mipmap;
+        }
+
         hdr.pf.size = sizeof(dds_pixel_format);
         hdr.pf.flags = 0;
         hdr.pf.fourcc = 0;
@@ -108,7 +108,7 @@ namespace e2d::images::impl
         hdr.depth = 1;
         hdr.num_surfaces = 1;
         hdr.num_faces = 1;
-        hdr.mipmap_count = 1;
+        hdr.mipmap_count = math::max(src.mipmap_count(), 1u);
         hdr.meta_data_size = 0;
 
         buffer image_data(sizeof(pvr_header) + src.data().size());
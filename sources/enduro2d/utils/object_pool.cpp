@@ -0,0 +1,103 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/utils/object_pool.hpp>
+
+namespace
+{
+    using namespace e2d;
+
+    std::size_t align_up(std::size_t size, std::size_t align) noexcept {
+        return (size + align - 1u) / align * align;
+    }
+}
+
+namespace e2d
+{
+    object_pool::object_pool(
+        std::size_t block_size,
+        std::size_t block_align,
+        std::size_t chunk_block_count)
+    : block_size_(block_size)
+    , chunk_block_count_(math::max(chunk_block_count, std::size_t(1u)))
+    {
+        E2D_ASSERT(block_size > 0u);
+        E2D_ASSERT(math::is_power_of_2(block_align));
+        E2D_ASSERT(block_align <= alignof(std::max_align_t));
+        E2D_UNUSED(block_align);
+    }
+
+    object_pool::~object_pool() noexcept {
+        E2D_ASSERT_MSG(!stats_.live_count, "object_pool: blocks are still in use");
+    }
+
+    void* object_pool::allocate() {
+        std::lock_guard guard(mutex_);
+
+        if ( !free_blocks_ ) {
+            add_chunk_(chunk_block_count_);
+        }
+
+        free_block* block = free_blocks_;
+        free_blocks_ = block->next;
+        --free_count_;
+
+        ++stats_.live_count;
+        stats_.peak_count = math::max(stats_.peak_count, stats_.live_count);
+        return block;
+    }
+
+    void object_pool::deallocate(void* block) noexcept {
+        if ( !block ) {
+            return;
+        }
+
+        std::lock_guard guard(mutex_);
+        E2D_ASSERT(stats_.live_count > 0u);
+
+        free_block* fblock = new(block) free_block();
+        fblock->next = free_blocks_;
+        free_blocks_ = fblock;
+        ++free_count_;
+        --stats_.live_count;
+    }
+
+    void object_pool::reserve(std::size_t count) {
+        std::lock_guard guard(mutex_);
+        if ( free_count_ < count ) {
+            add_chunk_(math::max(count - free_count_, chunk_block_count_));
+        }
+    }
+
+    std::size_t object_pool::block_size() const noexcept {
+        return block_size_;
+    }
+
+    object_pool::statistics object_pool::stats() const noexcept {
+        std::lock_guard guard(mutex_);
+        return stats_;
+    }
+
+    void object_pool::add_chunk_(std::size_t block_count) {
+        // blocks keep the alignment of max_align_t because
+        // every block size is rounded up to it
+        const std::size_t stride = align_up(
+            math::max(block_size_, sizeof(free_block)),
+            alignof(std::max_align_t));
+
+        chunks_.reserve(chunks_.size() + 1u);
+        chunks_.push_back(std::make_unique<u8[]>(stride * block_count));
+        stats_.reserved_bytes += stride * block_count;
+
+        u8* chunk = chunks_.back().get();
+        for ( std::size_t i = block_count; i > 0u; --i ) {
+            free_block* block = new(chunk + stride * (i - 1u)) free_block();
+            block->next = free_blocks_;
+            free_blocks_ = block;
+        }
+        free_count_ += block_count;
+    }
+}
@@ -0,0 +1,553 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/utils/pack.hpp>
+#include <enduro2d/utils/strings.hpp>
+
+#include <3rdparty/miniz/miniz.h>
+
+namespace
+{
+    using namespace e2d;
+
+    const u32 pack_file_version = 2u;
+    const str_view pack_file_signature = "e2d_pack";
+
+    // signature, version, toc size, entry, bucket and chunk counts, names size
+    const std::size_t pack_header_size = 32u;
+
+    // path hash, name offset, name size, method, offset,
+    // stored size, size, first chunk, chunk count
+    const std::size_t pack_entry_size = 48u;
+
+    struct pack_header {
+        u32 toc_size{0u};
+        u32 entry_count{0u};
+        u32 bucket_count{0u};
+        u32 chunk_count{0u};
+        u32 names_size{0u};
+    };
+
+    std::size_t align_up(std::size_t size, std::size_t align) noexcept {
+        return (size + align - 1u) / align * align;
+    }
+
+    std::size_t next_power_of_2(std::size_t size) noexcept {
+        std::size_t result = 1u;
+        while ( result < size ) {
+            result <<= 1u;
+        }
+        return result;
+    }
+
+    class toc_reader final {
+    public:
+        toc_reader(buffer_view src) noexcept
+        : data_(static_cast<const u8*>(src.data()))
+        , size_(src.size()) {}
+
+        template < typename T >
+        bool read(T& v) noexcept {
+            if ( sizeof(T) > size_ - pos_ ) {
+                return false;
+            }
+            std::memcpy(&v, data_ + pos_, sizeof(T));
+            pos_ += sizeof(T);
+            return true;
+        }
+
+        bool read(buffer_view& v, std::size_t size) noexcept {
+            if ( size > size_ - pos_ ) {
+                return false;
+            }
+            v = size ? buffer_view(data_ + pos_, size) : buffer_view();
+            pos_ += size;
+            return true;
+        }
+    private:
+        const u8* data_ = nullptr;
+        std::size_t size_ = 0;
+        std::size_t pos_ = 0;
+    };
+
+    bool read_header(pack_header& dst, toc_reader& reader) noexcept {
+        buffer_view signature;
+        u32 version = 0u;
+        pack_header header;
+        const bool success = reader.read(signature, pack_file_signature.size())
+            && reader.read(version)
+            && reader.read(header.toc_size)
+            && reader.read(header.entry_count)
+            && reader.read(header.bucket_count)
+            && reader.read(header.chunk_count)
+            && reader.read(header.names_size);
+        if ( !success
+            || buffer_view(pack_file_signature.data(), pack_file_signature.size()) != signature
+            || version != pack_file_version
+            || header.toc_size < pack_header_size
+            || !math::is_power_of_2(header.bucket_count)
+            || header.bucket_count < header.entry_count )
+        {
+            return false;
+        }
+        dst = header;
+        return true;
+    }
+
+    bool read_toc(pack& dst, const pack_header& header, toc_reader& reader) {
+        vector<u32> buckets(header.bucket_count);
+        for ( u32& bucket : buckets ) {
+            if ( !reader.read(bucket) || bucket > header.entry_count ) {
+                return false;
+            }
+        }
+
+        struct entry_desc {
+            u32 name_offset{0u};
+            u32 name_size{0u};
+        };
+
+        vector<pack::entry> entries(header.entry_count);
+        vector<entry_desc> entry_descs(header.entry_count);
+        for ( std::size_t i = 0; i < entries.size(); ++i ) {
+            pack::entry& e = entries[i];
+            u32 method = 0u;
+            u64 offset = 0u;
+            u64 stored_size = 0u;
+            u64 size = 0u;
+            u32 first_chunk = 0u;
+            u32 chunk_count = 0u;
+            if ( !reader.read(e.path_hash)
+                || !reader.read(entry_descs[i].name_offset)
+                || !reader.read(entry_descs[i].name_size)
+                || !reader.read(method)
+                || !reader.read(offset)
+                || !reader.read(stored_size)
+                || !reader.read(size)
+                || !reader.read(first_chunk)
+                || !reader.read(chunk_count) )
+            {
+                return false;
+            }
+            if ( method > static_cast<u32>(pack::compression::deflate)
+                || offset % pack::alignment
+                || u64(first_chunk) + chunk_count > header.chunk_count )
+            {
+                return false;
+            }
+            e.method = static_cast<pack::compression>(method);
+            e.offset = math::numeric_cast<std::size_t>(offset);
+            e.stored_size = math::numeric_cast<std::size_t>(stored_size);
+            e.size = math::numeric_cast<std::size_t>(size);
+            e.first_chunk = first_chunk;
+            e.chunk_count = chunk_count;
+            const std::size_t expected_chunks = e.method == pack::compression::deflate
+                ? (e.size + pack::chunk_size - 1u) / pack::chunk_size
+                : 0u;
+            if ( e.chunk_count != expected_chunks ) {
+                return false;
+            }
+        }
+
+        vector<pack::chunk> chunks(header.chunk_count);
+        for ( pack::chunk& c : chunks ) {
+            u32 stored_size = 0u;
+            if ( !reader.read(stored_size) ) {
+                return false;
+            }
+            c.stored_size = stored_size;
+        }
+
+        buffer_view names;
+        if ( !reader.read(names, header.names_size) ) {
+            return false;
+        }
+
+        const char* names_data = static_cast<const char*>(names.data());
+        for ( std::size_t i = 0; i < entries.size(); ++i ) {
+            pack::entry& e = entries[i];
+            const entry_desc& desc = entry_descs[i];
+            if ( u64(desc.name_offset) + desc.name_size > names.size() ) {
+                return false;
+            }
+            e.path.assign(names_data + desc.name_offset, desc.name_size);
+            if ( i > 0u && !(entries[i - 1u].path < e.path) ) {
+                return false;
+            }
+
+            // chunks of an entry follow each other in the entry data
+            std::size_t chunk_offset = e.offset;
+            std::size_t chunks_size = 0u;
+            for ( std::size_t j = 0; j < e.chunk_count; ++j ) {
+                pack::chunk& c = chunks[e.first_chunk + j];
+                c.offset = chunk_offset;
+                chunk_offset += c.stored_size;
+                chunks_size += c.stored_size;
+            }
+            if ( e.chunk_count && chunks_size != e.stored_size ) {
+                return false;
+            }
+            if ( e.method == pack::compression::none && e.stored_size != e.size ) {
+                return false;
+            }
+        }
+
+        dst = pack(std::move(entries), std::move(chunks), std::move(buckets));
+        return true;
+    }
+
+    bool deflate_entry(
+        vector<buffer>& dst,
+        std::size_t& dst_size,
+        buffer_view src)
+    {
+        vector<buffer> chunks;
+        std::size_t chunks_size = 0u;
+        const u8* src_data = static_cast<const u8*>(src.data());
+        for ( std::size_t pos = 0; pos < src.size(); pos += pack::chunk_size ) {
+            const std::size_t size = math::min(pack::chunk_size, src.size() - pos);
+            mz_ulong chunk_size = mz_compressBound(math::numeric_cast<mz_ulong>(size));
+            buffer chunk(math::numeric_cast<std::size_t>(chunk_size));
+            if ( MZ_OK != mz_compress2(
+                chunk.data(),
+                &chunk_size,
+                src_data + pos,
+                math::numeric_cast<mz_ulong>(size),
+                MZ_BEST_SPEED) )
+            {
+                return false;
+            }
+            chunk.resize(math::numeric_cast<std::size_t>(chunk_size));
+            chunks_size += chunk.size();
+            chunks.push_back(std::move(chunk));
+        }
+        dst = std::move(chunks);
+        dst_size = chunks_size;
+        return true;
+    }
+}
+
+namespace e2d
+{
+    //
+    // pack
+    //
+
+    pack::pack(vector<entry> entries, vector<chunk> chunks, vector<u32> buckets) noexcept
+    : entries_(std::move(entries))
+    , chunks_(std::move(chunks))
+    , buckets_(std::move(buckets)) {
+        E2D_ASSERT(buckets_.empty() || math::is_power_of_2(buckets_.size()));
+    }
+
+    void pack::swap(pack& other) noexcept {
+        using std::swap;
+        swap(entries_, other.entries_);
+        swap(chunks_, other.chunks_);
+        swap(buckets_, other.buckets_);
+    }
+
+    void pack::clear() noexcept {
+        entries_.clear();
+        chunks_.clear();
+        buckets_.clear();
+    }
+
+    bool pack::empty() const noexcept {
+        return entries_.empty();
+    }
+
+    std::size_t pack::entry_count() const noexcept {
+        return entries_.size();
+    }
+
+    const pack::entry& pack::entry_at(std::size_t index) const noexcept {
+        E2D_ASSERT(index < entries_.size());
+        return entries_[index];
+    }
+
+    const pack::entry* pack::find_entry(str_view path) const noexcept {
+        if ( buckets_.empty() ) {
+            return nullptr;
+        }
+        const u32 path_hash = str_hash(path).hash();
+        const std::size_t mask = buckets_.size() - 1u;
+        for ( std::size_t i = 0; i < buckets_.size(); ++i ) {
+            const u32 slot = buckets_[(path_hash + i) & mask];
+            if ( !slot ) {
+                return nullptr;
+            }
+            const entry& e = entries_[slot - 1u];
+            if ( e.path_hash == path_hash && e.path == path ) {
+                return &e;
+            }
+        }
+        return nullptr;
+    }
+
+    std::pair<std::size_t, std::size_t> pack::find_prefix(str_view prefix) const noexcept {
+        const auto first = std::lower_bound(
+            entries_.begin(), entries_.end(), prefix,
+            [](const entry& l, str_view r) noexcept {
+                return str_view(l.path) < r;
+            });
+        auto last = first;
+        while ( last != entries_.end() && strings::starts_with(last->path, prefix) ) {
+            ++last;
+        }
+        return {
+            math::numeric_cast<std::size_t>(std::distance(entries_.begin(), first)),
+            math::numeric_cast<std::size_t>(std::distance(entries_.begin(), last))};
+    }
+
+    std::size_t pack::chunk_count() const noexcept {
+        return chunks_.size();
+    }
+
+    const pack::chunk& pack::chunk_at(std::size_t index) const noexcept {
+        E2D_ASSERT(index < chunks_.size());
+        return chunks_[index];
+    }
+
+    void swap(pack& l, pack& r) noexcept {
+        l.swap(r);
+    }
+
+    //
+    // pack_builder
+    //
+
+    pack_builder& pack_builder::add_file(
+        str path,
+        buffer content,
+        pack::compression method)
+    {
+        files_.push_back({std::move(path), std::move(content), method});
+        return *this;
+    }
+
+    void pack_builder::clear() noexcept {
+        files_.clear();
+    }
+
+    bool pack_builder::empty() const noexcept {
+        return files_.empty();
+    }
+
+    std::size_t pack_builder::file_count() const noexcept {
+        return files_.size();
+    }
+
+    bool pack_builder::try_save(const output_stream_uptr& dst) const noexcept {
+        if ( !dst ) {
+            return false;
+        }
+        try {
+            struct prepared_file {
+                const file* source{nullptr};
+                pack::compression method{pack::compression::none};
+                vector<buffer> chunks;
+                std::size_t stored_size{0u};
+                std::size_t offset{0u};
+            };
+
+            vector<prepared_file> prepared(files_.size());
+            for ( std::size_t i = 0; i < files_.size(); ++i ) {
+                prepared[i].source = &files_[i];
+            }
+
+            std::sort(prepared.begin(), prepared.end(),
+                [](const prepared_file& l, const prepared_file& r) noexcept {
+                    return l.source->path < r.source->path;
+                });
+
+            const auto duplicate = std::adjacent_find(prepared.begin(), prepared.end(),
+                [](const prepared_file& l, const prepared_file& r) noexcept {
+                    return l.source->path == r.source->path;
+                });
+            if ( duplicate != prepared.end() ) {
+                return false;
+            }
+
+            std::size_t chunk_count = 0u;
+            std::size_t names_size = 0u;
+            for ( prepared_file& f : prepared ) {
+                f.stored_size = f.source->content.size();
+                if ( f.source->method == pack::compression::deflate ) {
+                    vector<buffer> chunks;
+                    std::size_t chunks_size = 0u;
+                    if ( !deflate_entry(chunks, chunks_size, f.source->content) ) {
+                        return false;
+                    }
+                    if ( chunks_size < f.stored_size ) {
+                        f.method = pack::compression::deflate;
+                        f.chunks = std::move(chunks);
+                        f.stored_size = chunks_size;
+                    }
+                }
+                chunk_count += f.chunks.size();
+                names_size += f.source->path.size();
+            }
+
+            const std::size_t bucket_count = next_power_of_2(
+                math::max(prepared.size() * 2u, std::size_t(1u)));
+
+            const std::size_t toc_size = pack_header_size
+                + bucket_count * sizeof(u32)
+                + prepared.size() * pack_entry_size
+                + chunk_count * sizeof(u32)
+                + names_size;
+
+            std::size_t data_offset = align_up(toc_size, pack::alignment);
+            for ( prepared_file& f : prepared ) {
+                f.offset = data_offset;
+                data_offset = align_up(data_offset + f.stored_size, pack::alignment);
+            }
+
+            vector<u32> buckets(bucket_count, 0u);
+            for ( std::size_t i = 0; i < prepared.size(); ++i ) {
+                const u32 path_hash = str_hash(prepared[i].source->path).hash();
+                for ( std::size_t j = 0; ; ++j ) {
+                    u32& slot = buckets[(path_hash + j) & (bucket_count - 1u)];
+                    if ( !slot ) {
+                        slot = math::numeric_cast<u32>(i + 1u);
+                        break;
+                    }
+                }
+            }
+
+            output_sequence oseq{*dst};
+
+            oseq.write(pack_file_signature.data(), pack_file_signature.size())
+                .write(pack_file_version)
+                .write(math::numeric_cast<u32>(toc_size))
+                .write(math::numeric_cast<u32>(prepared.size()))
+                .write(math::numeric_cast<u32>(bucket_count))
+                .write(math::numeric_cast<u32>(chunk_count))
+                .write(math::numeric_cast<u32>(names_size));
+
+            for ( u32 slot : buckets ) {
+                oseq.write(slot);
+            }
+
+            std::size_t first_chunk = 0u;
+            std::size_t name_offset = 0u;
+            for ( const prepared_file& f : prepared ) {
+                oseq.write(str_hash(f.source->path).hash())
+                    .write(math::numeric_cast<u32>(name_offset))
+                    .write(math::numeric_cast<u32>(f.source->path.size()))
+                    .write(static_cast<u32>(f.method))
+                    .write(math::numeric_cast<u64>(f.offset))
+                    .write(math::numeric_cast<u64>(f.stored_size))
+                    .write(math::numeric_cast<u64>(f.source->content.size()))
+                    .write(math::numeric_cast<u32>(first_chunk))
+                    .write(math::numeric_cast<u32>(f.chunks.size()));
+                first_chunk += f.chunks.size();
+                name_offset += f.source->path.size();
+            }
+
+            for ( const prepared_file& f : prepared ) {
+                for ( const buffer& chunk : f.chunks ) {
+                    oseq.write(math::numeric_cast<u32>(chunk.size()));
+                }
+            }
+
+            for ( const prepared_file& f : prepared ) {
+                oseq.write_all(f.source->path);
+            }
+
+            static const u8 padding[pack::alignment] = {0};
+            std::size_t position = toc_size;
+            for ( const prepared_file& f : prepared ) {
+                oseq.write(padding, f.offset - position);
+                if ( f.method == pack::compression::deflate ) {
+                    for ( const buffer& chunk : f.chunks ) {
+                        oseq.write_all(chunk);
+                    }
+                } else {
+                    oseq.write_all(f.source->content);
+                }
+                position = f.offset + f.stored_size;
+            }
+
+            return oseq
+                .flush()
+                .success();
+        } catch (...) {
+            return false;
+        }
+    }
+}
+
+namespace e2d::packs
+{
+    bool try_load_pack(
+        pack& dst,
+        const input_stream_uptr& src) noexcept
+    {
+        if ( !src ) {
+            return false;
+        }
+        try {
+            buffer header_data(pack_header_size);
+            if ( !input_sequence(*src)
+                .seek(0, false)
+                .read(header_data.data(), header_data.size())
+                .success() )
+            {
+                return false;
+            }
+
+            pack_header header;
+            toc_reader header_reader{header_data};
+            if ( !read_header(header, header_reader) ) {
+                return false;
+            }
+
+            buffer toc_data(header.toc_size - pack_header_size);
+            if ( !input_sequence(*src)
+                .read(toc_data.data(), toc_data.size())
+                .success() )
+            {
+                return false;
+            }
+
+            toc_reader reader{toc_data};
+            return read_toc(dst, header, reader);
+        } catch (...) {
+            return false;
+        }
+    }
+
+    bool try_load_pack(
+        pack& dst,
+        buffer_view src) noexcept
+    {
+        try {
+            pack_header header;
+            toc_reader reader{src};
+            return read_header(header, reader)
+                && header.toc_size <= src.size()
+                && read_toc(dst, header, reader);
+        } catch (...) {
+            return false;
+        }
+    }
+
+    bool try_inflate_chunk(
+        void* dst,
+        std::size_t dst_size,
+        buffer_view src) noexcept
+    {
+        mz_ulong inflated_size = math::numeric_cast<mz_ulong>(dst_size);
+        return MZ_OK == mz_uncompress(
+                static_cast<unsigned char*>(dst),
+                &inflated_size,
+                static_cast<const unsigned char*>(src.data()),
+                math::numeric_cast<mz_ulong>(src.size()))
+            && inflated_size == dst_size;
+    }
+}
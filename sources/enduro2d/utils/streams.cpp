@@ -58,6 +58,67 @@ namespace
         buffer data_;
         std::size_t pos_ = 0;
     };
+
+    class buffered_stream final : public output_stream {
+    public:
+        buffered_stream(output_stream_uptr stream, std::size_t buffer_size)
+        : stream_(std::move(stream))
+        , buffer_(math::max(buffer_size, std::size_t(1u))) {}
+
+        ~buffered_stream() noexcept final {
+            try {
+                flush_buffer_();
+            } catch (...) {
+                // nothing
+            }
+        }
+
+        std::size_t write(const void* src, std::size_t size) final {
+            if ( size >= buffer_.size() ) {
+                flush_buffer_();
+                return stream_->write(src, size);
+            }
+            if ( size > buffer_.size() - used_ ) {
+                flush_buffer_();
+            }
+            std::memcpy(buffer_.data() + used_, src, size);
+            used_ += size;
+            return size;
+        }
+
+        std::size_t seek(std::ptrdiff_t offset, bool relative) final {
+            flush_buffer_();
+            return stream_->seek(offset, relative);
+        }
+
+        std::size_t tell() const final {
+            return stream_->tell() + used_;
+        }
+
+        void flush() const final {
+            flush_buffer_();
+            stream_->flush();
+        }
+
+        void sync() const final {
+            flush_buffer_();
+            stream_->sync();
+        }
+    private:
+        void flush_buffer_() const {
+            if ( used_ > 0u ) {
+                const std::size_t written = stream_->write(buffer_.data(), used_);
+                if ( written != used_ ) {
+                    throw bad_stream_operation();
+                }
+                used_ = 0u;
+            }
+        }
+    private:
+        output_stream_uptr stream_;
+        mutable buffer buffer_;
+        mutable std::size_t used_ = 0;
+    };
 }
 
 namespace e2d
@@ -197,6 +258,22 @@ namespace e2d
     output_sequence& output_sequence::flush_if(bool yesno) noexcept {
         return yesno ? flush() : *this;
     }
+
+    output_sequence& output_sequence::sync() noexcept {
+        try {
+            if ( success_ ) {
+                stream_.sync();
+            }
+        } catch (...) {
+            success_ = false;
+            exception_ = std::current_exception();
+        }
+        return *this;
+    }
+
+    output_sequence& output_sequence::sync_if(bool yesno) noexcept {
+        return yesno ? sync() : *this;
+    }
 }
 
 namespace e2d
@@ -208,6 +285,19 @@ namespace e2d
             return nullptr;
         }
     }
+
+    output_stream_uptr make_buffered_stream(
+        output_stream_uptr stream,
+        std::size_t buffer_size) noexcept
+    {
+        try {
+            return stream
+                ? std::make_unique<buffered_stream>(std::move(stream), buffer_size)
+                : nullptr;
+        } catch (...) {
+            return nullptr;
+        }
+    }
 }
 
 namespace e2d::streams
@@ -0,0 +1,211 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/utils/_all.hpp>
+using namespace e2d;
+
+namespace
+{
+    const char* usage_message =
+        "usage: e2d_compress [options] <input> <output>\n"
+        "\n"
+        "  <input> and <output> are image files or directories,\n"
+        "  directories are converted recursively\n"
+        "\n"
+        "  --container <dds|pvr>     output container, by default from the output\n"
+        "                            extension, dds for directories\n"
+        "  --format <format>         rgba_dxt1, rgba_dxt3, rgba_dxt5, rgb_etc1,\n"
+        "                            rgb_etc2 or rgba_etc2, by default rgba_dxt5\n"
+        "                            for dds and rgba_etc2 for pvr\n"
+        "  --quality <quality>       fast, normal or best, by default normal\n"
+        "  --mipmaps <filter|none>   box, kaiser or none, by default box\n";
+
+    const vector<str> source_extensions = {
+        ".png", ".jpg", ".jpeg", ".tga"};
+
+    struct options {
+        str input;
+        str output;
+        std::optional<image_file_format> container;
+        std::optional<image_data_format> format;
+        image_compression_quality quality{image_compression_quality::normal};
+        std::optional<image_mipmap_filter> mipmaps{image_mipmap_filter::box};
+    };
+
+    bool parse_options(options& dst, int argc, char* argv[]) {
+        options opts;
+        vector<str> positional;
+        for ( int i = 1; i < argc; ++i ) {
+            const str_view arg = argv[i];
+            if ( arg == "--container" && i + 1 < argc ) {
+                opts.container = image_file_format_traits::from_string(argv[++i]);
+                if ( opts.container != image_file_format::dds
+                    && opts.container != image_file_format::pvr )
+                {
+                    return false;
+                }
+            } else if ( arg == "--format" && i + 1 < argc ) {
+                opts.format = image_data_format_traits::from_string(argv[++i]);
+                if ( !opts.format ) {
+                    return false;
+                }
+            } else if ( arg == "--quality" && i + 1 < argc ) {
+                const auto quality = image_compression_quality_traits::from_string(argv[++i]);
+                if ( !quality ) {
+                    return false;
+                }
+                opts.quality = *quality;
+            } else if ( arg == "--mipmaps" && i + 1 < argc ) {
+                const str_view filter = argv[++i];
+                opts.mipmaps = filter == "none"
+                    ? std::nullopt
+                    : image_mipmap_filter_traits::from_string(filter);
+                if ( !opts.mipmaps && filter != "none" ) {
+                    return false;
+                }
+            } else if ( strings::starts_with(arg, "--") ) {
+                return false;
+            } else {
+                positional.emplace_back(arg);
+            }
+        }
+        if ( positional.size() != 2u ) {
+            return false;
+        }
+        opts.input = std::move(positional[0]);
+        opts.output = std::move(positional[1]);
+        dst = std::move(opts);
+        return true;
+    }
+
+    std::optional<image_file_format> container_by_extension(str_view filename) {
+        const str extension = path::extension(filename);
+        if ( extension == ".dds" ) {
+            return image_file_format::dds;
+        }
+        if ( extension == ".pvr" ) {
+            return image_file_format::pvr;
+        }
+        return std::nullopt;
+    }
+
+    image_data_format default_format(image_file_format container) noexcept {
+        return container == image_file_format::pvr
+            ? image_data_format::rgba_etc2
+            : image_data_format::rgba_dxt5;
+    }
+
+    bool convert_file(
+        const options& opts,
+        image_file_format container,
+        const str& input,
+        const str& output)
+    {
+        image content;
+        if ( !images::try_load_image(content, make_read_file(input)) ) {
+            std::fprintf(stderr, "e2d_compress: failed to load image '%s'\n", input.c_str());
+            return false;
+        }
+
+        if ( opts.mipmaps && content.mipmap_count() == 1u ) {
+            if ( !images::try_generate_mipmaps(content, content, *opts.mipmaps) ) {
+                std::fprintf(stderr, "e2d_compress: failed to generate mipmaps for '%s'\n", input.c_str());
+                return false;
+            }
+        }
+
+        const image_data_format format = opts.format
+            ? *opts.format
+            : default_format(container);
+
+        if ( !images::try_compress(content, content, format, opts.quality) ) {
+            std::fprintf(stderr, "e2d_compress: failed to compress image '%s' to %s\n",
+                input.c_str(), str(enum_hpp::to_string_or_throw(format)).c_str());
+            return false;
+        }
+
+        if ( !images::check_save_image_support(content, container) ) {
+            std::fprintf(stderr, "e2d_compress: %s can't store %s images\n",
+                str(enum_hpp::to_string_or_throw(container)).c_str(),
+                str(enum_hpp::to_string_or_throw(format)).c_str());
+            return false;
+        }
+
+        const str output_directory = path::parent_path(output);
+        if ( !output_directory.empty() && !filesystem::create_directory_recursive(output_directory) ) {
+            std::fprintf(stderr, "e2d_compress: failed to create directory '%s'\n", output_directory.c_str());
+            return false;
+        }
+
+        if ( !images::try_save_image(content, container, make_write_file(output, false)) ) {
+            std::fprintf(stderr, "e2d_compress: failed to write image '%s'\n", output.c_str());
+            return false;
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    options opts;
+    if ( !parse_options(opts, argc, argv) ) {
+        std::fputs(usage_message, stderr);
+        return 1;
+    }
+
+    if ( !filesystem::directory_exists(opts.input) ) {
+        const auto container = opts.container
+            ? opts.container
+            : container_by_extension(opts.output);
+        if ( !container ) {
+            std::fprintf(stderr, "e2d_compress: unknown container of '%s'\n", opts.output.c_str());
+            return 1;
+        }
+        if ( !convert_file(opts, *container, opts.input, opts.output) ) {
+            return 1;
+        }
+        std::printf("e2d_compress: '%s' converted into '%s'\n",
+            opts.input.c_str(), opts.output.c_str());
+        return 0;
+    }
+
+    vector<std::pair<str,bool>> files;
+    if ( !filesystem::extract_directory_recursive(opts.input, std::back_inserter(files)) ) {
+        std::fprintf(stderr, "e2d_compress: failed to list directory '%s'\n", opts.input.c_str());
+        return 1;
+    }
+
+    const image_file_format container = opts.container
+        ? *opts.container
+        : image_file_format::dds;
+
+    std::size_t converted = 0u;
+    for ( const auto& [filename, directory] : files ) {
+        if ( directory ) {
+            continue;
+        }
+        const str extension = path::extension(filename);
+        const bool source = std::any_of(
+            source_extensions.begin(), source_extensions.end(),
+            [&extension](const str& e){
+                return e == extension;
+            });
+        if ( !source ) {
+            continue;
+        }
+        const str output = path::replace_extension(
+            path::combine(opts.output, filename),
+            enum_hpp::to_string_or_throw(container));
+        if ( !convert_file(opts, container, path::combine(opts.input, filename), output) ) {
+            return 1;
+        }
+        ++converted;
+    }
+
+    std::printf("e2d_compress: %zu images converted into '%s'\n",
+        converted, opts.output.c_str());
+    return 0;
+}
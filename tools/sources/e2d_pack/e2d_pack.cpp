@@ -0,0 +1,121 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/utils/_all.hpp>
+using namespace e2d;
+
+namespace
+{
+    const char* usage_message =
+        "usage: e2d_pack [--store-all] [--store <extension>]... <directory> <pack>\n"
+        "\n"
+        "  --store-all          store every file uncompressed\n"
+        "  --store <extension>  store files with the extension uncompressed\n";
+
+    // already compressed formats gain nothing from deflate,
+    // stored as is they can be mapped without copying
+    const vector<str> default_stored_extensions = {
+        ".png", ".jpg", ".jpeg", ".ogg", ".mp3"};
+
+    struct options {
+        str directory;
+        str output;
+        bool store_all{false};
+        vector<str> stored_extensions = default_stored_extensions;
+    };
+
+    bool parse_options(options& dst, int argc, char* argv[]) {
+        options opts;
+        vector<str> positional;
+        for ( int i = 1; i < argc; ++i ) {
+            const str_view arg = argv[i];
+            if ( arg == "--store-all" ) {
+                opts.store_all = true;
+            } else if ( arg == "--store" && i + 1 < argc ) {
+                str extension = argv[++i];
+                if ( !strings::starts_with(extension, ".") ) {
+                    extension.insert(extension.begin(), '.');
+                }
+                opts.stored_extensions.push_back(std::move(extension));
+            } else if ( strings::starts_with(arg, "--") ) {
+                return false;
+            } else {
+                positional.emplace_back(arg);
+            }
+        }
+        if ( positional.size() != 2u ) {
+            return false;
+        }
+        opts.directory = std::move(positional[0]);
+        opts.output = std::move(positional[1]);
+        dst = std::move(opts);
+        return true;
+    }
+
+    pack::compression file_compression(const options& opts, str_view filename) {
+        if ( opts.store_all ) {
+            return pack::compression::none;
+        }
+        const str extension = path::extension(filename);
+        const bool stored = std::any_of(
+            opts.stored_extensions.begin(), opts.stored_extensions.end(),
+            [&extension](const str& e){
+                return e == extension;
+            });
+        return stored
+            ? pack::compression::none
+            : pack::compression::deflate;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    options opts;
+    if ( !parse_options(opts, argc, argv) ) {
+        std::fputs(usage_message, stderr);
+        return 1;
+    }
+
+    vector<std::pair<str,bool>> files;
+    if ( !filesystem::extract_directory_recursive(opts.directory, std::back_inserter(files)) ) {
+        std::fprintf(stderr, "e2d_pack: failed to list directory '%s'\n", opts.directory.c_str());
+        return 1;
+    }
+
+    pack_builder builder;
+    for ( const auto& [filename, directory] : files ) {
+        if ( directory ) {
+            continue;
+        }
+        buffer content;
+        if ( !filesystem::try_read_all(content, path::combine(opts.directory, filename)) ) {
+            std::fprintf(stderr, "e2d_pack: failed to read file '%s'\n", filename.c_str());
+            return 1;
+        }
+        builder.add_file(filename, std::move(content), file_compression(opts, filename));
+    }
+
+    if ( !builder.try_save(make_write_file(opts.output, false)) ) {
+        std::fprintf(stderr, "e2d_pack: failed to write pack '%s'\n", opts.output.c_str());
+        return 1;
+    }
+
+    pack result;
+    if ( !packs::try_load_pack(result, make_read_file(opts.output)) ) {
+        std::fprintf(stderr, "e2d_pack: failed to verify pack '%s'\n", opts.output.c_str());
+        return 1;
+    }
+
+    std::size_t compressed = 0u;
+    for ( std::size_t i = 0; i < result.entry_count(); ++i ) {
+        if ( result.entry_at(i).method == pack::compression::deflate ) {
+            ++compressed;
+        }
+    }
+
+    std::printf("e2d_pack: %zu files (%zu compressed) packed into '%s'\n",
+        result.entry_count(), compressed, opts.output.c_str());
+    return 0;
+}
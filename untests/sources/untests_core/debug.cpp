@@ -24,6 +24,28 @@ namespace
         }
     };
     str test_sink::s_on_message_acc;
+
+    class reentrant_sink final : public debug::sink {
+    public:
+        reentrant_sink(debug& d) : debug_(d) {}
+
+        bool on_message(debug::level lvl, str_view text) noexcept final {
+            E2D_UNUSED(lvl, text);
+            if ( !registered_ ) {
+                // the debug lock isn't held while sinks are called
+                registered_ = &debug_.register_sink<test_sink>();
+                debug_.set_min_level(debug_.min_level());
+            }
+            return true;
+        }
+
+        test_sink* registered() const noexcept {
+            return registered_;
+        }
+    private:
+        debug& debug_;
+        test_sink* registered_ = nullptr;
+    };
 }
 
 TEST_CASE("debug"){
@@ -73,4 +95,36 @@ TEST_CASE("debug"){
         REQUIRE(s2.on_message_acc == "qer");
         modules::shutdown<debug>();
     }
+    {
+        debug d;
+        reentrant_sink& s = d.register_sink<reentrant_sink>(d);
+        d.trace("first");
+        REQUIRE(s.registered());
+        REQUIRE(s.registered()->on_message_acc.empty());
+        d.trace("second");
+        REQUIRE(s.registered()->on_message_acc == "second");
+    }
+    {
+        DEFER_HPP([](){
+            filesystem::remove_file("debug_async_sink_file");
+        });
+        {
+            debug d;
+            debug_async_sink& s = d.register_sink<debug_async_sink>(
+                make_write_file("debug_async_sink_file", false),
+                debug::level::error);
+            d.trace("hello");
+            d.warning("world");
+            REQUIRE(s.flush());
+
+            str content;
+            REQUIRE(filesystem::try_read_all(content, "debug_async_sink_file"));
+            REQUIRE(content.find("-> hello\n") != str::npos);
+            REQUIRE(content.find("-> world\n") != str::npos);
+
+            d.error("sync");
+            REQUIRE(filesystem::try_read_all(content, "debug_async_sink_file"));
+            REQUIRE(content.find("-> sync\n") != str::npos);
+        }
+    }
 }
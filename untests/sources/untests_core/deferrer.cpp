@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_core.hpp"
+using namespace e2d;
+
+TEST_CASE("deferrer") {
+    SECTION("priorities") {
+        deferrer d;
+        d.main_thread_budget(make_microseconds<u64>(0u));
+
+        str order;
+        d.do_in_main_thread(deferrer_priority::low, [&order](){ order += 'l'; });
+        d.do_in_main_thread([&order](){ order += 'n'; });
+        d.do_in_main_thread(deferrer_priority::high, [&order](){ order += 'h'; });
+        d.do_in_main_thread(deferrer_priority::high, [&order](){ order += 'H'; });
+        REQUIRE(d.statistics().queued_tasks == 4u);
+
+        d.frame_tick();
+        REQUIRE(order == "h");
+        REQUIRE(d.statistics().executed_tasks == 1u);
+        REQUIRE(d.statistics().deferred_tasks == 3u);
+
+        d.frame_tick();
+        d.frame_tick();
+        d.frame_tick();
+        REQUIRE(order == "hHnl");
+        REQUIRE(d.statistics().queued_tasks == 0u);
+        REQUIRE(d.statistics().total_executed_tasks == 4u);
+
+        d.frame_tick();
+        REQUIRE(d.statistics().executed_tasks == 0u);
+    }
+    SECTION("budget") {
+        deferrer d;
+        d.main_thread_budget(make_microseconds<u64>(10000000u));
+        for ( std::size_t i = 0; i < 10; ++i ) {
+            d.do_in_main_thread([](){});
+        }
+        d.frame_tick();
+        REQUIRE(d.statistics().executed_tasks == 10u);
+        REQUIRE(d.statistics().deferred_tasks == 0u);
+    }
+    SECTION("rescheduling") {
+        deferrer d;
+        d.main_thread_budget(make_microseconds<u64>(10000000u));
+        std::size_t runs = 0u;
+        std::function<void()> task = [&d, &runs, &task](){
+            ++runs;
+            d.do_in_main_thread(task);
+        };
+        d.do_in_main_thread(task);
+        d.frame_tick();
+        REQUIRE(runs == 1u);
+        d.frame_tick();
+        REQUIRE(runs == 2u);
+        REQUIRE(d.statistics().deferred_tasks == 1u);
+    }
+    SECTION("snapshot") {
+        deferrer d;
+        d.main_thread_budget(make_microseconds<u64>(10000000u));
+
+        // tasks queued during a tick wait for the next one
+        // even when they outrank the tasks queued before it
+        str order;
+        d.do_in_main_thread(deferrer_priority::low, [&d, &order](){
+            order += 'l';
+            d.do_in_main_thread(deferrer_priority::high, [&order](){ order += 'H'; });
+        });
+        d.do_in_main_thread(deferrer_priority::low, [&order](){ order += 'L'; });
+
+        d.frame_tick();
+        REQUIRE(order == "lL");
+        REQUIRE(d.statistics().executed_tasks == 2u);
+        REQUIRE(d.statistics().deferred_tasks == 1u);
+
+        d.frame_tick();
+        REQUIRE(order == "lLH");
+        REQUIRE(d.statistics().queued_tasks == 0u);
+    }
+    SECTION("results") {
+        deferrer d;
+        auto p1 = d.do_in_main_thread([](int v){ return v * 2; }, 21);
+        auto p2 = d.do_in_main_thread([]() -> int { throw std::logic_error("fail"); });
+        d.active_safe_wait_promise(p1);
+        d.active_safe_wait_promise(p2);
+        REQUIRE(p1.get() == 42);
+        REQUIRE_THROWS_AS(p2.get(), std::logic_error);
+    }
+}
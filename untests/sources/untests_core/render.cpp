@@ -20,6 +20,70 @@ namespace
             modules::shutdown<engine>();
         }
     };
+
+    class mock_state_cache_backend final : public render::state_cache::backend {
+    public:
+        std::size_t use_program_calls = 0;
+        std::size_t set_uniform_calls = 0;
+        std::size_t active_texture_calls = 0;
+        std::size_t bind_texture_calls = 0;
+        std::size_t sampler_param_calls = 0;
+        std::size_t enable_attribute_calls = 0;
+        std::size_t disable_attribute_calls = 0;
+    public:
+        void use_program(u32) noexcept final { ++use_program_calls; }
+        void set_uniform(i32, const render::property_value&) noexcept final { ++set_uniform_calls; }
+
+        void active_texture(u32) noexcept final { ++active_texture_calls; }
+        void bind_texture(u32, u32) noexcept final { ++bind_texture_calls; }
+
+        void set_texture_s_wrap(u32, render::sampler_wrap) noexcept final { ++sampler_param_calls; }
+        void set_texture_t_wrap(u32, render::sampler_wrap) noexcept final { ++sampler_param_calls; }
+        void set_texture_min_filter(u32, render::sampler_min_filter) noexcept final { ++sampler_param_calls; }
+        void set_texture_mag_filter(u32, render::sampler_mag_filter) noexcept final { ++sampler_param_calls; }
+
+        void enable_attribute(u32) noexcept final { ++enable_attribute_calls; }
+        void disable_attribute(u32) noexcept final { ++disable_attribute_calls; }
+    };
+
+    texture_ptr make_fake_texture() {
+        // the uploader treats textures as opaque handles
+        static u8 storage = 0;
+        return texture_ptr(std::shared_ptr<void>(), reinterpret_cast<texture*>(&storage));
+    }
+
+    class mock_texture_uploader_backend final : public render::texture_uploader::backend {
+    public:
+        std::size_t create_image_calls = 0;
+        std::size_t create_storage_calls = 0;
+        vector<b2u> updated_regions;
+        vector<u32> updated_levels;
+        std::size_t updated_bytes = 0;
+        u32 max_mipmap_count = std::numeric_limits<u32>::max();
+        u32 allocated_mipmap_count = 1u;
+    public:
+        texture_ptr create_texture(const image& image) final {
+            ++create_image_calls;
+            allocated_mipmap_count = math::min(image.mipmap_count(), max_mipmap_count);
+            return make_fake_texture();
+        }
+
+        texture_ptr create_texture(const v2u&, const pixel_declaration&, u32 mipmap_count) final {
+            ++create_storage_calls;
+            allocated_mipmap_count = math::min(mipmap_count, max_mipmap_count);
+            return make_fake_texture();
+        }
+
+        void update_texture(const texture_ptr&, buffer_view pixels, const b2u& region, u32 level) final {
+            updated_regions.push_back(region);
+            updated_levels.push_back(level);
+            updated_bytes += pixels.size();
+        }
+
+        u32 texture_mipmap_count(const texture_ptr&) const noexcept final {
+            return allocated_mipmap_count;
+        }
+    };
 }
 
 TEST_CASE("render"){
@@ -105,6 +169,43 @@ TEST_CASE("render"){
             REQUIRE(*pb2.property<f32>("f") == 1.f);
         }
     }
+    SECTION("property_block_hash"){
+        {
+            auto pb1 = render::property_block()
+                .property("f", 1.f)
+                .property("m", m4f::identity())
+                .sampler("s", render::sampler_state());
+            auto pb2 = render::property_block()
+                .sampler("s", render::sampler_state())
+                .property("m", m4f::identity())
+                .property("f", 1.f);
+            REQUIRE(pb1.hash() == pb2.hash());
+            REQUIRE(pb1 == pb2);
+
+            pb2.property("f", 2.f);
+            REQUIRE(pb1.hash() != pb2.hash());
+            REQUIRE(pb1 != pb2);
+
+            pb2.property("f", 1.f);
+            REQUIRE(pb1.hash() == pb2.hash());
+            REQUIRE(pb1 == pb2);
+
+            pb2.sampler("s", render::sampler_state()
+                .s_wrap(render::sampler_wrap::clamp));
+            REQUIRE(pb1.hash() != pb2.hash());
+            REQUIRE(pb1 != pb2);
+
+            pb1.clear();
+            REQUIRE(pb1.hash() == render::property_block().hash());
+        }
+        {
+            const auto pb1 = render::property_block()
+                .property("f", 0.f);
+            const auto pb2 = render::property_block()
+                .property("f", -0.f);
+            REQUIRE(pb1 == pb2);
+        }
+    }
     SECTION("index_declaration"){
         index_declaration id;
         REQUIRE(id.type() == index_declaration::index_type::unsigned_short);
@@ -173,6 +274,305 @@ TEST_CASE("render"){
         REQUIRE(vd4 != vd);
         REQUIRE(vd4 == vd3);
     }
+    SECTION("state_cache"){
+        {
+            mock_state_cache_backend b;
+            render::state_cache c(b);
+            c.use_program(1).use_program(1).use_program(2).use_program(2);
+            REQUIRE(b.use_program_calls == 2);
+            REQUIRE(c.stats().avoided_program_binds == 2);
+
+            c.invalidate().use_program(2);
+            REQUIRE(b.use_program_calls == 3);
+        }
+        {
+            mock_state_cache_backend b;
+            render::state_cache c(b);
+            render::state_cache::uniform_values p1, p2;
+            c.set_uniform(p1, 0, 0, 1.f).set_uniform(p1, 0, 0, 1.f);
+            REQUIRE(b.set_uniform_calls == 1);
+            c.set_uniform(p1, 0, 0, 2.f).set_uniform(p1, 0, 0, 2);
+            REQUIRE(b.set_uniform_calls == 3);
+            c.set_uniform(p2, 0, 0, 2);
+            REQUIRE(b.set_uniform_calls == 4);
+            c.set_uniform(p1, 1, 1, m4f::identity()).set_uniform(p1, 1, 1, m4f::identity());
+            REQUIRE(b.set_uniform_calls == 5);
+            REQUIRE(c.stats().avoided_uniform_uploads == 2);
+        }
+        {
+            mock_state_cache_backend b;
+            render::state_cache c(b);
+            c.bind_texture(0, 1, 10).bind_texture(0, 1, 10);
+            REQUIRE(b.active_texture_calls == 1);
+            REQUIRE(b.bind_texture_calls == 1);
+            c.bind_texture(1, 1, 10).bind_texture(1, 1, 11).bind_texture(0, 1, 10);
+            REQUIRE(b.active_texture_calls == 2);
+            REQUIRE(b.bind_texture_calls == 3);
+            REQUIRE(c.stats().avoided_texture_binds == 2);
+            REQUIRE(c.stats().avoided_texture_units == 1);
+
+            render::state_cache::sampler_values sv;
+            const auto ss = render::sampler_state()
+                .s_wrap(render::sampler_wrap::clamp);
+            c.set_sampler(sv, 0, 1, ss);
+            REQUIRE(b.sampler_param_calls == 4);
+            REQUIRE(b.active_texture_calls == 3);
+            c.set_sampler(sv, 0, 1, ss);
+            REQUIRE(b.sampler_param_calls == 4);
+            c.set_sampler(sv, 0, 1, render::sampler_state(ss)
+                .filter(render::sampler_min_filter::nearest, render::sampler_mag_filter::linear));
+            REQUIRE(b.sampler_param_calls == 5);
+            REQUIRE(c.stats().avoided_sampler_params == 7);
+        }
+        {
+            mock_state_cache_backend b;
+            render::state_cache c(b);
+            c.begin_attributes().enable_attribute(0).enable_attribute(1).end_attributes();
+            REQUIRE(b.enable_attribute_calls == 2);
+            REQUIRE(b.disable_attribute_calls == 0);
+            c.begin_attributes().enable_attribute(0).enable_attribute(1).end_attributes();
+            REQUIRE(b.enable_attribute_calls == 2);
+            REQUIRE(b.disable_attribute_calls == 0);
+            c.begin_attributes().enable_attribute(1).enable_attribute(4).end_attributes();
+            REQUIRE(b.enable_attribute_calls == 3);
+            REQUIRE(b.disable_attribute_calls == 1);
+            REQUIRE(c.stats().avoided_attribute_toggles == 3);
+
+            c.reset_statistics();
+            REQUIRE(c.stats().avoided_attribute_toggles == 0);
+        }
+    }
+    SECTION("command_queue"){
+        {
+            const u64 k1 = render::command_queue::make_sort_key(0, 1, 0, 0, 0);
+            const u64 k2 = render::command_queue::make_sort_key(0, 0, 0xFFFF, 0xFFF, 0xFFF);
+            const u64 k3 = render::command_queue::make_sort_key(1, 0, 0, 0, 0);
+            REQUIRE(k2 < k1);
+            REQUIRE(k1 < k3);
+            REQUIRE(render::command_queue::make_sort_key(0, 0, 0, 1, 0)
+                > render::command_queue::make_sort_key(0, 0, 0, 0, 0xFFF));
+        }
+        {
+            render::material m1, m2;
+            render::geometry g;
+            render::command_queue q;
+            q.add_command(3, render::draw_command(m1, g).index_range(0, 6))
+             .add_command(1, render::draw_command(m2, g).index_range(6, 6))
+             .add_command(2, render::draw_command(m1, g).index_range(12, 6))
+             .add_command(0, render::clear_command())
+             .add_command(2, render::draw_command(m2, g).index_range(18, 6))
+             .add_command(1, render::draw_command(m2, g).index_range(24, 6));
+            REQUIRE(q.command_count() == 6);
+
+            q.sort();
+            REQUIRE(q.command_count() == 6);
+            REQUIRE(q.sort_key(0) == 1);
+            REQUIRE(q.sort_key(1) == 2);
+            REQUIRE(q.sort_key(2) == 3);
+            REQUIRE(std::holds_alternative<render::clear_command>(q.command(3)));
+            REQUIRE(q.sort_key(4) == 1);
+            REQUIRE(q.sort_key(5) == 2);
+            REQUIRE(&std::get<render::draw_command>(q.command(0)).material_ref() == &m2);
+            REQUIRE(std::get<render::draw_command>(q.command(4)).first_index() == 24);
+        }
+        {
+            render::material m;
+            render::geometry g;
+            render::command_queue q;
+            q.add_command(1, render::draw_command(m, g).index_range(12, 6))
+             .add_command(0, render::draw_command(m, g).index_range(0, 6))
+             .add_command(0, render::draw_command(m, g).index_range(6, 6))
+             .add_command(2, render::draw_command(m, g).index_range(18, 6))
+             .add_command(0, render::draw_command(m, g).index_range(30, 6));
+            q.sort();
+            REQUIRE(q.command_count() == 3);
+            REQUIRE(std::get<render::draw_command>(q.command(0)).first_index() == 0);
+            REQUIRE(std::get<render::draw_command>(q.command(0)).index_count() == 12);
+            REQUIRE(std::get<render::draw_command>(q.command(1)).first_index() == 30);
+            REQUIRE(std::get<render::draw_command>(q.command(1)).index_count() == 6);
+            REQUIRE(std::get<render::draw_command>(q.command(2)).first_index() == 12);
+            REQUIRE(std::get<render::draw_command>(q.command(2)).index_count() == 12);
+
+            q.clear();
+            REQUIRE(q.command_count() == 0);
+            REQUIRE_NOTHROW(q.sort());
+        }
+    }
+    SECTION("ring_allocator"){
+        {
+            render::ring_allocator r(100, 2);
+            REQUIRE(r.capacity() == 100);
+            REQUIRE(r.frame_count() == 2);
+            REQUIRE_FALSE(r.allocate(101, 1));
+
+            auto a1 = r.allocate(30, 1);
+            REQUIRE((a1 && a1->offset == 0 && !a1->orphaned));
+            auto a2 = r.allocate(30, 8);
+            REQUIRE((a2 && a2->offset == 32 && !a2->orphaned));
+            REQUIRE(r.used_size() == 62);
+
+            // frame 1 is in flight, the end of the ring is still free
+            r.next_frame();
+            auto a3 = r.allocate(30, 1);
+            REQUIRE((a3 && a3->offset == 62 && !a3->orphaned));
+
+            // no room at the end and frame 1 is still in flight
+            auto a4 = r.allocate(20, 1);
+            REQUIRE((a4 && a4->offset == 0 && a4->orphaned));
+            REQUIRE(r.used_size() == 20);
+        }
+        {
+            render::ring_allocator r(100, 2);
+            REQUIRE(r.allocate(60, 1)->offset == 0);
+            r.next_frame();
+            REQUIRE(r.allocate(30, 1)->offset == 60);
+            r.next_frame();
+
+            // frame 1 is retired, so the allocation wraps around
+            auto a = r.allocate(40, 1);
+            REQUIRE((a && a->offset == 0 && !a->orphaned));
+            REQUIRE(r.used_size() == 30 + 10 + 40);
+
+            r.next_frame().next_frame();
+            REQUIRE(r.used_size() == 0);
+
+            r.reset(10);
+            REQUIRE(r.capacity() == 10);
+            REQUIRE_FALSE(r.allocate(11, 1));
+            REQUIRE(r.allocate(10, 1)->offset == 0);
+        }
+    }
+    SECTION("texture_uploader"){
+        using pixel_type = pixel_declaration::pixel_type;
+        {
+            REQUIRE(render::texture_uploader::band_height(pixel_type::rgba8, 16, 0) == 1u);
+            REQUIRE(render::texture_uploader::band_height(pixel_type::rgba8, 16, 64) == 1u);
+            REQUIRE(render::texture_uploader::band_height(pixel_type::rgba8, 16, 200) == 3u);
+            REQUIRE(render::texture_uploader::band_height(pixel_type::rgba_dxt5, 16, 0) == 4u);
+            REQUIRE(render::texture_uploader::band_height(pixel_type::rgba_dxt5, 16, 200) == 12u);
+
+            REQUIRE(render::texture_uploader::is_band_uploadable(pixel_type::rgb8));
+            REQUIRE(render::texture_uploader::is_band_uploadable(pixel_type::rgba_dxt1));
+            REQUIRE_FALSE(render::texture_uploader::is_band_uploadable(pixel_type::rgba_pvrtc4));
+            REQUIRE_FALSE(render::texture_uploader::is_band_uploadable(pixel_type::rgb_etc1));
+        }
+        {
+            mock_texture_uploader_backend b;
+            render::texture_uploader u(b);
+            u.byte_budget(64u);
+
+            const image small(v2u(4,4), image_data_format::rgba8, buffer(64u));
+            auto s = u.upload_texture(small, pixel_type::rgba8);
+            REQUIRE(s);
+            REQUIRE(s->ready());
+            REQUIRE(s->texture());
+            REQUIRE(b.create_image_calls == 1u);
+            REQUIRE(u.empty());
+        }
+        {
+            mock_texture_uploader_backend b;
+            render::texture_uploader u(b);
+            u.byte_budget(100u);
+
+            const image big(v2u(8,10), image_data_format::rgba8, buffer(8u * 10u * 4u));
+            auto s = u.upload_texture(big, pixel_type::rgba8);
+            REQUIRE(s);
+            REQUIRE_FALSE(s->ready());
+            REQUIRE(b.create_storage_calls == 1u);
+            REQUIRE(u.pending_count() == 1u);
+
+            u.frame_tick();
+            REQUIRE(s->uploaded_rows() == 6u);
+            REQUIRE(u.stats().uploaded_bands == 2u);
+            REQUIRE(u.stats().uploaded_bytes == 8u * 6u * 4u);
+            REQUIRE(b.updated_regions.size() == 2u);
+            REQUIRE(b.updated_regions[0] == b2u(0, 0, 8, 3));
+            REQUIRE(b.updated_regions[1] == b2u(0, 3, 8, 3));
+            REQUIRE_FALSE(s->ready());
+
+            u.frame_tick();
+            REQUIRE(s->ready());
+            REQUIRE(s->uploaded_levels() == 1u);
+            REQUIRE(b.updated_regions.back() == b2u(0, 9, 8, 1));
+            REQUIRE(b.updated_bytes == big.data().size());
+            REQUIRE(u.stats().total_uploaded_bytes == big.data().size());
+            REQUIRE(u.empty());
+        }
+        {
+            mock_texture_uploader_backend b;
+            render::texture_uploader u(b);
+            u.byte_budget(0u);
+
+            const image big(v2u(4,4), image_data_format::rgba8, buffer(64u));
+            auto s1 = u.upload_texture(big, pixel_type::rgba8);
+            auto s2 = u.upload_texture(big, pixel_type::rgba8);
+
+            u.frame_tick();
+            REQUIRE(u.stats().uploaded_bands == 1u);
+            REQUIRE(s1->uploaded_rows() == 1u);
+            REQUIRE(s2->uploaded_rows() == 0u);
+
+            u.flush();
+            REQUIRE(s1->ready());
+            REQUIRE(s2->ready());
+            REQUIRE(b.updated_regions.size() == 8u);
+        }
+        {
+            mock_texture_uploader_backend b;
+            render::texture_uploader u(b);
+            u.byte_budget(64u);
+
+            // 8x4, 4x2, 2x1 and 1x1 levels
+            const image mips(v2u(8,4), image_data_format::rgba8, buffer(172u), 4u);
+            auto s = u.upload_texture(mips, pixel_type::rgba8);
+            REQUIRE_FALSE(s->ready());
+
+            u.frame_tick();
+            REQUIRE(s->uploaded_levels() == 0u);
+            REQUIRE(s->uploaded_rows() == 2u);
+
+            u.flush();
+            REQUIRE(s->ready());
+            REQUIRE(s->uploaded_levels() == 4u);
+            REQUIRE(b.updated_regions == vector<b2u>{
+                b2u(0, 0, 8, 2), b2u(0, 2, 8, 2),
+                b2u(0, 0, 4, 2), b2u(0, 0, 2, 1), b2u(0, 0, 1, 1)});
+            REQUIRE(b.updated_levels == vector<u32>{0u, 0u, 1u, 2u, 3u});
+            REQUIRE(b.updated_bytes == mips.data().size());
+        }
+        {
+            mock_texture_uploader_backend b;
+            b.max_mipmap_count = 1u;
+            render::texture_uploader u(b);
+            u.byte_budget(64u);
+
+            // like npot textures without npot support, only the first level is allocated
+            const image mips(v2u(8,4), image_data_format::rgba8, buffer(172u), 4u);
+            auto s = u.upload_texture(mips, pixel_type::rgba8);
+
+            u.flush();
+            REQUIRE(s->ready());
+            REQUIRE(s->uploaded_levels() == 1u);
+            REQUIRE(b.updated_levels == vector<u32>{0u, 0u});
+            REQUIRE(b.updated_bytes == 8u * 4u * 4u);
+        }
+        {
+            mock_texture_uploader_backend b;
+            render::texture_uploader u(b);
+            u.byte_budget(0u);
+
+            // pending uploads share the source image until they are done
+            const auto big = std::make_shared<const image>(
+                v2u(4,4), image_data_format::rgba8, buffer(64u));
+            auto s = u.upload_texture(big, pixel_type::rgba8);
+            REQUIRE_FALSE(s->ready());
+            REQUIRE(big.use_count() == 2);
+
+            u.flush();
+            REQUIRE(s->ready());
+            REQUIRE(big.use_count() == 1);
+        }
+    }
     SECTION("update_texture"){
         if ( modules::is_initialized<render>() ) {
             render& r = the<render>();
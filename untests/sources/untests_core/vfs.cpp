@@ -55,6 +55,53 @@ TEST_CASE("vfs"){
         REQUIRE(v.resolve_scheme_aliases({"home", "file.txt"}) == url("file://~/file.txt"));
         REQUIRE(v.resolve_scheme_aliases({"save", "save.txt"}) == url("file://~/game/saves/save.txt"));
     }
+    SECTION("worker_threads"){
+        vfs v(4u);
+        REQUIRE(v.register_scheme<filesystem_file_source>("file"));
+
+        vector<stdex::promise<buffer>> loads;
+        for ( std::size_t i = 0; i < 32u; ++i ) {
+            loads.push_back(v.load_async({"file", file_path}));
+            if ( i == 16u ) {
+                REQUIRE(v.register_scheme_alias("alias", url{"file", "."}));
+                REQUIRE_FALSE(v.register_scheme<filesystem_file_source>("file"));
+            }
+        }
+        for ( const auto& load : loads ) {
+            REQUIRE(load.get() == buffer{"hello", 5});
+        }
+
+        REQUIRE(v.exists({"alias", file_path}));
+        REQUIRE(v.unregister_scheme_alias("alias"));
+        REQUIRE_FALSE(v.unregister_scheme_alias("alias"));
+        REQUIRE_FALSE(v.exists({"alias", file_path}));
+    }
+    SECTION("map"){
+        vfs v;
+        REQUIRE(v.register_scheme<filesystem_file_source>("file"));
+        {
+            const mapped_file_uptr m = v.map({"file", file_path});
+            REQUIRE(m);
+            REQUIRE(m->content() == buffer_view("hello", 5));
+            REQUIRE_FALSE(v.map({"file", nofile_path}));
+            REQUIRE_FALSE(v.map({"file2", file_path}));
+        }
+        {
+            REQUIRE(filesystem::try_write_all(buffer(), "vfs_empty_file_name", false));
+            const mapped_file_uptr m = v.map({"file", "vfs_empty_file_name"});
+            REQUIRE(m);
+            REQUIRE(m->content().empty());
+            REQUIRE(filesystem::remove_file("vfs_empty_file_name"));
+        }
+        {
+            const mapped_file_sptr m = v.map_async({"file", file_path}).get();
+            REQUIRE(m);
+            REQUIRE(m->content() == buffer_view("hello", 5));
+            REQUIRE_THROWS_AS(
+                v.map_async({"file", nofile_path}).get(),
+                vfs_load_async_exception);
+        }
+    }
     SECTION("archive"){
         vfs v;
         {
@@ -148,6 +195,10 @@ TEST_CASE("vfs"){
 
                 auto b3 = v.load_as_string_async(url("archive://test.txt")).get();
                 REQUIRE(b3 == "hello");
+
+                auto m = v.map(url("archive://test.txt"));
+                REQUIRE(m);
+                REQUIRE(m->content() == buffer_view("hello", 5));
             }
             {
                 auto f = v.read(url("archive://folder/file.txt"));
@@ -198,4 +249,118 @@ TEST_CASE("vfs"){
             }
         }
     }
+    SECTION("pack"){
+        DEFER_HPP([](){
+            filesystem::remove_file("vfs_pack_name");
+        });
+        {
+            buffer big(pack::chunk_size * 3u);
+            big.fill(42u);
+            pack_builder b;
+            b.add_file("folder/big.bin", std::move(big))
+                .add_file("folder/subfolder/file.txt", buffer("world", 5))
+                .add_file("test.txt", buffer("hello", 5));
+            REQUIRE(b.try_save(make_write_file("vfs_pack_name", false)));
+        }
+
+        vfs v;
+        REQUIRE(v.register_scheme<pack_file_source>("pack", make_mapped_file("vfs_pack_name")));
+        REQUIRE(v.register_scheme<pack_file_source>("spack", make_read_file("vfs_pack_name"), 2u));
+        REQUIRE_FALSE(v.register_scheme<pack_file_source>("npack", make_read_file("vfs_file_name")));
+
+        for ( const char* scheme : {"pack", "spack"} ) {
+            REQUIRE(v.exists({scheme, "test.txt"}));
+            REQUIRE(v.exists({scheme, "folder/big.bin"}));
+            REQUIRE_FALSE(v.exists({scheme, "folder"}));
+            REQUIRE_FALSE(v.exists({scheme, "test2.txt"}));
+            {
+                auto f = v.read({scheme, "test.txt"});
+                REQUIRE(f);
+                REQUIRE(f->seek(2, false) == 2u);
+                buffer b;
+                REQUIRE(streams::try_read_tail(b, f));
+                REQUIRE(b == buffer("llo", 3));
+            }
+            {
+                auto b = v.load({scheme, "folder/big.bin"});
+                REQUIRE(b);
+                REQUIRE(b->size() == pack::chunk_size * 3u);
+                REQUIRE(std::all_of(b->begin(), b->end(), [](u8 c){ return c == 42u; }));
+            }
+            {
+                vector<std::pair<str,bool>> result;
+                REQUIRE(v.extract(url(scheme, ""), std::back_inserter(result)));
+                REQUIRE(result == vector<std::pair<str, bool>>{
+                    {"folder/", true},
+                    {"folder/big.bin", false},
+                    {"folder/subfolder/", true},
+                    {"folder/subfolder/file.txt", false},
+                    {"test.txt", false}
+                });
+            }
+            {
+                vector<std::pair<str,bool>> result;
+                REQUIRE(v.extract(url(scheme, "folder/subfolder"), std::back_inserter(result)));
+                REQUIRE(result == vector<std::pair<str, bool>>{
+                    {"folder/subfolder/file.txt", false}
+                });
+                REQUIRE_FALSE(v.extract(url(scheme, "fold"), std::back_inserter(result)));
+            }
+        }
+        {
+            // stored entries of a mapped pack point right into the mapping
+            auto m = v.map({"pack", "test.txt"});
+            REQUIRE(m);
+            REQUIRE(m->content() == buffer_view("hello", 5));
+            REQUIRE(reinterpret_cast<std::uintptr_t>(m->content().data()) % pack::alignment == 0u);
+            REQUIRE(v.unregister_scheme("pack"));
+            REQUIRE(m->content() == buffer_view("hello", 5));
+        }
+        {
+            auto m = v.map({"spack", "folder/big.bin"});
+            REQUIRE(m);
+            REQUIRE(m->content().size() == pack::chunk_size * 3u);
+        }
+    }
+    SECTION("archive_cache"){
+        vfs v;
+        str resources;
+        REQUIRE(filesystem::extract_predef_path(resources, filesystem::predef_path::resources));
+        REQUIRE(v.register_scheme_alias("resources", {"file", resources}));
+        REQUIRE(v.register_scheme<filesystem_file_source>("file"));
+
+        auto source = std::make_unique<archive_file_source>(
+            v.read(url("resources://bin/resources.zip")), 8u);
+        REQUIRE(source->valid());
+        REQUIRE(source->cache_budget() == 8u);
+        REQUIRE(source->cache_size() == 0u);
+        {
+            // every entry is seekable: stored ones in place, compressed ones from the cache
+            auto f = source->read("test.txt");
+            REQUIRE(f);
+            REQUIRE(f->length() == 5u);
+            REQUIRE(f->seek(1, false) == 1u);
+            buffer b;
+            REQUIRE(streams::try_read_tail(b, f));
+            REQUIRE(b == buffer("ello", 4));
+            REQUIRE(f->seek(-2, true) == 3u);
+            REQUIRE_THROWS_AS(f->seek(6, false), bad_vfs_operation);
+        }
+        {
+            auto f1 = source->read("folder/file.txt");
+            auto f2 = source->read("folder2/file.txt");
+            REQUIRE((f1 && f2));
+            buffer b1, b2;
+            REQUIRE(streams::try_read_tail(b1, f1));
+            REQUIRE(streams::try_read_tail(b2, f2));
+            REQUIRE(b1 == buffer("world", 5));
+            REQUIRE(source->cache_size() <= source->cache_budget());
+        }
+        {
+            auto m = source->map("folder/file.txt");
+            REQUIRE(m);
+            REQUIRE(m->content() == buffer_view("world", 5));
+            REQUIRE_FALSE(source->map("folder/file2.txt"));
+        }
+    }
 }
@@ -45,6 +45,23 @@ namespace
                 : stdex::make_rejected_promise<load_result>(asset_loading_exception());
         }
     };
+
+    class queued_asset final : public content_asset<queued_asset, int> {
+    public:
+        static const char* type_name() noexcept { return "queued_asset"; }
+
+        static vector<std::pair<str, load_async_result>>& started_loads() {
+            static vector<std::pair<str, load_async_result>> loads;
+            return loads;
+        }
+
+        static load_async_result load_async(const library& library, str_view address) {
+            E2D_UNUSED(library);
+            load_async_result result;
+            started_loads().emplace_back(address, result);
+            return result;
+        }
+    };
 }
 
 TEST_CASE("asset") {
@@ -86,4 +103,109 @@ TEST_CASE("asset") {
             REQUIRE_FALSE(l.load_asset<fake_asset, fake_nested_asset>("42:/21:/none:/2"));
         }
     }
+    SECTION("loading_queue") {
+        const auto zero_us = time::to_chrono(make_microseconds(0));
+        auto& started = queued_asset::started_loads();
+        started.clear();
+
+        // as many background loads as the library parameters allow
+        for ( std::size_t i = 0; i < 4u; ++i ) {
+            l.load_asset_async<queued_asset>(
+                "b" + std::to_string(i),
+                asset_loading_priority::background);
+        }
+        REQUIRE(started.size() == 4u);
+
+        const auto token = make_intrusive<asset_loading_token>();
+        l.load_asset_async<queued_asset>("b4", asset_loading_priority::background);
+        auto p0 = l.load_asset_async<queued_asset>("p0", asset_loading_request()
+            .priority(asset_loading_priority::prefetch)
+            .token(token));
+        auto p1 = l.load_asset_async<queued_asset>("p1", asset_loading_priority::prefetch);
+        REQUIRE(started.size() == 4u);
+        REQUIRE(l.queued_asset_count() == 3u);
+        REQUIRE(l.loading_asset_count() == 7u);
+
+        // visible loads don't wait for a free slot
+        auto v0 = l.load_asset_async<queued_asset>("v0");
+        REQUIRE(started.size() == 5u);
+        REQUIRE(started.back().first == "v0");
+
+        // and pull the queued ones they join
+        auto b4 = l.load_asset_async<queued_asset>("b4");
+        REQUIRE(started.size() == 6u);
+        REQUIRE(started.back().first == "b4");
+        REQUIRE(l.queued_asset_count() == 2u);
+
+        token->cancel();
+        l.process_loading_queue();
+        REQUIRE(l.queued_asset_count() == 1u);
+        REQUIRE(p0.wait_for(zero_us) != stdex::promise_wait_status::timeout);
+        REQUIRE_FALSE(p0.get_or_default(nullptr));
+        REQUIRE_FALSE(l.load_asset_async<queued_asset>("p0", asset_loading_request()
+            .token(token)).get_or_default(nullptr));
+
+        // a free slot goes to the queued prefetch load
+        started[0].second.resolve(queued_asset::create(0));
+        REQUIRE(started.size() == 7u);
+        REQUIRE(started.back().first == "p1");
+        REQUIRE(l.queued_asset_count() == 0u);
+        REQUIRE(l.store().peek<queued_asset>(make_hash("b0")));
+
+        for ( std::size_t i = 1; i < started.size(); ++i ) {
+            started[i].second.resolve(queued_asset::create(int(i)));
+        }
+        REQUIRE(l.loading_asset_count() == 0u);
+        REQUIRE(p1.get_or_default(nullptr));
+        REQUIRE(v0.get_or_default(nullptr));
+        REQUIRE(b4.get_or_default(nullptr));
+    }
+}
+
+TEST_CASE("asset_store") {
+    SECTION("memory_budget") {
+        asset_store s;
+        REQUIRE(s.memory_usage() == 0u);
+        REQUIRE(s.memory_budget() == std::numeric_limits<std::size_t>::max());
+
+        const auto a1 = binary_asset::create(buffer(1024u));
+        const std::size_t a1_usage = a1->memory_usage();
+        REQUIRE(a1_usage >= 1024u);
+
+        s.store<binary_asset>(make_hash("a1"), a1);
+        s.store<binary_asset>(make_hash("a2"), binary_asset::create(buffer(1024u)));
+        s.store<binary_asset>(make_hash("a3"), binary_asset::create(buffer(1024u)));
+        REQUIRE(s.asset_count() == 3u);
+        REQUIRE(s.memory_usage() == a1_usage * 3u);
+
+        REQUIRE(s.find<binary_asset>(make_hash("a2")));
+        REQUIRE_FALSE(s.find<binary_asset>(make_hash("none")));
+        REQUIRE(s.statistics<binary_asset>().hits == 1u);
+        REQUIRE(s.statistics<binary_asset>().misses == 1u);
+
+        REQUIRE(s.peek<binary_asset>(make_hash("a3")));
+        REQUIRE_FALSE(s.peek<binary_asset>(make_hash("none")));
+        REQUIRE(s.statistics<binary_asset>().hits == 1u);
+        REQUIRE(s.statistics<binary_asset>().misses == 1u);
+
+        // a1 is still referenced, a3 is the least recently used unreferenced one
+        s.memory_budget(a1_usage * 2u);
+        REQUIRE(s.asset_count() == 2u);
+        REQUIRE(s.find<binary_asset>(make_hash("a1")));
+        REQUIRE(s.find<binary_asset>(make_hash("a2")));
+        REQUIRE_FALSE(s.find<binary_asset>(make_hash("a3")));
+        REQUIRE(s.statistics<binary_asset>().evictions == 1u);
+
+        s.store<binary_asset>(make_hash("a4"), binary_asset::create(buffer(1024u)));
+        REQUIRE(s.asset_count() == 2u);
+        REQUIRE(s.memory_usage() == a1_usage * 2u);
+        REQUIRE_FALSE(s.find<binary_asset>(make_hash("a2")));
+        REQUIRE(s.statistics<binary_asset>().evictions == 2u);
+
+        s.memory_budget(0u);
+        REQUIRE(s.asset_count() == 1u);
+        REQUIRE(s.find<binary_asset>(make_hash("a1")));
+        REQUIRE(s.statistics<binary_asset>().asset_count == 1u);
+        REQUIRE(s.statistics<binary_asset>().memory_usage == a1_usage);
+    }
 }
@@ -140,19 +140,40 @@ TEST_CASE("library"){
         REQUIRE(image_res);
         REQUIRE(!image_res->content().empty());
 
-        REQUIRE(l.store().find<image_asset>("image.png"));
-        REQUIRE(l.store().find<binary_asset>("image.png"));
+        // images are parsed from the mapped file, no binary asset is kept
+        REQUIRE(l.store().peek<image_asset>("image.png"));
+        REQUIRE_FALSE(l.store().peek<binary_asset>("image.png"));
 
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
         l.unload_unused_assets();
-        REQUIRE(l.store().find<image_asset>("image.png"));
-        REQUIRE_FALSE(l.store().find<binary_asset>("image.png"));
+        REQUIRE(l.store().peek<image_asset>("image.png"));
 
         image_res.reset();
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
         l.unload_unused_assets();
-        REQUIRE_FALSE(l.store().find<image_asset>("image.png"));
-        REQUIRE_FALSE(l.store().find<binary_asset>("image.png"));
+        REQUIRE_FALSE(l.store().peek<image_asset>("image.png"));
+        REQUIRE_FALSE(l.store().peek<binary_asset>("image.png"));
+    }
+    {
+        auto text_res = l.load_asset<text_asset>("text_asset.txt", asset_cache_policy::transient);
+        REQUIRE(text_res);
+        REQUIRE(text_res->content() == "hello");
+        REQUIRE_FALSE(l.store().peek<text_asset>("text_asset.txt"));
+
+        auto text_res2 = l.load_asset<text_asset>("text_asset.txt");
+        REQUIRE(text_res2);
+        REQUIRE(text_res2.get() != text_res.get());
+        REQUIRE(l.store().peek<text_asset>("text_asset.txt") == text_res2);
+
+        const auto stats = l.statistics();
+        const auto iter = stats.find(text_asset::type_name());
+        REQUIRE(iter != stats.end());
+        REQUIRE(iter->second.asset_count == 1u);
+        REQUIRE(iter->second.memory_usage == text_res2->memory_usage());
+
+        text_res2.reset();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        REQUIRE(1u == l.unload_unused_assets());
     }
     {
         if ( modules::is_initialized<render>() ) {
@@ -164,6 +185,10 @@ TEST_CASE("library"){
             REQUIRE(texture_res);
             REQUIRE(texture_res->content());
 
+            // decoded images are released once textures are created
+            REQUIRE(l.store().peek<texture_asset>("image.png"));
+            REQUIRE_FALSE(l.store().peek<image_asset>("image.png"));
+
             auto material_res = l.load_asset<material_asset>("material.json");
             REQUIRE(material_res);
 
@@ -395,3 +420,53 @@ TEST_CASE("asset_dependencies") {
         }
     }
 }
+
+TEST_CASE("asset_manifest") {
+    safe_starter_initializer initializer;
+    library& l = the<library>();
+    {
+        auto manifest_res = l.load_asset<manifest_asset>("manifest.json");
+        REQUIRE(manifest_res);
+
+        const manifest& m = manifest_res->content();
+        REQUIRE_FALSE(m.find_dependencies("none"));
+        REQUIRE(m.find_dependencies("text_and_binary"));
+        REQUIRE(m.find_dependencies("text_and_binary")->size() == 3u);
+        REQUIRE(m.find_dependencies("text_and_binary")->front()
+            == manifest::dependency{"text_asset", "text_asset.txt"});
+
+        const auto progress = make_intrusive<asset_loading_progress>();
+        REQUIRE(math::approximately(progress->ratio(), 1.f));
+
+        auto g_p = l.preload_async(m, "text_and_binary", asset_loading_request(), progress);
+        the<deferrer>().active_safe_wait_promise(g_p);
+        asset_group g = g_p.get();
+        REQUIRE(g.find_asset<text_asset>("text_asset.txt"));
+        REQUIRE(g.find_asset<binary_asset>("binary_asset.bin"));
+        REQUIRE(progress->total() == 2u);
+        REQUIRE(progress->finished() == 2u);
+        REQUIRE(math::approximately(progress->ratio(), 1.f));
+    }
+    {
+        l.unload_unused_assets();
+        l.start_recording_loads();
+        REQUIRE(l.load_asset<text_asset>("text_asset.txt"));
+        REQUIRE(l.load_asset<text_asset>("text_asset.txt", asset_cache_policy::transient));
+        const vector<manifest::dependency> loads = l.stop_recording_loads();
+        REQUIRE(loads.size() == 1u);
+        REQUIRE(loads[0] == manifest::dependency{"text_asset", "text_asset.txt"});
+
+        manifest m;
+        m.set_dependencies("text", loads);
+        REQUIRE(manifests::try_save_manifest(m, make_write_file("manifest_test.json", false)));
+
+        str m_json;
+        REQUIRE(filesystem::try_read_all(m_json, "manifest_test.json"));
+        REQUIRE(filesystem::remove_file("manifest_test.json"));
+
+        rapidjson::Document doc;
+        REQUIRE_FALSE(doc.Parse(m_json.c_str()).HasParseError());
+        REQUIRE(doc["assets"]["text"][0]["type"] == "text_asset");
+        REQUIRE(doc["assets"]["text"][0]["address"] == "text_asset.txt");
+    }
+}
@@ -890,6 +890,85 @@ TEST_CASE("node") {
                 math::make_translation_matrix4(60.f,0.f));
         }
     }
+    SECTION("update_world_matrix_recursive") {
+        {
+            auto p = node::create();
+            auto n1 = node::create(p);
+            auto n2 = node::create(n1);
+            auto n3 = node::create(p);
+
+            p->translation({10.f,0.f});
+            n1->translation({20.f,0.f});
+            n2->translation({30.f,0.f});
+            n3->translation({40.f,0.f});
+
+            p->update_world_matrix_recursive();
+            REQUIRE(p->world_matrix() == math::make_translation_matrix4(10.f,0.f));
+            REQUIRE(n1->world_matrix() == math::make_translation_matrix4(30.f,0.f));
+            REQUIRE(n2->world_matrix() == math::make_translation_matrix4(60.f,0.f));
+            REQUIRE(n3->world_matrix() == math::make_translation_matrix4(50.f,0.f));
+
+            p->translation({0.f,0.f});
+            n2->world_matrix();
+            p->update_world_matrix_recursive();
+            REQUIRE(n1->world_matrix() == math::make_translation_matrix4(20.f,0.f));
+            REQUIRE(n2->world_matrix() == math::make_translation_matrix4(50.f,0.f));
+            REQUIRE(n3->world_matrix() == math::make_translation_matrix4(40.f,0.f));
+
+            p->translation({5.f,0.f});
+            REQUIRE(n2->world_matrix() == math::make_translation_matrix4(55.f,0.f));
+            p->update_world_matrix_recursive();
+            REQUIRE(n1->world_matrix() == math::make_translation_matrix4(25.f,0.f));
+            REQUIRE(n3->world_matrix() == math::make_translation_matrix4(45.f,0.f));
+        }
+        {
+            auto p1 = node::create();
+            p1->translation({10.f,0.f});
+            auto p2 = node::create();
+            p2->translation({20.f,0.f});
+
+            auto n = node::create(p1);
+            n->translation({1.f,0.f});
+            p1->update_world_matrix_recursive();
+            REQUIRE(n->world_matrix() == math::make_translation_matrix4(11.f,0.f));
+
+            n->remove_from_parent();
+            REQUIRE(n->world_matrix() == math::make_translation_matrix4(1.f,0.f));
+
+            p2->add_child(n);
+            p2->update_world_matrix_recursive();
+            REQUIRE(n->world_matrix() == math::make_translation_matrix4(21.f,0.f));
+        }
+    }
+    SECTION("world_version") {
+        auto p = node::create();
+        auto n1 = node::create(p);
+        auto n2 = node::create(p);
+
+        const u32 p_v = p->world_version();
+        const u32 n1_v = n1->world_version();
+        const u32 n2_v = n2->world_version();
+        REQUIRE(p_v != n1_v);
+        REQUIRE(n1_v != n2_v);
+
+        REQUIRE(p->world_version() == p_v);
+        REQUIRE(n1->world_version() == n1_v);
+
+        n1->translation({10.f,0.f});
+        REQUIRE(p->world_version() == p_v);
+        REQUIRE(n1->world_version() != n1_v);
+        REQUIRE(n2->world_version() == n2_v);
+
+        const u32 n1_v2 = n1->world_version();
+        p->translation({10.f,0.f});
+        REQUIRE(p->world_version() != p_v);
+        REQUIRE(n1->world_version() != n1_v2);
+        REQUIRE(n2->world_version() != n2_v);
+
+        const u32 n2_v2 = n2->world_version();
+        n2->remove_from_parent();
+        REQUIRE(n2->world_version() != n2_v2);
+    }
     SECTION("lifetime") {
         {
             fake_node::reset_counters();
@@ -37,6 +37,12 @@ TEST_CASE("prefab"){
         REQUIRE(prefab_root.children()[0].uuid() == "4A93547E-4635-4C2F-9C59-3546E11B1722");
         REQUIRE(prefab_root.children()[1].uuid() == "58063213-9FC1-457C-B773-B826BE1BE6D7");
 
+        const flat_prefab& flat_prefab_root = prefab_root_res->flat_content();
+        REQUIRE(flat_prefab_root.size() == 3u);
+        REQUIRE(flat_prefab_root.parent(0u) == flat_prefab::no_parent);
+        REQUIRE(flat_prefab_root.parent(1u) == 0u);
+        REQUIRE(flat_prefab_root.parent(2u) == 0u);
+
         auto go = the<world>().instantiate(prefab_root);
 
         {
@@ -0,0 +1,158 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_high.hpp"
+using namespace e2d;
+
+#include "../../../sources/enduro2d/high/systems/touch_system_impl/touch_system_colliders.hpp"
+using namespace e2d::touch_system_impl;
+
+#include <random>
+
+namespace
+{
+    class safe_starter_initializer final : private noncopyable {
+    public:
+        safe_starter_initializer() {
+            modules::initialize<starter>(0, nullptr,
+                starter::parameters(
+                    engine::parameters("touch_system_untests", "enduro2d")));
+        }
+
+        ~safe_starter_initializer() noexcept {
+            modules::shutdown<starter>();
+        }
+    };
+
+    vector<gobject> query_tree(const collider_tree& tree, const b2f& bounds) {
+        vector<gobject> result;
+        tree.query(bounds, [&result](const gobject& owner){
+            result.push_back(owner);
+        });
+        return result;
+    }
+
+    bool contains_owner(const vector<gobject>& owners, const gobject& owner) {
+        return std::find(owners.begin(), owners.end(), owner) != owners.end();
+    }
+}
+
+TEST_CASE("touch_system") {
+    safe_starter_initializer initializer;
+    world& w = the<world>();
+
+    SECTION("collider_tree") {
+        std::mt19937 engine(42u);
+        std::uniform_real_distribution<f32> position(-100.f, 100.f);
+        std::uniform_real_distribution<f32> size(0.f, 20.f);
+        std::uniform_int_distribution<u32> operation(0u, 2u);
+
+        const auto random_bounds = [&](){
+            return b2f(position(engine), position(engine), size(engine), size(engine));
+        };
+
+        struct proxy_info {
+            gobject owner;
+            u32 proxy{collider_tree::null_proxy};
+            b2f bounds;
+        };
+
+        vector<proxy_info> proxies(64u);
+        for ( proxy_info& p : proxies ) {
+            p.owner = w.instantiate();
+        }
+
+        collider_tree tree;
+        for ( std::size_t step = 0; step < 2000u; ++step ) {
+            proxy_info& p = proxies[engine() % proxies.size()];
+            if ( p.proxy == collider_tree::null_proxy ) {
+                p.bounds = random_bounds();
+                p.proxy = tree.create_proxy(p.bounds, p.owner);
+            } else if ( operation(engine) == 0u ) {
+                tree.destroy_proxy(p.proxy);
+                p.proxy = collider_tree::null_proxy;
+            } else {
+                p.bounds = b2f(p.bounds.position + v2f(position(engine), position(engine)) * 0.05f, p.bounds.size);
+                tree.move_proxy(p.proxy, p.bounds);
+            }
+
+            if ( step % 50u != 0u ) {
+                continue;
+            }
+
+            // fattened leaves may return extra candidates,
+            // but never miss a collider and never return a dead one
+            const b2f query_bounds = random_bounds();
+            const vector<gobject> found = query_tree(tree, query_bounds);
+            std::size_t alive = 0u;
+            for ( const proxy_info& pi : proxies ) {
+                if ( pi.proxy == collider_tree::null_proxy ) {
+                    REQUIRE_FALSE(contains_owner(found, pi.owner));
+                    continue;
+                }
+                ++alive;
+                if ( math::overlaps(pi.bounds, query_bounds) ) {
+                    REQUIRE(contains_owner(found, pi.owner));
+                }
+            }
+            REQUIRE(tree.proxy_count() == alive);
+            REQUIRE(query_tree(tree, b2f(-1000.f, -1000.f, 2000.f, 2000.f)).size() == alive);
+        }
+
+        // untouched proxies are swept
+        u32 stamp = 1u;
+        std::size_t touched = 0u;
+        for ( std::size_t i = 0; i < proxies.size(); i += 2u ) {
+            if ( proxies[i].proxy != collider_tree::null_proxy ) {
+                tree.touch_proxy(proxies[i].proxy, stamp);
+                ++touched;
+            }
+        }
+        tree.destroy_untouched_proxies(stamp);
+        REQUIRE(tree.proxy_count() == touched);
+    }
+    SECTION("readded_actor") {
+        gobject inst = w.instantiate();
+        inst.component<touchable>().ensure();
+        inst.component<rect_collider>().ensure().size(v2f(10.f, 10.f));
+        const node_iptr n = inst.component<actor>()->node();
+
+        collider_tree tree;
+        u32 stamp = 0u;
+        const auto update = [&w, &tree, &stamp](){
+            update_world_space_colliders(w.registry(), tree, ++stamp);
+        };
+
+        update();
+        REQUIRE(tree.proxy_count() == 1u);
+        REQUIRE(inst.component<world_space_rect_collider>());
+
+        // the sweep destroys the proxy, so the world space collider must go too
+        inst.component<actor>().remove();
+        update();
+        REQUIRE(tree.proxy_count() == 0u);
+        REQUIRE_FALSE(inst.component<world_space_rect_collider>());
+
+        // another proxy takes the freed node
+        gobject other = w.instantiate();
+        other.component<touchable>().ensure();
+        other.component<rect_collider>().ensure().size(v2f(10.f, 10.f));
+        other.component<actor>()->node()->translation(v2f(100.f, 100.f));
+        update();
+        REQUIRE(tree.proxy_count() == 1u);
+
+        inst.component<actor>().assign(n);
+        n->translation(v2f(5.f, 5.f));
+        update();
+        update();
+        REQUIRE(tree.proxy_count() == 2u);
+
+        const vector<gobject> found = query_tree(tree, b2f(7.f, 7.f, 1.f, 1.f));
+        REQUIRE(found.size() == 1u);
+        REQUIRE(found.front() == inst);
+        REQUIRE(query_tree(tree, b2f(100.f, 100.f, 1.f, 1.f)) == vector<gobject>{other});
+    }
+}
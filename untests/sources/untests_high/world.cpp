@@ -34,4 +34,70 @@ TEST_CASE("world") {
         w.registry().destroy_entity(e);
         REQUIRE_FALSE(cw.registry().valid_entity(e));
     }
+    SECTION("instantiate_batch") {
+        prefab child_prefab;
+        child_prefab.prototype().component<named>(named("child"));
+
+        prefab root_prefab;
+        root_prefab.prototype().component<named>(named("root"));
+        root_prefab.set_children({child_prefab, child_prefab});
+        root_prefab.children()[1].set_children({child_prefab});
+
+        const flat_prefab flat(root_prefab);
+        REQUIRE(flat.size() == 4u);
+        REQUIRE(flat.parent(0u) == flat_prefab::no_parent);
+        REQUIRE(flat.parent(1u) == 0u);
+        REQUIRE(flat.parent(2u) == 0u);
+        REQUIRE(flat.parent(3u) == 2u);
+
+        {
+            vector<gobject> insts = w.instantiate_batch(flat, vector<t2f>{
+                math::make_translation_trs2(v2f(1.f,2.f)),
+                math::make_translation_trs2(v2f(3.f,4.f))});
+            REQUIRE(insts.size() == 2u);
+
+            for ( const gobject& inst : insts ) {
+                REQUIRE(inst.component<named>()->name() == "root");
+                const_node_iptr n = inst.component<actor>()->node();
+                REQUIRE(n->owner() == inst);
+                REQUIRE(n->child_count() == 2u);
+                REQUIRE(n->child_count_recursive() == 3u);
+                REQUIRE(n->child_at(1u)->owner().component<named>()->name() == "child");
+            }
+
+            REQUIRE(insts[0].component<actor>()->node()->translation() == v2f(1.f,2.f));
+            REQUIRE(insts[1].component<actor>()->node()->translation() == v2f(3.f,4.f));
+        }
+        {
+            vector<gobject> insts = w.instantiate_batch(flat_prefab(), 3u);
+            REQUIRE(insts.size() == 3u);
+            for ( const gobject& inst : insts ) {
+                REQUIRE(inst.component<actor>());
+                REQUIRE_FALSE(inst.component<named>());
+            }
+        }
+    }
+    SECTION("instantiate_batch_async") {
+        prefab root_prefab;
+        root_prefab.set_children({prefab(), prefab()});
+
+        node_iptr parent = node::create();
+        w.async_instances_budget(make_microseconds<u64>(0u));
+        auto p = w.instantiate_batch_async(flat_prefab(root_prefab), 2u, parent);
+
+        // one entity per call with a zero budget
+        for ( std::size_t i = 0; i < 5u; ++i ) {
+            w.process_async_instances();
+            REQUIRE(p.wait_for(std::chrono::seconds(0)) == stdex::promise_wait_status::timeout);
+        }
+        REQUIRE(parent->child_count() == 1u);
+
+        w.process_async_instances();
+        REQUIRE(p.get().size() == 2u);
+        REQUIRE(parent->child_count() == 2u);
+
+        auto c = w.instantiate_batch_async(flat_prefab(root_prefab), 1u);
+        w.cancel_async_instances();
+        REQUIRE_THROWS_AS(c.get(), world_cancelled_exception);
+    }
 }
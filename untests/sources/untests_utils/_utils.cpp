@@ -59,6 +59,23 @@ TEST_CASE("utils") {
             42u, str1, str1 + std::strlen(str1)
         ) == utils::sdbm_hash(42u, str3));
     }
+    {
+        static_assert(
+            utils::xx_hash32(str_view()) == 0x02CC5D05u,
+            "static unit test error");
+        static_assert(
+            utils::xx_hash32(str_view("abc")) == 0x32D153FFu,
+            "static unit test error");
+
+        const char* str1 = "Nobody inspects the spammish repetition";
+        REQUIRE(utils::xx_hash32(str1, std::strlen(str1)) == 0xE2293B2Fu);
+        REQUIRE(utils::xx_hash32(str_view(str1)) == 0xE2293B2Fu);
+        REQUIRE(utils::xx_hash32(42u, str_view(str1)) == utils::xx_hash32(42u, str1, std::strlen(str1)));
+        REQUIRE(utils::xx_hash32(42u, str_view(str1)) != utils::xx_hash32(str_view(str1)));
+
+        REQUIRE(utils::xx_hash32(wstr_view(L"hello")) == utils::xx_hash32(str32_view(U"hello")));
+        REQUIRE(utils::xx_hash32(str_view("hello")) != utils::xx_hash32(str_view("hellO")));
+    }
     {
         utils::type_family_id id1 = utils::type_family<str16>::id();
         utils::type_family_id id2 = utils::type_family<str32>::id();
@@ -43,6 +43,197 @@ TEST_CASE("images") {
         }
     }
 
+    SECTION("mipmaps") {
+        {
+            REQUIRE(images::max_mipmap_count(v2u(1,1)) == 1u);
+            REQUIRE(images::max_mipmap_count(v2u(4,2)) == 3u);
+            REQUIRE(images::max_mipmap_count(v2u(57,31)) == 6u);
+            REQUIRE(images::mipmap_size(v2u(57,31), 1) == v2u(28,15));
+            REQUIRE(images::mipmap_size(v2u(57,31), 5) == v2u(1,1));
+            REQUIRE(images::data_size_for_mipmaps(image_data_format::rgba8, v2u(8,4), 4) == 172u);
+            REQUIRE(images::data_size_for_mipmaps(image_data_format::rgba_dxt1, v2u(8,4), 4) == 16u + 8u + 8u + 8u);
+        }
+        {
+            const u8 img_data[] = {
+                0, 4, 8, 12,
+                4, 8, 12, 16};
+            const image src(v2u(4,2), image_data_format::l8, {img_data, sizeof(img_data)});
+            REQUIRE(src.mipmap_count() == 1u);
+
+            image dst;
+            REQUIRE(images::try_generate_mipmaps(dst, src, image_mipmap_filter::box));
+            REQUIRE(dst.mipmap_count() == 3u);
+            REQUIRE(dst.data().size() == 8u + 2u + 1u);
+            REQUIRE(dst.mipmap_size(1) == v2u(2,1));
+            REQUIRE(dst.mipmap_data(0).size() == 8u);
+            REQUIRE(dst.mipmap_data(1).size() == 2u);
+
+            const u8* level1 = static_cast<const u8*>(dst.mipmap_data(1).data());
+            const u8* level2 = static_cast<const u8*>(dst.mipmap_data(2).data());
+            REQUIRE(level1[0] == 4u);
+            REQUIRE(level1[1] == 12u);
+            REQUIRE(level2[0] == 8u);
+
+            image kaiser;
+            REQUIRE(images::try_generate_mipmaps(kaiser, dst, image_mipmap_filter::kaiser));
+            REQUIRE(kaiser.mipmap_count() == 3u);
+            REQUIRE(kaiser.mipmap_data(0) == dst.mipmap_data(0));
+
+            // symmetric taps keep linear ramps
+            const u8* kaiser1 = static_cast<const u8*>(kaiser.mipmap_data(1).data());
+            const u8* kaiser2 = static_cast<const u8*>(kaiser.mipmap_data(2).data());
+            REQUIRE(kaiser1[0] == 4u);
+            REQUIRE(kaiser1[1] == 12u);
+            REQUIRE(kaiser2[0] == 8u);
+        }
+        {
+            const u8 img_data[] = {
+                0, 0, 0, 0, 255, 255, 255, 255};
+            const image src(v2u(8,1), image_data_format::l8, {img_data, sizeof(img_data)});
+
+            // unlike the box filter, the wide kernel blurs the edge into neighbouring texels
+            image dst;
+            REQUIRE(images::try_generate_mipmaps(dst, src, image_mipmap_filter::kaiser));
+            REQUIRE(dst.mipmap_count() == 4u);
+
+            const u8* level1 = static_cast<const u8*>(dst.mipmap_data(1).data());
+            const u8* level2 = static_cast<const u8*>(dst.mipmap_data(2).data());
+            REQUIRE(level1[0] == 0u);
+            REQUIRE(level1[1] == 19u);
+            REQUIRE(level1[2] == 236u);
+            REQUIRE(level1[3] == 255u);
+            REQUIRE(level2[0] == 25u);
+            REQUIRE(level2[1] == 230u);
+        }
+        {
+            const image dxt(v2u(4,4), image_data_format::rgba_dxt1, buffer(8u));
+            image dst;
+            REQUIRE_FALSE(images::try_generate_mipmaps(dst, dxt, image_mipmap_filter::box));
+        }
+        {
+            REQUIRE(filesystem::remove_file("image_save_test.dds"));
+            REQUIRE(filesystem::remove_file("image_save_test.pvr"));
+
+            buffer img_data(images::data_size_for_mipmaps(image_data_format::rgba8, v2u(8,4), 4));
+            for ( std::size_t i = 0; i < img_data.size(); ++i ) {
+                img_data[i] = static_cast<u8>(i);
+            }
+            const image img(v2u(8,4), image_data_format::rgba8, std::move(img_data), 4u);
+
+            image img2;
+            REQUIRE(images::try_save_image(
+                img,
+                image_file_format::dds, make_write_file("image_save_test.dds", false)));
+            REQUIRE(images::try_load_image(
+                img2,
+                make_read_file("image_save_test.dds")));
+            REQUIRE(img == img2);
+            REQUIRE(img2.mipmap_count() == 4u);
+
+            image img3;
+            REQUIRE(images::try_save_image(
+                img,
+                image_file_format::pvr, make_write_file("image_save_test.pvr", false)));
+            REQUIRE(images::try_load_image(
+                img3,
+                make_read_file("image_save_test.pvr")));
+            REQUIRE(img == img3);
+            REQUIRE(img3.mipmap_count() == 4u);
+        }
+    }
+
+    SECTION("compress") {
+        {
+            const image src(v2u(5,3), image_data_format::rgba8, buffer(5u * 3u * 4u));
+            REQUIRE(images::check_compress_support(src, image_data_format::rgba_dxt5));
+            REQUIRE(images::check_compress_support(src, image_data_format::rgb_etc2));
+            REQUIRE_FALSE(images::check_compress_support(src, image_data_format::rgba_astc4x4));
+            REQUIRE_FALSE(images::check_compress_support(src, image_data_format::rgba_pvrtc4));
+
+            image dst;
+            REQUIRE(images::try_compress(dst, src, image_data_format::rgba_dxt1));
+            REQUIRE(dst.format() == image_data_format::rgba_dxt1);
+            REQUIRE(dst.size() == v2u(5,3));
+            REQUIRE(dst.data().size() == 2u * 8u);
+
+            REQUIRE(images::try_compress(dst, src, image_data_format::rgba_etc2));
+            REQUIRE(dst.data().size() == 2u * 16u);
+
+            REQUIRE_FALSE(images::try_compress(dst, dst, image_data_format::rgba_dxt5));
+            REQUIRE_FALSE(images::try_compress(dst, src, image_data_format::rgba_astc4x4));
+        }
+        {
+            buffer red(4u * 4u * 4u);
+            for ( std::size_t i = 0; i < red.size(); i += 4u ) {
+                red[i + 0u] = 255u;
+                red[i + 3u] = 255u;
+            }
+            const image src(v2u(4,4), image_data_format::rgba8, std::move(red));
+
+            image dst;
+            REQUIRE(images::try_compress(dst, src, image_data_format::rgba_dxt1));
+            const u8 dxt1[] = {0x00, 0xF8, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00};
+            REQUIRE(dst.data() == buffer(dxt1, sizeof(dxt1)));
+
+            REQUIRE(images::try_compress(dst, src, image_data_format::rgba_dxt5));
+            const u8 dxt5[] = {
+                0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                0x00, 0xF8, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00};
+            REQUIRE(dst.data() == buffer(dxt5, sizeof(dxt5)));
+        }
+        {
+            // black and red rows with a transparent row between them,
+            // the endpoints lie on the edge of the color range
+            buffer mixed(4u * 4u * 4u);
+            for ( std::size_t i = 0; i < mixed.size(); i += 4u ) {
+                const std::size_t row = i / 16u;
+                mixed[i + 0u] = row == 1u ? 255u : 0u;
+                mixed[i + 3u] = row == 2u ? 0u : 255u;
+            }
+            const image src(v2u(4,4), image_data_format::rgba8, std::move(mixed));
+
+            image dst;
+            REQUIRE(images::try_compress(dst, src, image_data_format::rgba_dxt1));
+            const u8 dxt1[] = {0x00, 0x00, 0x00, 0xF8, 0x00, 0x55, 0xFF, 0x00};
+            REQUIRE(dst.data() == buffer(dxt1, sizeof(dxt1)));
+        }
+        {
+            buffer grey(4u * 4u * 3u);
+            std::fill(grey.begin(), grey.end(), u8(128u));
+            const image src(v2u(4,4), image_data_format::rgb8, std::move(grey));
+
+            // individual mode, both base colors are 0x88,
+            // the largest negative modifier of the first table
+            image dst;
+            REQUIRE(images::try_compress(dst, src, image_data_format::rgb_etc1));
+            const u8 etc1[] = {0x88, 0x88, 0x88, 0x00, 0xFF, 0xFF, 0xFF, 0xFF};
+            REQUIRE(dst.data() == buffer(etc1, sizeof(etc1)));
+        }
+        {
+            REQUIRE(filesystem::remove_file("image_save_test.dds"));
+
+            buffer img_data(images::data_size_for_mipmaps(image_data_format::rgba8, v2u(16,8), 5));
+            for ( std::size_t i = 0; i < img_data.size(); ++i ) {
+                img_data[i] = static_cast<u8>(i * 7u);
+            }
+            const image src(v2u(16,8), image_data_format::rgba8, std::move(img_data), 5u);
+
+            image dst;
+            REQUIRE(images::try_compress(dst, src, image_data_format::rgba_dxt5, image_compression_quality::best));
+            REQUIRE(dst.mipmap_count() == 5u);
+            REQUIRE(dst.data().size() == 128u + 32u + 16u + 16u + 16u);
+
+            image loaded;
+            REQUIRE(images::try_save_image(
+                dst,
+                image_file_format::dds, make_write_file("image_save_test.dds", false)));
+            REQUIRE(images::try_load_image(
+                loaded,
+                make_read_file("image_save_test.dds")));
+            REQUIRE(loaded == dst);
+        }
+    }
+
     SECTION("stb") {
         {
             REQUIRE(filesystem::remove_file("image_save_test.png"));
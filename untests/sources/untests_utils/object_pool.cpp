@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_utils.hpp"
+using namespace e2d;
+
+namespace
+{
+    class obj_t
+        : public ref_counter<obj_t>
+        , public pooled_object<obj_t> {
+    public:
+        obj_t() = default;
+        virtual ~obj_t() noexcept = default;
+        u64 value{42u};
+    };
+
+    class big_obj_t final : public obj_t {
+    public:
+        u8 data[128]{};
+    };
+}
+
+TEST_CASE("object_pool") {
+    SECTION("allocate") {
+        object_pool pool(24u, 8u, 4u);
+        REQUIRE(pool.block_size() == 24u);
+        REQUIRE(pool.stats().live_count == 0u);
+        REQUIRE(pool.stats().reserved_bytes == 0u);
+
+        void* b1 = pool.allocate();
+        void* b2 = pool.allocate();
+        REQUIRE(b1);
+        REQUIRE(b2);
+        REQUIRE(b1 != b2);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(b1) % alignof(std::max_align_t) == 0u);
+        REQUIRE(pool.stats().live_count == 2u);
+        REQUIRE(pool.stats().peak_count == 2u);
+
+        const std::size_t reserved = pool.stats().reserved_bytes;
+        REQUIRE(reserved >= 24u * 4u);
+
+        pool.deallocate(b2);
+        REQUIRE(pool.stats().live_count == 1u);
+        REQUIRE(pool.stats().peak_count == 2u);
+
+        void* b3 = pool.allocate();
+        REQUIRE(b3 == b2);
+
+        vector<void*> blocks;
+        for ( std::size_t i = 0; i < 6u; ++i ) {
+            blocks.push_back(pool.allocate());
+        }
+        REQUIRE(pool.stats().live_count == 8u);
+        REQUIRE(pool.stats().peak_count == 8u);
+        REQUIRE(pool.stats().reserved_bytes == reserved * 2u);
+
+        for ( void* b : blocks ) {
+            pool.deallocate(b);
+        }
+        pool.deallocate(b1);
+        pool.deallocate(b3);
+        pool.deallocate(nullptr);
+        REQUIRE(pool.stats().live_count == 0u);
+        REQUIRE(pool.stats().reserved_bytes == reserved * 2u);
+    }
+    SECTION("reserve") {
+        object_pool pool(24u, 8u, 4u);
+        pool.reserve(10u);
+        const std::size_t reserved = pool.stats().reserved_bytes;
+        REQUIRE(reserved >= 24u * 10u);
+
+        vector<void*> blocks;
+        for ( std::size_t i = 0; i < 10u; ++i ) {
+            blocks.push_back(pool.allocate());
+        }
+        REQUIRE(pool.stats().reserved_bytes == reserved);
+
+        pool.reserve(4u);
+        REQUIRE(pool.stats().reserved_bytes > reserved);
+        for ( void* b : blocks ) {
+            pool.deallocate(b);
+        }
+
+        const std::size_t reserved2 = pool.stats().reserved_bytes;
+        pool.reserve(14u);
+        REQUIRE(pool.stats().reserved_bytes == reserved2);
+    }
+    SECTION("pooled_object") {
+        const std::size_t live_count = obj_t::pool_statistics().live_count;
+        {
+            auto o1 = make_intrusive<obj_t>();
+            auto o2 = make_intrusive<big_obj_t>();
+            REQUIRE(o1->value == 42u);
+            REQUIRE(o2->value == 42u);
+            REQUIRE(obj_t::pool_statistics().live_count == live_count + 1u);
+        }
+        REQUIRE(obj_t::pool_statistics().live_count == live_count);
+        REQUIRE(obj_t::pool_statistics().reserved_bytes > 0u);
+    }
+}
@@ -0,0 +1,103 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_utils.hpp"
+using namespace e2d;
+
+namespace
+{
+    buffer make_repeated_buffer(std::size_t size) {
+        buffer b(size);
+        for ( std::size_t i = 0; i < size; ++i ) {
+            b.data()[i] = static_cast<u8>(i % 7u);
+        }
+        return b;
+    }
+}
+
+TEST_CASE("pack") {
+    DEFER_HPP([](){
+        filesystem::remove_file("pack_test");
+    });
+    SECTION("empty") {
+        pack_builder b;
+        REQUIRE(b.empty());
+        REQUIRE(b.try_save(make_write_file("pack_test", false)));
+
+        pack p;
+        REQUIRE(packs::try_load_pack(p, make_read_file("pack_test")));
+        REQUIRE(p.empty());
+        REQUIRE_FALSE(p.find_entry("file.txt"));
+    }
+    SECTION("entries") {
+        const buffer big = make_repeated_buffer(pack::chunk_size * 2u + 100u);
+
+        pack_builder b;
+        b.add_file("folder/big.bin", big)
+            .add_file("text.txt", buffer("hello", 5))
+            .add_file("folder/stored.bin", buffer("world", 5), pack::compression::none);
+        REQUIRE(b.file_count() == 3u);
+        REQUIRE(b.try_save(make_write_file("pack_test", false)));
+
+        pack p;
+        REQUIRE(packs::try_load_pack(p, make_read_file("pack_test")));
+        REQUIRE(p.entry_count() == 3u);
+        REQUIRE(p.entry_at(0u).path == "folder/big.bin");
+        REQUIRE(p.entry_at(1u).path == "folder/stored.bin");
+        REQUIRE(p.entry_at(2u).path == "text.txt");
+
+        const pack::entry* e0 = p.find_entry("folder/big.bin");
+        REQUIRE(e0);
+        REQUIRE(e0->method == pack::compression::deflate);
+        REQUIRE(e0->size == big.size());
+        REQUIRE(e0->stored_size < big.size());
+        REQUIRE(e0->chunk_count == 3u);
+        REQUIRE(e0->offset % pack::alignment == 0u);
+
+        // compression of tiny entries doesn't pay off, so they are stored
+        const pack::entry* e1 = p.find_entry("text.txt");
+        REQUIRE(e1);
+        REQUIRE(e1->method == pack::compression::none);
+        REQUIRE(e1->stored_size == 5u);
+        REQUIRE(e1->offset % pack::alignment == 0u);
+
+        REQUIRE_FALSE(p.find_entry("folder"));
+        REQUIRE_FALSE(p.find_entry("TEXT.txt"));
+
+        REQUIRE(p.find_prefix("folder/") == std::make_pair(std::size_t(0u), std::size_t(2u)));
+        REQUIRE(p.find_prefix("") == std::make_pair(std::size_t(0u), std::size_t(3u)));
+        REQUIRE(p.find_prefix("none/").first == p.find_prefix("none/").second);
+
+        buffer file_data;
+        REQUIRE(filesystem::try_read_all(file_data, "pack_test"));
+
+        pack p2;
+        REQUIRE(packs::try_load_pack(p2, file_data));
+        REQUIRE(p2.entry_count() == 3u);
+
+        buffer inflated(big.size());
+        for ( std::size_t i = 0; i < e0->chunk_count; ++i ) {
+            const pack::chunk& c = p.chunk_at(e0->first_chunk + i);
+            const std::size_t offset = i * pack::chunk_size;
+            REQUIRE(packs::try_inflate_chunk(
+                inflated.data() + offset,
+                math::min(pack::chunk_size, big.size() - offset),
+                buffer_view(file_data.data() + c.offset, c.stored_size)));
+        }
+        REQUIRE(inflated == big);
+    }
+    SECTION("errors") {
+        pack_builder b;
+        b.add_file("file.txt", buffer("hello", 5))
+            .add_file("file.txt", buffer("world", 5));
+        REQUIRE_FALSE(b.try_save(make_write_file("pack_test", false)));
+        REQUIRE_FALSE(b.try_save(output_stream_uptr()));
+
+        pack p;
+        REQUIRE_FALSE(packs::try_load_pack(p, buffer("e2d_mesh", 8)));
+        REQUIRE_FALSE(packs::try_load_pack(p, input_stream_uptr()));
+    }
+}
@@ -103,4 +103,28 @@ TEST_CASE("streams") {
             REQUIRE(s->length() == 5);
         }
     }
+    {
+        DEFER_HPP([](){
+            filesystem::remove_file("streams_buffered_file");
+        });
+        {
+            output_stream_uptr s = make_buffered_stream(
+                make_write_file("streams_buffered_file", false), 4u);
+            REQUIRE(s);
+            REQUIRE(s->write("he", 2) == 2);
+            REQUIRE(s->tell() == 2);
+            REQUIRE(s->write("llo world", 9) == 9);
+            REQUIRE(s->tell() == 11);
+            REQUIRE(s->write("!", 1) == 1);
+            REQUIRE(s->tell() == 12);
+            REQUIRE(s->seek(0, false) == 0);
+            REQUIRE(s->write("H", 1) == 1);
+            s->flush();
+            s->sync();
+        }
+        str content;
+        REQUIRE(filesystem::try_read_all(content, "streams_buffered_file"));
+        REQUIRE(content == "Hello world!");
+        REQUIRE_FALSE(make_buffered_stream(output_stream_uptr()));
+    }
 }
@@ -56,6 +56,22 @@ TEST_CASE("strings") {
             REQUIRE(s2 == str_hash("hello"));
             REQUIRE(s1 == make_hash("world"));
         }
+        {
+            constexpr str_hash s1 = "hello"_hash;
+            constexpr str_hash s2 = ""_hash;
+            static_assert(s1 == "hello"_hash, "static unit test error");
+            static_assert(s1 != "world"_hash, "static unit test error");
+            static_assert(s2.empty() && s2 == str_hash(), "static unit test error");
+
+            REQUIRE(s1 == str_hash("hello"));
+            REQUIRE(L"hello"_hash == wstr_hash(L"hello"));
+            REQUIRE(u"hello"_hash == str16_hash(u"hello"));
+            REQUIRE(U"hello"_hash == str32_hash(U"hello"));
+            REQUIRE("the quick brown fox jumps over the lazy dog"_hash
+                == make_hash("the quick brown fox jumps over the lazy dog"));
+            REQUIRE(str_hash::register_literal(s1, "hello"));
+            REQUIRE(str_hash::register_literal(s2, ""));
+        }
     }
     {
         REQUIRE(make_utf8("hello") == "hello");